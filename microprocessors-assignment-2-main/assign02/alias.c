@@ -0,0 +1,83 @@
+/*
+ * Import header files
+ */
+#include "alias.h"
+#include "rng.h"
+
+void alias_build(struct alias_table *table, const uint32_t *weights, unsigned count)
+{
+    uint64_t scaled[ALIAS_MAX_ITEMS];
+    uint8_t small[ALIAS_MAX_ITEMS];
+    uint8_t large[ALIAS_MAX_ITEMS];
+    unsigned small_count = 0;
+    unsigned large_count = 0;
+    uint64_t total = 0;
+
+    if (count > ALIAS_MAX_ITEMS)
+    {
+        count = ALIAS_MAX_ITEMS;
+    }
+    table->count = (uint8_t)count;
+    for (unsigned i = 0; i < count; i++)
+    {
+        total += weights[i];
+    }
+
+    // Scale so the average column holds exactly total
+    for (unsigned i = 0; i < count; i++)
+    {
+        scaled[i] = total != 0 ? (uint64_t)weights[i] * count : 1;
+        table->alias[i] = (uint8_t)i;
+    }
+    if (total == 0)
+    {
+        total = 1;
+    }
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (scaled[i] < total)
+        {
+            small[small_count++] = (uint8_t)i;
+        }
+        else
+        {
+            large[large_count++] = (uint8_t)i;
+        }
+    }
+
+    // Top up each short column from a long one, which may then become short itself
+    while (small_count > 0 && large_count > 0)
+    {
+        uint8_t less = small[--small_count];
+        uint8_t more = large[--large_count];
+
+        table->threshold[less] = (uint16_t)(scaled[less] * ALIAS_ONE / total);
+        table->alias[less] = more;
+        scaled[more] -= total - scaled[less];
+        if (scaled[more] < total)
+        {
+            small[small_count++] = more;
+        }
+        else
+        {
+            large[large_count++] = more;
+        }
+    }
+
+    // What is left is full, up to rounding
+    while (large_count > 0)
+    {
+        table->threshold[large[--large_count]] = ALIAS_ONE;
+    }
+    while (small_count > 0)
+    {
+        table->threshold[small[--small_count]] = ALIAS_ONE;
+    }
+}
+
+unsigned alias_draw(const struct alias_table *table)
+{
+    // rng_below() picks the column without a modulo bias, the low 15 bits of another draw pick the side
+    unsigned column = rng_below(table->count);
+    return (rng_next() & 0x7FFFu) < table->threshold[column] ? column : table->alias[column];
+}
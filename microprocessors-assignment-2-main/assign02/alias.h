@@ -0,0 +1,38 @@
+#ifndef ASSIGN02_ALIAS_H
+#define ASSIGN02_ALIAS_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+
+/*
+ * Walker's alias method, built with Vose's algorithm in integer arithmetic.
+ * Every column holds its own item with some probability and one alias
+ * item otherwise, so a weighted draw is one random column and one compare
+ * however uneven the weights are. Building takes time linear in the number
+ * of items, which is at most ALIAS_MAX_ITEMS, so changing a weight simply
+ * rebuilds the table.
+ */
+#define ALIAS_MAX_ITEMS 64
+#define ALIAS_ONE 0x8000u // Probability 1 in the Q15 column thresholds
+
+struct alias_table
+{
+    uint16_t threshold[ALIAS_MAX_ITEMS]; // Q15 chance a draw of the column keeps it
+    uint8_t alias[ALIAS_MAX_ITEMS];      // Item drawn otherwise
+    uint8_t count;                       // Items in the table
+};
+
+/*
+ * Builds the table for count items with the given weights. A zero weight
+ * is never drawn; if every weight is zero all items are equally likely.
+ */
+void alias_build(struct alias_table *table, const uint32_t *weights, unsigned count);
+
+/*
+ * Draws an item with the generator in rng.h
+ */
+unsigned alias_draw(const struct alias_table *table);
+
+#endif
@@ -8,7 +8,34 @@
 #include "hardware/gpio.h"
 #include "hardware/gpio.h"
 #include "hardware/watchdog.h"
+#include "hardware/timer.h"
+#include "hardware/irq.h"
+#include "hardware/structs/rosc.h"
 #include "assign02.pio.h"
+#include "morse.h"
+#include "morse_decoder.h"
+#include "word_verifier.h"
+#include "morse_match.h"
+#include "morse_beam.h"
+#include "morse_batch.h"
+#include "edge_ring.h"
+#include "button_timer.h"
+#include "keying.h"
+#include "timeout.h"
+#include "keyer.h"
+#include "keys.h"
+#include "session.h"
+#include "audio.h"
+#include "sched.h"
+#include "edge_bench.h"
+#include "edge_storm.h"
+#include "led.h"
+#include "challenge.h"
+#include "rng.h"
+#include "lookup.h"
+#include "word_dict.h"
+#include "dictionary.h"
+#include "console.h"
 
 /*
  * Define constants && Globals
@@ -16,190 +43,190 @@
 #define IS_RGBW true  // Will use RGBW format
 #define NUM_PIXELS 1  // There is 1 WS2812 device in the chain
 #define WS2812_PIN 28 // The GPIO pin that the WS2812 connected to
+#define BUTTON_PIN 21 // GPIO_BTN in assign02.S, the player's key
+#define PLAYER 0      // The button's channel, the other keys answer the same challenges alongside
+#define CLASS_KEY_PIN 2 // The other keys are on GP2 upwards, one pin per channel
+#define BUTTON_SM 1   // PIO0 state machine timing the button, the WS2812 has 0
+#define BUTTON_FILTER_US 5000 // Contact bounce shorter than this is ignored
+#define KEYER_DOT_PIN 20  // Paddle levers, active low like the button
+#define KEYER_DASH_PIN 22
+#define KEYER_LED_PIN 25  // GPIO_LED in assign02.S, lit while the keyer sends an element
+#define AUDIO_ADC_INPUT 0 // Tone input on GP26
+#define BENCH_PIN 16      // Driven by the edge_storm PIO program once bench has run, leave unconnected
+#define BENCH_SETTLE_US 20000 // Waited after a train for the last edges to be read
+#define LEVEL_3_MAX_UNITS 40 // Longest word for level 3, in dot units
+#define LEVEL_4_MAX_UNITS UINT32_MAX
+#define BEAM_CANDIDATES 3    // Readings of a wrong word answer to print
+#define NEAREST_CANDIDATES 3 // Nearest characters or words to a wrong answer to print
+#define START_WPM 12         // Speed assumed before the first answer, dashes from 200 ms
+
+struct session sessions[KEYS_MAX];               // Every key's answer, speed and score, by channel
+struct session *const player = &sessions[PLAYER]; // The button (or the paddle keyer), who plays the levels
+struct morse_match answer_match;                 // Alignment of the last wrong answer with its target
+uint16_t reported_letters;                       // Word progress already printed
+struct dictionary dictionary;                    // Words for levels 3 and 4, read from flash
+struct edge_ring button_edges;                   // Key edges queued by gpio_isr (assign02.S), read by the main loop
+volatile uint32_t gpio_isr_cycles_max;           // Longest gpio_isr in SysTick cycles, kept by gpio_isr itself
+bool audio_input;                                // The player keys with a tone on the ADC, not the button
+unsigned audio_hz;                               // Tone audio_input listens for
+uint32_t reported_dropped;                       // Lost edges already printed
+struct keyer keyer;                              // Paddle keyer, when the keyer command has turned it on
+uint32_t led_colour;                             // Colour the SCHED_LED handler shows next
+struct edge_bench bench;                         // Input benchmark, run from the console
+bool bench_ready;                                // edge_storm has been set up
 
-char *set_input_array;
-char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
-char *alpha_morse[] = {".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---",
-                       "-.-", ".-..", "--", "-.", "---", ".--.", "--.-", ".-.", "...", "-", "..-",
-                       "...-", ".--", "-..-", "-.--", "--.."};
-char *num_morse[] = {"-----", ".----", "..---", "...--", "....-", ".....", "-....", "--...", "---..", "----."};
-char *words[] = {"cave",
-                 "copy",
-                 "dock",
-                 "lick",
-                 "run",
-                 "owl",
-                 "free",
-                 "sink",
-                 "scold",
-                 "hold",
-                 "smoke",
-                 "part",
-                 "vex",
-                 "able",
-                 "bang",
-                 "nose",
-                 "tan",
-                 "van",
-                 "sob",
-                 "blue",
-                 "nap"};
-char *words_morse[] = {
-    "-.-. .- ...- .",
-    "-.-. --- .--. -.--",
-    "-.. --- -.-. -.-",
-    ".-.. .. -.-. -.-",
-    ".-. ..- -.",
-    "--- .-- .-..",
-    "..-. .-. . .",
-    "... .. -. -.-",
-    "... -.-. --- .-.. -..",
-    ".... --- .-.. -..",
-    "... -- --- -.- .",
-    ".--. .- .-. -",
-    "...- . -..- ",
-    ".- -... .-.. .",
-    "-... .- -. --.",
-    "-. --- ... .",
-    "- .- -.",
-    "...- .- -.",
-    "... --- -...",
-    "-... .-.. ..- .",
-    "-. .- .--."};
+int level_number;
+int lives;
+char level_selection[5];
+bool game_status = false;
 
-struct words_hash_table
-{ // Hash table to store words and their associated morse code
-    char *word;
-    char *morse;
-};
+// Declare the main assembly code entry point.
+void main_asm();
 
-struct words_hash_table *hashArray[20];
-struct words_hash_table *item;
+/*
+ * Responsible for displaying the welcome message
+ * Contains the rules and options to choose level
+ */
+void welcome_message(); // complete
 
-unsigned long hashstring(char word[]) // djb2 hashing algorithm
-{
-    unsigned long hash = 5381;
-    int c;
+/*
+ * Sets the LED color to indicate the status of the game
+ * Blue - Game not in progress
+ * Green - Game in Progress; Lives = 3
+ * Yellow - Lives = 2
+ * Orange - Lives = 1
+ * Red - Game Over
+ */
+void set_rgb(); // complete
 
-    while (c = *word++)
-        hash = ((hash << 5) + hash) + c; /* hash * 33 + c */
+/*
+ * Loads the level corresponding to the level chosen by the user
+ */
+void load_level(); // complete
 
-    return hash;
-}
+/*
+ * Starts a new answer, graded against the packed morse code of the given character or word
+ */
+void start_answer(morse_word_t expected);
 
-struct words_hash_table *search(char *word)
-{
-    // get the hash
-    int hashIndex = hashstring(word);
+/*
+ * Starts a new answer, graded letter by letter against the given word
+ */
+void start_word_answer(const char *expected);
 
-    // move in array until an empty
-    while (hashArray[hashIndex] != NULL)
-    {
+/*
+ * Asked by the scheduler after each round of events, returns true once the answer can be graded
+ */
+bool answer_ready();
 
-        if (hashArray[hashIndex]->word == word)
-            return hashArray[hashIndex];
+/*
+ * SCHED_INPUT handler: reads the key edges, the keyer and the audio, and prints word progress
+ */
+void read_input();
 
-        // go to next cell
-        ++hashIndex;
+/*
+ * SCHED_LED handler: hands led_colour to the LED's DMA, and asks to be run again if it has to wait
+ */
+void show_led();
 
-        // wrap around the table
-        hashIndex %= 20;
-    }
+/*
+ * Flags SCHED_CONSOLE, called by stdio when characters arrive
+ */
+void console_ready(void *param);
 
-    return NULL;
-}
+/*
+ * SCHED_CONSOLE handler: runs the console commands, and the benchmark if one asked for it
+ */
+void read_console();
 
-void insert(char *word, char *morse)
-{
-    struct words_hash_table *item = (struct words_hash_table *)malloc(sizeof(struct words_hash_table));
-    item->word = word;
-    item->morse = morse;
+/*
+ * Points gpio_isr at the keys' pins, or only at BENCH_PIN while bench is set
+ */
+void map_keys(bool bench);
 
-    int hashIndex = hashstring(word);
+/*
+ * Times LED updates blocking and through the DMA, and prints both
+ */
+void run_led_bench();
 
-    // move in array until an empty cell
-    while (hashArray[hashIndex] != NULL)
-    {
-        // go to next cell
-        ++hashIndex;
+/*
+ * Sends edge trains at every rate in edge_bench_rates through gpio_isr and the
+ * classification, and prints how each went and the highest rate kept up with
+ */
+void run_edge_bench();
 
-        // wrap around the table
-        hashIndex %= 20;
-    }
-}
+/*
+ * Forgets the edges queued for the previous answer and starts every key's answer
+ */
+void start_sessions(morse_word_t target, const char *word);
 
-void initialise_hash_table()
-{
-    for (int i = 0; i < 19; i++)
-    {
-        insert(words[i], words_morse[i]);
-    }
-}
+/*
+ * Hands the queued key edges to the keys' sessions, which turn them into dots, dashes and letter gaps
+ */
+void read_edges();
 
-absolute_time_t start_time;
-int level_number;
-int lives;
-char level_selection[5];
-bool game_status = false;
+/*
+ * Runs the paddle keyer up to now and keys the elements it has finished
+ */
+void run_keyer();
 
-// Declare the main assembly code entry point.
-void main_asm();
+/*
+ * SCHED_TIMEOUT handler: acts on the timeouts that have come due and asks to be run again at the earliest one left
+ */
+void run_timeouts();
 
 /*
- * Responsible for displaying the welcome message
- * Contains the rules and options to choose level
+ * Checks the answer keyed since start_answer() against the expected morse code, and scores the other keys
+ * Returns 1 if the player's answer correctly matched, 0 otherwise
  */
-void welcome_message(); // complete
+int check_pattern(); // complete
 
-/**
- * @brief Wrapper function used to call the underlying PIO
- *        function that pushes the 32-bit RGB colour value
- *        out to the LED serially using the PIO0 block. The
- *        function does not return until all of the data has
- *        been written out.
- *
- * @param pixel_grb The 32-bit colour value generated by urgb_u32()
+/*
+ * Checks one key's answer, printing where it went wrong if report is set
+ * Returns 1 if correctly matched, 0 otherwise
  */
-static inline void put_pixel(uint32_t pixel_grb);
+int check_answer(struct session *session, bool report);
 
-/**
- * @brief Function to generate an unsigned 32-bit composit GRB
- *        value by combining the individual 8-bit paramaters for
- *        red, green and blue together in the right order.
- *
- * @param r     The 8-bit intensity value for the red component
- * @param g     The 8-bit intensity value for the green component
- * @param b     The 8-bit intensity value for the blue component
- * @return uint32_t Returns the resulting composit 32-bit RGB value
+/*
+ * Decodes a wrong word answer again with every letter gap treated as
+ * uncertain, prints the most likely dictionary words if report is set, and
+ * returns 1 if the most likely one is target
  */
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b);
+int read_word_answer(struct session *session, const char *target, bool report);
 
 /*
- * Sets the LED color to indicate the status of the game
- * Blue - Game not in progress
- * Green - Game in Progress; Lives = 3
- * Yellow - Lives = 2
- * Orange - Lives = 1
- * Red - Game Over
+ * Scores the answers of the other keys that took part and prints how each did
  */
-void set_rgb(); // complete
+void score_keys();
 
 /*
- * Loads the level corresponding to the level chosen by the user
+ * Prints each of the other keys' score for the level
  */
-void load_level(); // complete
+void print_key_scores();
 
 /*
- * Checks the input morse code against the actual morse code of teh given character
- * Returns 1 if correctly matched, 0 otherwise
+ * Prints where the keyed answer differs from the expected one
+ */
+void print_match(const struct morse_match *match);
+
+/*
+ * Prints the characters (or dictionary words) nearest to what was keyed
  */
-int check_pattern(int level_number, char *given_char, char *morse_code_input); // complete
+void print_nearest(morse_word_t keyed, unsigned letters, bool word);
 
 /**
- * Function to generate random character for use in levels 1 and 2
+ * Function to generate random character for use in levels 1 and 2,
+ * weighted towards the characters the player has been getting wrong
  */
 char generate_random_character(); // complete
 
+/**
+ * Function to pick a random word for use in levels 3 and 4: a missed word to
+ * review, or one of the built-in dictionary words up to max_units long and
+ * those uploaded over the console
+ */
+void generate_random_word(unsigned max_units, char word[DICTIONARY_WORD_MAX + 1], morse_word_t *morse);
+
 /*
  * Displays the message banner when player wins the game
  */
@@ -235,22 +262,69 @@ void level_4(); // nearly complete
  */
 void print_level_stats(int num_wins, int num_losses); // complete
 
+/*
+ * Collects a seed from the ring oscillator's random bit
+ */
+uint32_t entropy_seed();
+
 /*
  * Main entry point for the code
  */
 int main()
 {
     stdio_init_all();
-    // initialise_hash_table();
+    edge_ring_init(&button_edges);
+    sched_init();
+    sched_handle(SCHED_INPUT, read_input);
+    sched_handle(SCHED_TIMEOUT, run_timeouts);
+    sched_handle(SCHED_LED, show_led);
+    sched_handle(SCHED_CONSOLE, read_console);
+    // Anything typed before the callback was set is read on the first round
+    stdio_set_chars_available_callback(console_ready, NULL);
+    sched_post(SCHED_CONSOLE);
+    for (int channel = 0; channel < KEYS_MAX; channel++)
+    {
+        session_init(&sessions[channel], START_WPM);
+    }
+    lookup_init();
+    challenge_seed(entropy_seed());
+    printf("Random seed %08lx, type \"seed %08lx\" to replay this session\n",
+           (unsigned long)rng_get_seed(), (unsigned long)rng_get_seed());
+    if (!dictionary_open(&dictionary, dictionary_blob, dictionary_blob_size))
+    {
+        printf("Word dictionary is damaged, only uploaded words will be used\n");
+    }
     watchdog_enable(9000, 1);
 
     PIO pio = pio0;
     uint offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, 0, offset, WS2812_PIN, 800000, IS_RGBW);
+    ws2812_program_init(pio, 0, offset, WS2812_PIN, LED_BIT_HZ, IS_RGBW);
+    led_init(pio, 0, IS_RGBW);
+#if ASSIGN02_BUTTON_PIO
+    button_timer_init(pio, BUTTON_SM, BUTTON_PIN, BUTTON_FILTER_US);
+    player->widths_timed = true;
+#endif
+    // main_asm sets the button up, the other keys are pulled up so an unwired one stays released
+    map_keys(false);
+    audio_init(AUDIO_ADC_INPUT);
+    for (uint channel = 1; channel < KEYS_MAX; channel++)
+    {
+        uint pin = CLASS_KEY_PIN + channel - 1;
+        gpio_init(pin);
+        gpio_pull_up(pin);
+        gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    }
+    // Both levers interrupt on every change so the keyer runs as soon as one moves
+    static const uint paddle_pins[] = {KEYER_DOT_PIN, KEYER_DASH_PIN};
+    for (int i = 0; i < 2; i++)
+    {
+        gpio_init(paddle_pins[i]);
+        gpio_pull_up(paddle_pins[i]);
+        gpio_set_irq_enabled(paddle_pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+    }
 
     welcome_message();
 
-    main_asm();
     load_level();
     return (0);
 }
@@ -279,42 +353,369 @@ void asm_gpio_put(uint pin, bool value)
     gpio_put(pin, value);
 }
 
-// Enable falling-edge interrupt – see SDK for detail on gpio_set_irq_enabled()
+// Enable falling- and rising-edge interrupts – see SDK for detail on gpio_set_irq_enabled()
 void asm_gpio_set_irq(uint pin)
 {
-    gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL, true);
+    gpio_set_irq_enabled(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+}
+
+uint32_t entropy_seed()
+{
+    uint32_t seed = 0;
+
+    // Consecutive reads of the bit are correlated, so wait a little between them
+    for (int i = 0; i < 32; i++)
+    {
+        seed = (seed << 1) | (rosc_hw->randombit & 1u);
+        busy_wait_us_32(1);
+    }
+    return seed ^ time_us_32();
+}
+
+void start_sessions(morse_word_t target, const char *word)
+{
+    uint64_t now = time_us_64();
+
+    edge_ring_discard(&button_edges);
+#if ASSIGN02_BUTTON_PIO
+    button_timer_discard();
+#endif
+    // Only the player's answer times out unkeyed, the others wait for their key to be used
+    for (int channel = 0; channel < KEYS_MAX; channel++)
+    {
+        session_start(&sessions[channel], target, word, now, channel == PLAYER);
+    }
+    keyer_init(&keyer, console_keyer_mode(), console_keyer_wpm());
+    gpio_put(KEYER_LED_PIN, false);
+
+    // The tone detector keeps running between answers, so it keeps the levels it has learnt
+    audio_input = console_audio_hz() != 0;
+    if (audio_input && (!audio_running() || console_audio_hz() != audio_hz))
+    {
+        audio_start(console_audio_hz());
+    }
+    else if (!audio_input)
+    {
+        audio_stop();
+    }
+    audio_hz = console_audio_hz();
+    audio_discard();
+#if ASSIGN02_BUTTON_PIO
+    // Tone edges are timed from the sample count, only the button's own widths come from the PIO
+    player->widths_timed = !audio_input;
+#endif
+    // The new deadlines and the audio blocks are picked up on the scheduler's next round
+    sched_post(SCHED_INPUT);
+    sched_post(SCHED_TIMEOUT);
 }
 
-void start_timer()
+void read_edges()
 {
-    start_time = get_absolute_time();
+    struct edge_event edge;
+    uint32_t dropped;
+
+#if ASSIGN02_BUTTON_PIO
+    struct button_width width;
+
+    // The PIO has timed and debounced the button, its edges from gpio_isr only drive the player's timeouts
+    while (button_timer_read(&width))
+    {
+        if (!audio_input)
+        {
+            session_width(player, width.pressed, width.us);
+        }
+    }
+#endif
+
+    // The same work for every edge, whichever key it came from
+    while (edge_ring_pop(&button_edges, &edge))
+    {
+        if (edge.channel != PLAYER || !audio_input)
+        {
+            session_edge(&sessions[edge.channel], &edge);
+        }
+    }
+    while (audio_read(&edge))
+    {
+        session_edge(player, &edge);
+    }
+
+#if ASSIGN02_BUTTON_PIO
+    dropped = button_timer_dropped() + edge_ring_dropped(&button_edges);
+#else
+    dropped = edge_ring_dropped(&button_edges);
+#endif
+    if (dropped != reported_dropped)
+    {
+        reported_dropped = dropped;
+        printf("Keying too fast: %lu key edges lost so far\n", (unsigned long)reported_dropped);
+    }
 }
 
-int end_timer()
+void run_keyer()
 {
-    int end_time = (int)absolute_time_diff_us(start_time, get_absolute_time());
-    return end_time / 100000;
+    struct keyer_element done[KEYER_ELEMENTS_MAX];
+    uint64_t deadline;
+    int count;
+
+    if (keyer.mode == KEYER_OFF)
+    {
+        return;
+    }
+    count = keyer_update(&keyer, time_us_64(), !gpio_get(KEYER_DOT_PIN), !gpio_get(KEYER_DASH_PIN), done,
+                         KEYER_ELEMENTS_MAX);
+    for (int i = 0; i < count; i++)
+    {
+        // The keyer sets the length of each element, so there is nothing to classify or learn
+        session_input(player, done[i].dash ? 1 : 0);
+        player->element_keyed = true;
+        player->letter_closed = false;
+        timeout_cancel(&player->timeouts, TIMEOUT_END);
+        timeout_arm(&player->timeouts, TIMEOUT_LETTER, done[i].end_us + SESSION_LETTER_TIMEOUT_UNITS * keyer.unit_us);
+        timeout_arm(&player->timeouts, TIMEOUT_WORD, done[i].end_us + SESSION_WORD_TIMEOUT_UNITS * keyer.unit_us);
+    }
+    if (keyer_key_down(&keyer))
+    {
+        timeout_cancel(&player->timeouts, TIMEOUT_LETTER);
+        timeout_cancel(&player->timeouts, TIMEOUT_WORD);
+        timeout_arm(&player->timeouts, TIMEOUT_END, keyer.start_us + SESSION_IDLE_TIMEOUT_US);
+    }
+    gpio_put(KEYER_LED_PIN, keyer_key_down(&keyer));
+
+    // The next element edge wakes the loop through ALARM0 like any other timeout
+    if (keyer_next(&keyer, &deadline))
+    {
+        timeout_arm(&player->timeouts, TIMEOUT_KEYER, deadline);
+    }
+    else
+    {
+        timeout_cancel(&player->timeouts, TIMEOUT_KEYER);
+    }
 }
 
-void set_input(int case_received)
+void run_timeouts()
 {
-    switch (case_received)
+    uint64_t deadline;
+    uint64_t next;
+    uint64_t now = time_us_64();
+    bool armed = false;
+
+    if (session_expire(player, now) & TIMEOUT_BIT(TIMEOUT_KEYER))
     {
-    case 0:
-        strcat(set_input_array, ".");
-        break;
-    case 1:
-        strcat(set_input_array, "-");
+        // Finishes the element first, its gap timeouts may already be due
+        run_keyer();
+        session_expire(player, time_us_64());
+    }
+    for (int channel = 0; channel < KEYS_MAX; channel++)
+    {
+        if (channel != PLAYER)
+        {
+            session_expire(&sessions[channel], now);
+        }
+        if (session_next(&sessions[channel], &next) && (!armed || next < deadline))
+        {
+            deadline = next;
+            armed = true;
+        }
+    }
+
+    // A deadline that passed meanwhile is run on the scheduler's next round
+    if (armed)
+    {
+        sched_post_at(SCHED_TIMEOUT, deadline);
+    }
+    else
+    {
+        sched_cancel(SCHED_TIMEOUT);
+    }
+}
+
+void start_answer(morse_word_t expected)
+{
+    start_sessions(expected, NULL);
+}
+
+void start_word_answer(const char *expected)
+{
+    start_sessions(MORSE_WORD_EMPTY, expected);
+    reported_letters = 0;
+}
+
+void read_input()
+{
+    uint64_t next;
+
+    read_edges();
+    run_keyer();
+    // Audio blocks finish without an interrupt, so ask to be woken for the next one
+    if (audio_next(&next))
+    {
+        sched_post_at(SCHED_INPUT, next);
+    }
+    else
+    {
+        sched_cancel(SCHED_INPUT);
+    }
+    // The edges have moved the sessions' deadlines
+    sched_post(SCHED_TIMEOUT);
+
+    if (player->verifier.target != NULL && player->verifier.correct != reported_letters)
+    {
+        reported_letters = player->verifier.correct;
+        printf("%u/%u letters correct\n", reported_letters, player->verifier.letters);
+    }
+}
+
+void show_led()
+{
+    uint64_t next;
+
+    // An unchanged colour is not sent again
+    led_show(led_colour);
+    if (led_next(&next))
+    {
+        sched_post_at(SCHED_LED, next);
+    }
+}
+
+void console_ready(void *param)
+{
+    sched_post(SCHED_CONSOLE);
+}
+
+void read_console()
+{
+    console_poll();
+    switch (console_take_bench())
+    {
+    case CONSOLE_BENCH_EDGES:
+        run_edge_bench();
         break;
-    case 2:
-        strcat(set_input_array, " ");
+    case CONSOLE_BENCH_LED:
+        run_led_bench();
         break;
-    case 3:
-        strcat(set_input_array, "\0");
+    default:
         break;
     }
 }
 
+void run_led_bench()
+{
+    struct led_bench_result result;
+    struct led_stats stats;
+
+    led_bench(&result);
+    // Puts the game's colour back once the LED can take it
+    sched_post(SCHED_LED);
+    led_get_stats(&stats);
+    printf("%d LED updates: %lu cycles blocking, %lu through the DMA (%lu sent), %lu when the colour is unchanged\n",
+           LED_BENCH_UPDATES, (unsigned long)result.blocking_cycles, (unsigned long)result.dma_cycles,
+           (unsigned long)result.dma_sent, (unsigned long)result.unchanged_cycles);
+    printf("LED so far: %lu colours sent, %lu unchanged ones skipped, %lu overtaken\n", (unsigned long)stats.sent,
+           (unsigned long)stats.skipped, (unsigned long)stats.replaced);
+}
+
+void map_keys(bool bench)
+{
+    // gpio_isr reads the tables, so it must not run while they change (nor before main_asm installs it)
+    bool enabled = irq_is_enabled(IO_IRQ_BANK0);
+
+    irq_set_enabled(IO_IRQ_BANK0, false);
+    keys_clear();
+    if (bench)
+    {
+        keys_add(PLAYER, BENCH_PIN);
+    }
+    else
+    {
+        keys_add(PLAYER, BUTTON_PIN);
+        for (uint channel = 1; channel < KEYS_MAX; channel++)
+        {
+            keys_add(channel, CLASS_KEY_PIN + channel - 1);
+        }
+    }
+    irq_set_enabled(IO_IRQ_BANK0, enabled);
+}
+
+void run_edge_bench()
+{
+    struct edge_bench_result result;
+    struct edge_event edge;
+    uint32_t sustained = 0;
+    uint32_t dropped = edge_ring_dropped(&button_edges);
+    uint32_t train_dropped;
+    uint32_t rate_kept = 0;
+    uint32_t rate;
+    uint64_t end;
+
+    if (!bench_ready)
+    {
+        edge_storm_init(pio1, BENCH_PIN);
+        gpio_set_irq_enabled(BENCH_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+        bench_ready = true;
+    }
+    printf("Sending %d edges at each rate on GP%d, the keys are ignored meanwhile\n", EDGE_BENCH_EDGES, BENCH_PIN);
+    map_keys(true);
+    edge_ring_discard(&button_edges);
+    gpio_isr_cycles_max = 0;
+
+    for (int i = 0; i < EDGE_BENCH_RATES; i++)
+    {
+        train_dropped = edge_ring_dropped(&button_edges);
+        edge_bench_start(&bench, PLAYER, time_us_64());
+        rate = edge_storm_send(edge_bench_rates[i], EDGE_BENCH_EDGES);
+        // Read as the game would, every edge as soon as it is queued
+        end = time_us_64() + (uint64_t)EDGE_BENCH_EDGES * 1000000u / rate + BENCH_SETTLE_US;
+        while (time_us_64() < end)
+        {
+            while (edge_ring_pop(&button_edges, &edge))
+            {
+                edge_bench_edge(&bench, &edge, time_us_64());
+            }
+        }
+        edge_bench_finish(&bench, rate, EDGE_BENCH_EDGES, edge_ring_dropped(&button_edges) - train_dropped, &result);
+        edge_bench_print(&result, i == 0);
+        // Only up to the first rate that lost edges
+        if (edge_bench_sustained(&result) && sustained == (uint32_t)i)
+        {
+            sustained++;
+            rate_kept = result.rate;
+        }
+    }
+
+    if (sustained == 0)
+    {
+        printf("Edges were lost at every rate\n");
+    }
+    else
+    {
+        printf("Kept up with %lu edges a second\n", (unsigned long)rate_kept);
+    }
+    // From its first instruction to its return, without the exception entry and return around it
+    printf("gpio_isr took at most %lu cycles\n", (unsigned long)gpio_isr_cycles_max);
+    // The game only reports edges it loses itself
+    reported_dropped += edge_ring_dropped(&button_edges) - dropped;
+    map_keys(false);
+    edge_ring_discard(&button_edges);
+}
+
+bool answer_ready()
+{
+    if (!session_done(player, console_tolerance()))
+    {
+        return false;
+    }
+    // The other keys get to finish an answer they have started
+    for (int channel = 0; channel < KEYS_MAX; channel++)
+    {
+        if (session_busy(&sessions[channel], console_tolerance()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 void welcome_message()
 {
     printf("----------------------------------------------------------------------------------------------\n----------------------------------------------------------------------------------------------\n");
@@ -360,49 +761,39 @@ void game_over_failure()
     printf("----------------------------------------------------------------------------------------------\n----------------------------------------------------------------------------------------------\n");
 }
 
-static inline void put_pixel(uint32_t pixel_grb)
-{
-    pio_sm_put_blocking(pio0, 0, pixel_grb << 8u);
-}
-
-static inline uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b)
-{
-    return ((uint32_t)(r) << 8) |
-           ((uint32_t)(g) << 16) |
-           (uint32_t)(b);
-}
-
 void set_rgb()
 {
 
     if (game_status == false)
     {
         // Set LED to BLUE once the game opens but hasnt started
-        put_pixel(urgb_u32(0x00, 0x00, 0xFF));
+        led_colour = lookup_led_colour(LED_BLUE);
     }
     else
     {
         switch (lives)
         {
         case 3:
-            put_pixel(urgb_u32(0x80, 0xFF, 0x00));
+            led_colour = lookup_led_colour(LED_GREEN);
             break;
 
         case 2:
-            put_pixel(urgb_u32(0xFF, 0xFF, 0x00));
+            led_colour = lookup_led_colour(LED_YELLOW);
             break;
 
         case 1:
-            put_pixel(urgb_u32(0xFF, 0x80, 0x00));
+            led_colour = lookup_led_colour(LED_ORANGE);
             break;
 
         case 0:
-            put_pixel(urgb_u32(0xFF, 0x00, 0x00));
+            led_colour = lookup_led_colour(LED_RED);
             break;
         }
 
         printf("You have %d lives left\n", lives);
     }
+    // Shown on the scheduler's next round, the game is always waiting on one soon after
+    sched_post(SCHED_LED);
 }
 
 void load_level()
@@ -418,48 +809,50 @@ void load_level()
     printf("Level 4 ( ....- ) :\tIndividual words without their equivalent Morse code provided.\n");
     // scanf("%d", level_number);
 
-    
     while (1)
     {
-        // set_input_array used in the following code is the global array which stores the user input
-        // - name may need to be changed to correspond to the actual variable (as of right now it has not been defined)
-        if (strcmp(set_input_array, ".----") == 0)
-        {
-            printf("Level 1 selected!\n");
-            level_number = 1;
-            memset(set_input_array, 0, sizeof(set_input_array));
-            break;
-        }
-        else if (strcmp(set_input_array, "..---") == 0)
-        {
-            printf("Level 2 selected!\n");
-            level_number = 2;
-            memset(set_input_array, 0, sizeof(set_input_array));
-            break;
-        }
-        else if (strcmp(set_input_array, "...--") == 0)
+        // Sleeps until the selection has been keyed, an answer the idle timeout ended unkeyed is started again
+        main_asm();
+        if (player->element_keyed)
         {
-            printf("Level 3 selected!\n");
-            level_number = 3;
-            memset(set_input_array, 0, sizeof(set_input_array));
-            break;
-        }
-        else if (strcmp(set_input_array, "....-") == 0)
-        {
-            printf("Level 4 selected!\n");
-            level_number = 4;
-            memset(set_input_array, 0, sizeof(set_input_array));
+            morse_word_t selection = player->input.word;
+            start_answer(MORSE_WORD_EMPTY);
+
+            if (selection == MORSE_1)
+            {
+                printf("Level 1 selected!\n");
+                level_number = 1;
+                break;
+            }
+            else if (selection == MORSE_2)
+            {
+                printf("Level 2 selected!\n");
+                level_number = 2;
+                break;
+            }
+            else if (selection == MORSE_3)
+            {
+                printf("Level 3 selected!\n");
+                level_number = 3;
+                break;
+            }
+            else if (selection == MORSE_4)
+            {
+                printf("Level 4 selected!\n");
+                level_number = 4;
+                break;
+            }
+            else
+            {
+                printf("Invalid input, try again!\n");
+            }
         }
         else
         {
-            printf("Invalid input, try again!\n");
-            memset(set_input_array, 0, sizeof(set_input_array));
+            start_answer(MORSE_WORD_EMPTY);
         }
-        sleep_ms(2000);
     }
 
-    memset(set_input_array, 0, sizeof(set_input_array));
-
     switch (level_number)
     {
     case 1:
@@ -482,117 +875,239 @@ void load_level()
 
 char generate_random_character()
 {
-    int random_index = random() % 36;
-    char random_letter = alphabet[random_index];
-    return random_letter;
+    return challenge_next_char();
 }
 
-int check_pattern(int level_number, char *given_char, char *morse_code_input)
+void generate_random_word(unsigned max_units, char word[DICTIONARY_WORD_MAX + 1], morse_word_t *morse)
 {
-    switch (level_number)
+    size_t first = 0;
+    size_t count = dictionary.header != NULL ? dictionary_duration_range(&dictionary, 0, max_units, &first) : 0;
+
+    // Missed words come back for review now and then
+    if (challenge_next_word(word))
     {
-    case 1:
-        for (int i = 0; i < sizeof(alpha_morse); i++)
+        *morse = morse_encode_word(word);
+        return;
+    }
+    if (count + word_dict_count() == 0)
+    {
+        strcpy(word, "sos");
+        *morse = morse_encode_word(word);
+        return;
+    }
+
+    size_t random_index = challenge_fresh_index(count + word_dict_count());
+    if (random_index < count)
+    {
+        size_t index = dictionary_duration_word(&dictionary, first + random_index);
+        dictionary_word(&dictionary, index, word);
+        *morse = dictionary_morse(&dictionary, index);
+    }
+    else
+    {
+        const struct word_dict_entry *entry = word_dict_at(random_index - count);
+        strcpy(word, entry->word);
+        *morse = entry->morse;
+    }
+}
+
+int check_pattern()
+{
+    int correct = check_answer(player, true);
+
+    score_keys();
+    return correct;
+}
+
+int check_answer(struct session *session, bool report)
+{
+    struct morse_symbols expected;
+    struct morse_symbols keyed = session->symbols;
+    morse_word_t target;
+
+    if (report)
+    {
+        printf("Keying speed: about %u WPM\n", keying_wpm(&session->keying));
+    }
+
+    if (session->verifier.target != NULL)
+    {
+        if (session->verifier.verdict == MORSE_ACCEPTED || read_word_answer(session, session->verifier.target, report))
         {
-            if (strcmp(alpha_morse[i], given_char) == 0)
-            {
-                if (strcmp(alpha_morse[i], morse_code_input) == 0)
-                {
-                    return 1;
-                }
-                else
-                {
-                    return 0;
-                }
-            }
+            return 1;
         }
+        target = morse_encode_word(session->verifier.target);
+    }
+    else
+    {
+        if (session->decoder.verdict == MORSE_ACCEPTED)
+        {
+            return 1;
+        }
+        target = session->decoder.target;
+    }
 
-        for (int i = 0; i < sizeof(num_morse); i++)
+    morse_symbols_from_word(&expected, target);
+    if (expected.length == 0)
+    {
+        return 0;
+    }
+    morse_match(&expected, &keyed, &answer_match);
+    if (report)
+    {
+        print_match(&answer_match);
+        print_nearest(session->input.word, session->input.letters, session->verifier.target != NULL);
+    }
+
+    if (!keyed.overflow && answer_match.distance <= console_tolerance())
+    {
+        if (report)
         {
-            if (strcmp(num_morse[i], given_char) == 0)
-            {
-                if (strcmp(num_morse[i], morse_code_input) == 0)
-                {
-                    return 1;
-                }
-                else
-                {
-                    return 0;
-                }
-            }
+            printf("Close enough: %u symbol(s) off, within the tolerance of %u\n", answer_match.distance,
+                   console_tolerance());
         }
-        break;
-    case 2:
-        for (int i = 0; i < sizeof(alpha_morse); i++)
+        return 1;
+    }
+    return 0;
+}
+
+int read_word_answer(struct session *session, const char *target, bool report)
+{
+    struct morse_beam_input marks = session->marks;
+    struct morse_beam_candidate candidates[BEAM_CANDIDATES];
+    int found;
+
+    // Only a complete answer has every gap to weigh
+    if (!session->input.complete)
+    {
+        return 0;
+    }
+    found = morse_beam_decode(&dictionary, &marks, candidates, BEAM_CANDIDATES);
+    if (found == 0)
+    {
+        return 0;
+    }
+
+    if (report)
+    {
+        printf("Your keying reads as:");
+        for (int i = 0; i < found; i++)
         {
-            if (strcmp(alpha_morse[i], given_char) == 0)
-            {
-                if (strcmp(alpha_morse[i], morse_code_input) == 0)
-                {
-                    return 1;
-                }
-                else
-                {
-                    return 0;
-                }
-            }
+            printf(" %s (%u)", candidates[i].word, (unsigned)(candidates[i].cost / MORSE_BEAM_UNIT));
         }
-        for (int i = 0; i < sizeof(num_morse); i++)
+        printf("\n");
+    }
+
+    if (strcmp(candidates[0].word, target) == 0)
+    {
+        if (report)
         {
-            if (strcmp(num_morse[i], given_char) == 0)
-            {
-                if (strcmp(num_morse[i], morse_code_input) == 0)
-                {
-                    return 1;
-                }
-                else
-                {
-                    return 0;
-                }
-            }
+            printf("Your letter gaps were off, but the best reading is the right word\n");
         }
-        break;
-    case 3:
-        for (int i = 0; i < sizeof(words); i++)
+        return 1;
+    }
+    return 0;
+}
+
+void score_keys()
+{
+    for (int channel = 0; channel < KEYS_MAX; channel++)
+    {
+        struct session *session = &sessions[channel];
+
+        // Keys that sat this one out are not marked down
+        if (channel == PLAYER || !session->element_keyed)
         {
-            if (strcmp(words[i], given_char) == 0)
-            {
-                int hashIndex = hashstring(given_char);
-                if (strcmp(hashArray[hashIndex]->morse, morse_code_input) == 0)
-                {
-                    return 1;
-                }
-                else
-                {
-                    return 0;
-                }
-            }
+            continue;
         }
-        break;
-    case 4:
-        for (int i = 0; i < sizeof(words); i++)
+        if (check_answer(session, false))
         {
-            if (strcmp(words[i], given_char) == 0)
-            {
-                int hashIndex = hashstring(given_char);
-                if (strcmp(hashArray[hashIndex]->morse, morse_code_input) == 0)
-                {
-                    return 1;
-                }
-                else
-                {
-                    return 0;
-                }
-            }
+            session->wins++;
+            session->streak++;
         }
-        break;
-    default:
-        printf("You have reached the darkness shrouding the void \n");
-        return 0;
-        break;
+        else
+        {
+            session->losses++;
+            session->streak = 0;
+        }
+        printf("Key %d: %s, %u/%u right, %u in a row\n", channel, session->streak > 0 ? "right" : "wrong",
+               session->wins, session->wins + session->losses, session->streak);
     }
-    return 0;
 }
+
+void print_key_scores()
+{
+    for (int channel = 0; channel < KEYS_MAX; channel++)
+    {
+        struct session *session = &sessions[channel];
+
+        if (channel != PLAYER && session->wins + session->losses > 0)
+        {
+            printf("Key %d: %u/%u right at about %u WPM\n", channel, session->wins, session->wins + session->losses,
+                   keying_wpm(&session->keying));
+        }
+    }
+}
+
+void print_nearest(morse_word_t keyed, unsigned letters, bool word)
+{
+    struct morse_batch_candidate candidates[NEAREST_CANDIDATES];
+    char text[DICTIONARY_WORD_MAX + 1];
+    int found;
+
+    if (keyed == MORSE_WORD_INVALID || letters == 0)
+    {
+        return;
+    }
+    if (!word && letters == 1)
+    {
+        found = morse_batch_match_chars(morse_batch_char_keys, MORSE_BATCH_CHARACTERS,
+                                        morse_batch_char_key((morse_code_t)keyed), candidates, NEAREST_CANDIDATES);
+        printf("You keyed nearest to:");
+        for (int i = 0; i < found; i++)
+        {
+            printf(" %c (%u off)", alphabet[candidates[i].index], candidates[i].distance);
+        }
+        printf("\n");
+    }
+    else if (word && dictionary.header != NULL)
+    {
+        found = morse_batch_match_words(dictionary_match_keys(&dictionary), dictionary_count(&dictionary),
+                                        morse_batch_word_key(keyed), candidates, NEAREST_CANDIDATES);
+        printf("You keyed nearest to:");
+        for (int i = 0; i < found; i++)
+        {
+            dictionary_word(&dictionary, candidates[i].index, text);
+            printf(" %s (%u letters off)", text, candidates[i].distance);
+        }
+        printf("\n");
+    }
+}
+
+void print_match(const struct morse_match *match)
+{
+    static const char symbol_text[MORSE_SYMBOL_COUNT] = {'.', '-', ' '};
+    static const char edit_text[] = {[MORSE_EDIT_MATCH] = ' ', [MORSE_EDIT_SUBSTITUTE] = '^',
+                                     [MORSE_EDIT_INSERT] = '+', [MORSE_EDIT_DELETE] = '!'};
+
+    printf("Expected: ");
+    for (int i = 0; i < match->length; i++)
+    {
+        putchar(match->steps[i].edit == MORSE_EDIT_INSERT ? '_' : symbol_text[match->steps[i].expected]);
+    }
+    printf("\nKeyed:    ");
+    for (int i = 0; i < match->length; i++)
+    {
+        putchar(match->steps[i].edit == MORSE_EDIT_DELETE ? '_' : symbol_text[match->steps[i].keyed]);
+    }
+    printf("\n          ");
+    for (int i = 0; i < match->length; i++)
+    {
+        putchar(edit_text[match->steps[i].edit]);
+    }
+    printf("\n%u wrong (^), %u extra (+), %u missing (!)\n", match->substitutions, match->insertions, match->deletions);
+}
+
 void level_1()
 {
     lives = 3;
@@ -605,37 +1120,21 @@ void level_1()
 
     while (1)
     {
-        char *morse_value;
-        char *given_char = generate_random_character(); // given char is a global variable
-
-        int index_for_morse;
-        for (int i = 0; i < sizeof(alpha_morse); i++)
-        {
-            if (strcmp(given_char, alphabet[i]) == 0)
-            {
-                index_for_morse = i;
-                if (index_for_morse > 25)
-                {
-                    index_for_morse = index_for_morse - 26;
-                    morse_value = num_morse[index_for_morse];
-                }
-                else
-                {
-                    morse_value = alpha_morse[index_for_morse];
-                }
-                break;
-            }
-        }
+        char given_char = generate_random_character();
+        morse_code_t morse_value = morse_encode(given_char);
+        char morse_text[MORSE_STRING_MAX];
 
         printf("Input the corresponding morse code for the following letter to progress to the next level:\n");
         printf("Letter: %c\n", given_char);
-        printf("Morse code: %s\n", morse_value);
+        printf("Morse code: %s\n", morse_format(morse_value, morse_text, sizeof morse_text));
 
         while (1)
         {
-            memset(set_input_array, 0, sizeof set_input_array);
+            start_answer(morse_value);
             main_asm();
-            if (check_pattern(1, morse_value, set_input_array) == 1)
+            int correct = check_pattern();
+            challenge_record_char(given_char, correct == 1);
+            if (correct == 1)
             {
                 correct_try_count++;
                 consecutive_wins++;
@@ -691,36 +1190,19 @@ void level_2()
 
     while (1)
     {
-        char *morse_value;
-        char *given_char = generate_random_character(); // given char is a global variable
-
-        int index_for_morse;
-        for (int i = 0; i < sizeof(alpha_morse); i++)
-        {
-            if (strcmp(given_char, alphabet[i]) == 0)
-            {
-                index_for_morse = i;
-                if (index_for_morse > 25)
-                {
-                    index_for_morse = index_for_morse - 26;
-                    morse_value = num_morse[index_for_morse];
-                }
-                else
-                {
-                    morse_value = alpha_morse[index_for_morse];
-                }
-                break;
-            }
-        }
+        char given_char = generate_random_character();
+        morse_code_t morse_value = morse_encode(given_char);
 
         printf("Input the corresponding morse code for the following letter to progress to the next level:\n");
         printf("Letter: %c\n", given_char);
 
         while (1)
         {
-            memset(set_input_array, 0, sizeof set_input_array);
+            start_answer(morse_value);
             main_asm();
-            if (check_pattern(2, morse_value, set_input_array) == 1)
+            int correct = check_pattern();
+            challenge_record_char(given_char, correct == 1);
+            if (correct == 1)
             {
                 correct_try_count++;
                 consecutive_wins++;
@@ -773,18 +1255,26 @@ void level_3()
 
     game_status = true;
     set_rgb();
+    challenge_reset_words();
     while (1)
     {
-        int random_index = random() % 20;
+        morse_word_t word_morse;
+        char given_word[DICTIONARY_WORD_MAX + 1];
+        char morse_text[MORSE_STRING_MAX];
+
+        generate_random_word(LEVEL_3_MAX_UNITS, given_word, &word_morse);
 
         printf("Input the corresponding morse code for the following word to progress to the next level:\n");
-        printf("Word: %c\n", words[random_index]);
-        printf("Morse code: %s\n", words_morse[random_index]);
+        printf("Word: %s\n", given_word);
+        printf("Morse code: %s\n", morse_format(word_morse, morse_text, sizeof morse_text));
 
         while (1)
         {
-            memset(set_input_array, 0, sizeof set_input_array);
-            if (check_pattern(3, words_morse[random_index], set_input_array) == 1) // need to change these inputs since it's level 3
+            start_word_answer(given_word);
+            main_asm();
+            int correct = check_pattern();
+            challenge_record_word(given_word, correct == 1);
+            if (correct == 1)
             {
                 correct_try_count++;
 
@@ -800,6 +1290,7 @@ void level_3()
             {
                 lives--;
                 fail_count++;
+                printf("Letter %u of %u should have been %c\n", player->verifier.correct + 1, player->verifier.letters, word_verifier_expected(&player->verifier));
                 printf("That is incorrect - %i lives remaining\n", lives);
             }
 
@@ -835,19 +1326,25 @@ void level_4()
 
     game_status = true;
     set_rgb();
+    challenge_reset_words();
 
     while (1)
     {
-        int random_index = random() % 20;
+        morse_word_t word_morse;
+        char given_word[DICTIONARY_WORD_MAX + 1];
+
+        generate_random_word(LEVEL_4_MAX_UNITS, given_word, &word_morse);
 
         printf("Input the corresponding morse code for the following word to progress to the next level:\n");
-        printf("Word: %c\n", words[random_index]);
+        printf("Word: %s\n", given_word);
 
         while (1)
         {
-            memset(set_input_array, 0, sizeof set_input_array);
+            start_word_answer(given_word);
             main_asm();
-            if (check_pattern(4, words_morse[random_index], set_input_array) == 1) // need to change these inputs since it's level 4
+            int correct = check_pattern();
+            challenge_record_word(given_word, correct == 1);
+            if (correct == 1)
             {
                 correct_try_count++;
 
@@ -863,6 +1360,7 @@ void level_4()
             {
                 lives--;
                 fail_count++;
+                printf("Letter %u of %u should have been %c\n", player->verifier.correct + 1, player->verifier.letters, word_verifier_expected(&player->verifier));
                 printf("That is incorrect - %i lives remaining\n", lives);
             }
 
@@ -897,4 +1395,5 @@ void print_level_stats(int num_wins, int num_losses)
     printf("Number of successful attempts: %i\n", num_wins);
     printf("Number of failed attempts: %i\n", num_losses);
     printf("Success Rate: %i%% ", win_percentage);
+    print_key_scores();
 }
@@ -0,0 +1,143 @@
+/*
+ * Import header files
+ */
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "audio.h"
+
+#define AUDIO_ADC_HZ 48000000u       // clk_adc, from the USB PLL
+#define AUDIO_FIRST_PIN 26           // ADC input 0
+#define AUDIO_TRANSFERS 0xFFFFFFFFu
+#define AUDIO_BUFFER_SAMPLES ((1u << AUDIO_BUFFER_BITS) / sizeof(uint16_t))
+
+_Static_assert(AUDIO_BUFFER_SAMPLES == 2 * TONE_BLOCK_SAMPLES, "AUDIO_BUFFER_BITS holds two blocks");
+
+// The DMA write address wraps on the buffer size, so the buffers must be aligned to it
+static uint16_t buffer[AUDIO_BUFFER_SAMPLES] __attribute__((aligned(1u << AUDIO_BUFFER_BITS)));
+static int channel = -1;
+static bool running;
+static struct tone_detector detector;
+static uint64_t start_us;     // When the first sample was taken
+static uint32_t blocks_read;  // Blocks read or skipped since audio_start()
+static struct audio_stats stats;
+
+// Blocks the DMA has finished since audio_start()
+static uint32_t blocks_written(void)
+{
+    return (AUDIO_TRANSFERS - dma_channel_hw_addr(channel)->transfer_count) / TONE_BLOCK_SAMPLES;
+}
+
+void audio_init(unsigned adc_input)
+{
+    adc_init();
+    adc_gpio_init(AUDIO_FIRST_PIN + adc_input);
+    adc_select_input(adc_input);
+    // Every sample raises DREQ, kept as 12 bits in a halfword, errors not flagged
+    adc_fifo_setup(true, true, 1, false, false);
+    // No floating point: the divider is set in whole clk_adc cycles
+    adc_hw->div = (AUDIO_ADC_HZ / AUDIO_SAMPLE_HZ - 1) << ADC_DIV_INT_LSB;
+    channel = dma_claim_unused_channel(true);
+    running = false;
+}
+
+void audio_start(uint32_t tone_hz)
+{
+    dma_channel_config config;
+
+    audio_stop();
+    tone_init(&detector, AUDIO_SAMPLE_HZ, tone_hz);
+    blocks_read = 0;
+
+    config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, AUDIO_BUFFER_BITS);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(channel, &config, buffer, &adc_hw->fifo, AUDIO_TRANSFERS, true);
+
+    adc_run(true);
+    start_us = time_us_64();
+    running = true;
+}
+
+void audio_stop(void)
+{
+    if (!running)
+    {
+        return;
+    }
+    adc_run(false);
+    dma_channel_abort(channel);
+    adc_fifo_drain();
+    running = false;
+}
+
+bool audio_running(void)
+{
+    return running;
+}
+
+void audio_discard(void)
+{
+    if (running)
+    {
+        blocks_read = blocks_written();
+    }
+}
+
+bool audio_read(struct edge_event *edge)
+{
+    uint32_t written;
+    uint32_t started;
+    uint32_t took;
+    bool changed;
+
+    while (running && (written = blocks_written()) != blocks_read)
+    {
+        // The block being written shares a buffer with the one before last, which is gone
+        if (written - blocks_read > 1)
+        {
+            stats.overruns += written - blocks_read - 1;
+            blocks_read = written - 1;
+        }
+
+        started = time_us_32();
+        changed = tone_block(&detector, &buffer[(blocks_read % 2) * TONE_BLOCK_SAMPLES]);
+        took = time_us_32() - started;
+        blocks_read++;
+        stats.blocks++;
+        stats.busy_us += took;
+        if (took > stats.worst_us)
+        {
+            stats.worst_us = took;
+        }
+
+        if (changed)
+        {
+            // Dated from the first of the blocks that confirmed it
+            edge->time_us = start_us + (uint64_t)(blocks_read - TONE_CONFIRM_BLOCKS) * AUDIO_BLOCK_US;
+            edge->type = detector.on ? EDGE_PRESSED : EDGE_RELEASED;
+            edge->channel = 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool audio_next(uint64_t *deadline)
+{
+    if (!running)
+    {
+        return false;
+    }
+    // From the block being written, so the deadline is never already past
+    *deadline = start_us + (uint64_t)(blocks_written() + 1) * AUDIO_BLOCK_US;
+    return true;
+}
+
+void audio_get_stats(struct audio_stats *copy)
+{
+    *copy = stats;
+}
@@ -0,0 +1,86 @@
+#ifndef ASSIGN02_AUDIO_H
+#define ASSIGN02_AUDIO_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "edge_ring.h"
+#include "tone.h"
+
+/*
+ * Keying from sound: the ADC samples a practice oscillator or a radio's
+ * audio output at AUDIO_SAMPLE_HZ and a DMA channel copies the samples
+ * into two buffers of one tone block each, the write address wrapping from
+ * the second back to the first, so the CPU takes no interrupt per sample
+ * or per block. The main loop runs each finished block through the tone
+ * detector (tone.c) and turns the tone starting and stopping into the same
+ * press and release edges the button produces.
+ *
+ * Detecting costs the same for every block, and audio_read() never handles
+ * more than the two blocks the buffers hold, so the CPU time is bounded.
+ * It is measured as it runs (audio_get_stats()). A main loop slower than a
+ * block loses the blocks the DMA has written over, which are counted.
+ *
+ * No board figures are given here. The CPU share and how detection
+ * latency varies with SNR have not been measured on the RP2040, only the
+ * detector on a host (tests/test_tone.c).
+ */
+
+#define AUDIO_SAMPLE_HZ 8000u
+#define AUDIO_BLOCK_US (TONE_BLOCK_SAMPLES * 1000000u / AUDIO_SAMPLE_HZ) // 8 ms
+#define AUDIO_BUFFER_BITS 8 // Two blocks of 16-bit samples, 256 bytes
+#define AUDIO_MAX_HZ 3000u  // Highest tone, well below half the sample rate
+
+struct audio_stats
+{
+    uint32_t blocks;       // Blocks run through the detector
+    uint32_t overruns;     // Blocks written over before they were read
+    uint32_t busy_us;      // Time spent detecting
+    uint32_t worst_us;     // Longest one block took
+};
+
+/*
+ * Sets up the ADC on the given input (GP26 + input) and claims a DMA channel
+ */
+void audio_init(unsigned adc_input);
+
+/*
+ * Starts sampling and listens for tone_hz, relearning the noise and tone levels
+ */
+void audio_start(uint32_t tone_hz);
+
+/*
+ * Stops sampling
+ */
+void audio_stop(void);
+
+/*
+ * Returns true while sampling
+ */
+bool audio_running(void);
+
+/*
+ * Skips the blocks sampled so far, keeping the levels learnt from them
+ */
+void audio_discard(void);
+
+/*
+ * Runs the finished blocks through the detector until the tone comes on or
+ * goes off, and gives that as a press or release of channel 0
+ * Returns false once every finished block has been read
+ */
+bool audio_read(struct edge_event *edge);
+
+/*
+ * Gives the time the next block will be finished, returns false if not sampling
+ */
+bool audio_next(uint64_t *deadline);
+
+/*
+ * Copies the detector's running costs
+ */
+void audio_get_stats(struct audio_stats *stats);
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Import header files
+ */
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "assign02.pio.h"
+#include "button_timer.h"
+
+#define BUTTON_TIMER_EMPTY 0xFFFFFFFFu  // Never pushed: every phase counts at least one tick
+#define BUTTON_TIMER_TRANSFERS 0xFFFFFFFFu
+
+// The DMA write address wraps on the ring size, so the ring must be aligned to it
+static uint32_t ring[BUTTON_TIMER_RING_WORDS] __attribute__((aligned(1u << BUTTON_TIMER_RING_BITS)));
+static int channel = -1;
+static uint32_t tail;    // Widths read so far
+static uint32_t dropped;
+
+// Widths the DMA has written so far, counted down from BUTTON_TIMER_TRANSFERS
+static uint32_t ring_head(void)
+{
+    return BUTTON_TIMER_TRANSFERS - dma_channel_hw_addr(channel)->transfer_count;
+}
+
+void button_timer_init(PIO pio, uint sm, uint pin, uint32_t filter_us)
+{
+    uint offset = pio_add_program(pio, &button_timer_program);
+    uint32_t filter = filter_us * (BUTTON_TIMER_TICK_HZ / 1000000u);
+    dma_channel_config config;
+
+    for (size_t i = 0; i < BUTTON_TIMER_RING_WORDS; i++)
+    {
+        ring[i] = BUTTON_TIMER_EMPTY;
+    }
+    tail = 0;
+    dropped = 0;
+
+    channel = dma_claim_unused_channel(true);
+    config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, BUTTON_TIMER_RING_BITS);
+    channel_config_set_dreq(&config, pio_get_dreq(pio, sm, false));
+    dma_channel_configure(channel, &config, ring, &pio->rxf[sm], BUTTON_TIMER_TRANSFERS, true);
+
+    // The program waits for filter + 2 samples in a row
+    filter = filter > BUTTON_TIMER_FILTER_MIN_TICKS ? filter - BUTTON_TIMER_FILTER_MIN_TICKS : 0;
+    button_timer_program_init(pio, sm, offset, pin, BUTTON_TIMER_TICK_HZ, filter);
+}
+
+bool button_timer_read(struct button_width *width)
+{
+    uint32_t head = ring_head();
+    uint32_t *slot;
+
+    // The writer laps a slow reader, skip what it has overwritten
+    if (head - tail > BUTTON_TIMER_RING_WORDS)
+    {
+        dropped += head - tail - BUTTON_TIMER_RING_WORDS;
+        tail = head - BUTTON_TIMER_RING_WORDS;
+    }
+    if (head == tail)
+    {
+        return false;
+    }
+    // The transfer count can move before the word lands, so wait for the slot to be filled
+    slot = &ring[tail % BUTTON_TIMER_RING_WORDS];
+    if (*(volatile uint32_t *)slot == BUTTON_TIMER_EMPTY)
+    {
+        return false;
+    }
+    *width = button_timer_decode(*slot);
+    *(volatile uint32_t *)slot = BUTTON_TIMER_EMPTY;
+    tail++;
+    return true;
+}
+
+void button_timer_discard(void)
+{
+    struct button_width width;
+
+    while (button_timer_read(&width))
+    {
+    }
+}
+
+uint32_t button_timer_dropped(void)
+{
+    return dropped;
+}
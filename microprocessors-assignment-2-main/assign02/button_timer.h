@@ -0,0 +1,64 @@
+#ifndef ASSIGN02_BUTTON_TIMER_H
+#define ASSIGN02_BUTTON_TIMER_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+
+/*
+ * Button timing without interrupts: the button_timer PIO program (in
+ * assign02.pio) debounces the pin and measures every press and gap in
+ * microsecond ticks, and a DMA channel copies each measurement from the RX
+ * FIFO into a ring in RAM. The CPU only reads the ring when it has time.
+ */
+
+#define BUTTON_TIMER_TICK_HZ 1000000u       // One tick per microsecond
+#define BUTTON_TIMER_RING_BITS 8            // Ring of 1 << 8 bytes, 64 widths
+#define BUTTON_TIMER_RING_WORDS ((1u << BUTTON_TIMER_RING_BITS) / sizeof(uint32_t))
+#define BUTTON_TIMER_PUSH_TICKS 2           // Ticks each push takes without counting
+#define BUTTON_TIMER_FILTER_MIN_TICKS 2     // Shortest filter the program can do
+
+/*
+ * One measured press or gap
+ */
+struct button_width
+{
+    bool pressed;  // A press (pin low) rather than a gap
+    uint32_t us;
+};
+
+/*
+ * Turns a word pushed by button_timer into the width it stands for
+ */
+static inline struct button_width button_timer_decode(uint32_t word)
+{
+    return (struct button_width){.pressed = (word >> 31) != 0,
+                                 .us = (0x7FFFFFFFu - (word & 0x7FFFFFFFu)) + BUTTON_TIMER_PUSH_TICKS};
+}
+
+/*
+ * Loads the program onto state machine sm of pio, starts timing pin, and
+ * starts a DMA channel copying the widths into the ring. A level has to
+ * last filter_us before it counts (at least 2 us).
+ */
+void button_timer_init(PIO pio, uint sm, uint pin, uint32_t filter_us);
+
+/*
+ * Takes the oldest width from the ring, returns false if there is none
+ */
+bool button_timer_read(struct button_width *width);
+
+/*
+ * Throws away every width waiting in the ring
+ */
+void button_timer_discard(void);
+
+/*
+ * Returns how many widths were overwritten before they were read
+ */
+uint32_t button_timer_dropped(void);
+
+#endif
@@ -0,0 +1,248 @@
+/*
+ * Import header files
+ */
+#include <string.h>
+#include "challenge.h"
+#include "alias.h"
+#include "deck.h"
+#include "morse.h"
+#include "rng.h"
+
+#define CHARACTERS 36 // Letters and digits, in alphabet[] order
+
+struct review_word
+{
+    char word[DICTIONARY_WORD_MAX + 1];
+    uint8_t errors;
+};
+
+static bool deck_mode;
+static struct card_deck char_deck;
+static struct index_deck word_deck;
+static bool decks_ready;
+
+static uint8_t char_errors[CHARACTERS];
+static struct alias_table char_table;
+static bool char_table_ready;
+static char last_char;
+
+static struct review_word pool[CHALLENGE_POOL_SIZE];
+static unsigned pool_count;
+static struct alias_table word_table; // Pool entries, then the fresh word slot
+static bool word_table_ready;
+
+static void build_char_table(void)
+{
+    uint32_t weights[CHARACTERS];
+
+    for (int i = 0; i < CHARACTERS; i++)
+    {
+        weights[i] = CHALLENGE_BASE_WEIGHT + CHALLENGE_ERROR_WEIGHT * char_errors[i];
+    }
+    alias_build(&char_table, weights, CHARACTERS);
+    char_table_ready = true;
+}
+
+static void build_word_table(void)
+{
+    uint32_t weights[CHALLENGE_POOL_SIZE + 1];
+
+    for (unsigned i = 0; i < pool_count; i++)
+    {
+        weights[i] = CHALLENGE_ERROR_WEIGHT * pool[i].errors;
+    }
+    weights[pool_count] = CHALLENGE_BASE_WEIGHT;
+    alias_build(&word_table, weights, pool_count + 1);
+    word_table_ready = true;
+}
+
+/*
+ * Returns the pool index of word, or -1
+ */
+static int find_review(const char *word)
+{
+    for (unsigned i = 0; i < pool_count; i++)
+    {
+        if (strcmp(pool[i].word, word) == 0)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Shuffles the decks again after a new seed or mode
+ */
+static void reset_decks(void)
+{
+    card_deck_init(&char_deck, CHARACTERS);
+    index_deck_init(&word_deck, 0);
+    decks_ready = true;
+}
+
+void challenge_seed(uint32_t seed)
+{
+    rng_seed(seed);
+    last_char = '\0';
+    decks_ready = false;
+}
+
+void challenge_set_deck(bool deck)
+{
+    deck_mode = deck;
+    decks_ready = false;
+}
+
+bool challenge_get_deck(void)
+{
+    return deck_mode;
+}
+
+char challenge_next_char(void)
+{
+    unsigned index;
+
+    if (deck_mode)
+    {
+        if (!decks_ready)
+        {
+            reset_decks();
+        }
+        return alphabet[card_deck_draw(&char_deck)];
+    }
+
+    if (!char_table_ready)
+    {
+        build_char_table();
+    }
+    // One redraw makes an immediate repeat rare without changing the weights much
+    index = alias_draw(&char_table);
+    if (alphabet[index] == last_char)
+    {
+        index = alias_draw(&char_table);
+    }
+    last_char = alphabet[index];
+    return last_char;
+}
+
+void challenge_record_char(char c, bool correct)
+{
+    const char *found = strchr(alphabet, c);
+
+    if (c == '\0' || found == NULL)
+    {
+        return;
+    }
+
+    uint8_t *errors = &char_errors[found - alphabet];
+    if (!correct && *errors < CHALLENGE_MAX_ERRORS)
+    {
+        (*errors)++;
+    }
+    else if (correct && *errors > 0)
+    {
+        (*errors)--;
+    }
+    else
+    {
+        return;
+    }
+    build_char_table();
+}
+
+void challenge_reset_words(void)
+{
+    pool_count = 0;
+    build_word_table();
+}
+
+bool challenge_next_word(char word[DICTIONARY_WORD_MAX + 1])
+{
+    // The deck alone decides the order in deck mode
+    if (deck_mode)
+    {
+        return false;
+    }
+    if (!word_table_ready)
+    {
+        build_word_table();
+    }
+
+    unsigned slot = alias_draw(&word_table);
+    if (slot >= pool_count)
+    {
+        return false;
+    }
+    strcpy(word, pool[slot].word);
+    return true;
+}
+
+size_t challenge_fresh_index(size_t count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    if (!deck_mode)
+    {
+        return rng_below((uint32_t)count);
+    }
+    if (!decks_ready)
+    {
+        reset_decks();
+    }
+    // Words uploaded or a new level change the range, which starts a new pass
+    if (word_deck.count != count)
+    {
+        index_deck_init(&word_deck, (uint32_t)count);
+    }
+    return index_deck_draw(&word_deck);
+}
+
+void challenge_record_word(const char *word, bool correct)
+{
+    int index = find_review(word);
+
+    if (correct)
+    {
+        if (index < 0)
+        {
+            return;
+        }
+        // Reviewed words leave the pool once their errors are worked off
+        if (--pool[index].errors == 0)
+        {
+            pool[index] = pool[--pool_count];
+        }
+    }
+    else if (index >= 0)
+    {
+        if (pool[index].errors < CHALLENGE_MAX_ERRORS)
+        {
+            pool[index].errors++;
+        }
+    }
+    else if (strlen(word) <= DICTIONARY_WORD_MAX)
+    {
+        // A full pool gives up the word with the fewest errors
+        if (pool_count == CHALLENGE_POOL_SIZE)
+        {
+            index = 0;
+            for (unsigned i = 1; i < pool_count; i++)
+            {
+                if (pool[i].errors < pool[index].errors)
+                {
+                    index = (int)i;
+                }
+            }
+        }
+        else
+        {
+            index = (int)pool_count++;
+        }
+        strcpy(pool[index].word, word);
+        pool[index].errors = 1;
+    }
+    build_word_table();
+}
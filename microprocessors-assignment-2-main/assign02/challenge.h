@@ -0,0 +1,75 @@
+#ifndef ASSIGN02_CHALLENGE_H
+#define ASSIGN02_CHALLENGE_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "dictionary.h"
+
+/*
+ * Picks the next challenge, favouring what the player keeps getting wrong.
+ * Each character is drawn with weight CHALLENGE_BASE_WEIGHT plus
+ * CHALLENGE_ERROR_WEIGHT per recent error. Missed words go into a review
+ * pool of CHALLENGE_POOL_SIZE words, drawn against one extra slot for a
+ * fresh word. Both draws use an alias table (alias.h), rebuilt after each
+ * answer in time bounded by the table size. In deck mode the weights are
+ * ignored and every character or fresh word comes up once before any
+ * repeats (deck.h). All draws come from the seeded generator in rng.h.
+ */
+#define CHALLENGE_POOL_SIZE 32     // Missed words kept for review
+#define CHALLENGE_BASE_WEIGHT 4    // Weight of a character with no errors, and of a fresh word
+#define CHALLENGE_ERROR_WEIGHT 4   // Weight added per error
+#define CHALLENGE_MAX_ERRORS 15    // Errors remembered per character or word
+
+/*
+ * Restarts the generator from seed and reshuffles the decks, so a session
+ * started from the same seed draws the same challenges
+ */
+void challenge_seed(uint32_t seed);
+
+/*
+ * Switches between weighted draws (false, the default) and shuffled decks (true)
+ */
+void challenge_set_deck(bool deck);
+
+/*
+ * Returns true in deck mode
+ */
+bool challenge_get_deck(void);
+
+/*
+ * Returns the next character for levels 1 and 2
+ */
+char challenge_next_char(void);
+
+/*
+ * Records whether c was keyed correctly: an error makes it more likely, a
+ * correct answer works one error off
+ */
+void challenge_record_char(char c, bool correct);
+
+/*
+ * Empties the review pool, for the start of a word level
+ */
+void challenge_reset_words(void);
+
+/*
+ * Copies a missed word to review into word and returns true, or returns
+ * false when a fresh word should be picked instead
+ */
+bool challenge_next_word(char word[DICTIONARY_WORD_MAX + 1]);
+
+/*
+ * Returns which of count fresh words to use next
+ */
+size_t challenge_fresh_index(size_t count);
+
+/*
+ * Records whether word was keyed correctly
+ */
+void challenge_record_word(const char *word, bool correct);
+
+#endif
@@ -0,0 +1,321 @@
+/*
+ * Import header files
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "console.h"
+#include "word_dict.h"
+#include "dictionary.h"
+#include "challenge.h"
+#include "rng.h"
+#include "keying.h"
+#include "audio.h"
+
+#define CONSOLE_LINE_MAX 32
+#define CONSOLE_TOLERANCE_MAX 8
+#define CONSOLE_KEYER_WPM 15
+
+static char line[CONSOLE_LINE_MAX];
+static size_t line_length;
+static unsigned tolerance;
+static enum keyer_mode keyer_mode = KEYER_OFF;
+static unsigned keyer_wpm = CONSOLE_KEYER_WPM;
+static unsigned audio_hz;
+static enum console_bench bench_requested;
+
+static void add_word(const char *word)
+{
+    struct dictionary dictionary;
+
+    if (dictionary_open(&dictionary, dictionary_blob, dictionary_blob_size) && dictionary_lookup(&dictionary, word) >= 0)
+    {
+        printf("\"%s\" is already a built-in word\n", word);
+        return;
+    }
+    switch (word_dict_insert(word))
+    {
+    case WORD_DICT_OK:
+        printf("Added \"%s\"\n", word);
+        break;
+    case WORD_DICT_EXISTS:
+        printf("\"%s\" has already been added\n", word);
+        break;
+    case WORD_DICT_FULL:
+        printf("Dictionary is full (%u words)\n", (unsigned)WORD_DICT_MAX_WORDS);
+        break;
+    default:
+        printf("\"%s\" must be 1-%d letters or digits\n", word, MORSE_WORD_MAX_LETTERS);
+        break;
+    }
+}
+
+static void delete_word(const char *word)
+{
+    if (word_dict_delete(word) == WORD_DICT_OK)
+    {
+        printf("Removed \"%s\"\n", word);
+    }
+    else
+    {
+        printf("\"%s\" is not an uploaded word\n", word);
+    }
+}
+
+static void list_words(void)
+{
+    char morse_text[MORSE_STRING_MAX];
+
+    for (size_t i = 0; i < word_dict_count(); i++)
+    {
+        const struct word_dict_entry *entry = word_dict_at(i);
+        printf("%s\t%s\n", entry->word, morse_format(entry->morse, morse_text, sizeof morse_text));
+    }
+}
+
+static void print_stats(void)
+{
+    struct word_dict_stats stats;
+
+    word_dict_get_stats(&stats);
+    printf("Uploaded words: %u/%u (%u%% full), %u bytes, longest probe %d\n",
+           (unsigned)stats.words, (unsigned)stats.capacity, (unsigned)(stats.words * 100 / stats.capacity),
+           (unsigned)stats.bytes, stats.longest_probe);
+}
+
+static void set_tolerance(const char *argument)
+{
+    char *end;
+    unsigned long value = strtoul(argument, &end, 10);
+
+    if (*end != '\0' || value > CONSOLE_TOLERANCE_MAX)
+    {
+        printf("Tolerance must be 0-%d symbols\n", CONSOLE_TOLERANCE_MAX);
+        return;
+    }
+    tolerance = (unsigned)value;
+    printf(tolerance == 0 ? "Answers must be exact\n" : "Answers may be %u symbols off\n", tolerance);
+}
+
+static void set_seed(const char *argument)
+{
+    char *end;
+    unsigned long value;
+
+    if (argument == NULL || *argument == '\0')
+    {
+        printf("Random seed %08lx\n", (unsigned long)rng_get_seed());
+        return;
+    }
+    value = strtoul(argument, &end, 16);
+    if (*end != '\0')
+    {
+        printf("Seed must be a hex number\n");
+        return;
+    }
+    challenge_seed((uint32_t)value);
+    printf("Random seed %08lx, challenges start over\n", value);
+}
+
+static void set_deck(const char *argument)
+{
+    if (strcmp(argument, "on") == 0 || strcmp(argument, "off") == 0)
+    {
+        challenge_set_deck(strcmp(argument, "on") == 0);
+    }
+    printf(challenge_get_deck() ? "Shuffled decks: everything comes up once before any repeats\n"
+                                : "Weighted draws: what you get wrong comes up more often\n");
+}
+
+static void set_keyer(char *argument)
+{
+    static const char *const mode_names[] = {[KEYER_OFF] = "off", [KEYER_IAMBIC_A] = "a", [KEYER_IAMBIC_B] = "b"};
+    char *speed = strchr(argument, ' ');
+    char *end;
+    unsigned long wpm;
+
+    if (speed != NULL)
+    {
+        *speed++ = '\0';
+        wpm = strtoul(speed, &end, 10);
+        if (*end != '\0' || wpm < KEYING_MIN_WPM || wpm > KEYING_MAX_WPM)
+        {
+            printf("Keyer speed must be %d-%d WPM\n", KEYING_MIN_WPM, KEYING_MAX_WPM);
+            return;
+        }
+        keyer_wpm = (unsigned)wpm;
+    }
+    for (int mode = KEYER_OFF; mode <= KEYER_IAMBIC_B; mode++)
+    {
+        if (strcmp(argument, mode_names[mode]) == 0)
+        {
+            keyer_mode = (enum keyer_mode)mode;
+        }
+    }
+    if (keyer_mode == KEYER_OFF)
+    {
+        printf("Keyer off, answers are keyed on the button\n");
+    }
+    else
+    {
+        printf("Iambic keyer mode %c at %u WPM, from the next answer\n", keyer_mode == KEYER_IAMBIC_A ? 'A' : 'B', keyer_wpm);
+    }
+}
+
+static void set_audio(const char *argument)
+{
+    struct audio_stats stats;
+    char *end;
+    unsigned long hz;
+    unsigned long share;
+
+    if (strcmp(argument, "off") == 0)
+    {
+        audio_hz = 0;
+        printf("Answers are keyed on the button, from the next answer\n");
+        return;
+    }
+    if (*argument != '\0')
+    {
+        hz = strtoul(argument, &end, 10);
+        if (*end != '\0' || hz < TONE_MIN_HZ || hz > AUDIO_MAX_HZ)
+        {
+            printf("Tone must be %d-%u Hz\n", TONE_MIN_HZ, AUDIO_MAX_HZ);
+            return;
+        }
+        audio_hz = (unsigned)hz;
+        printf("Listening for a %u Hz tone on GP26, from the next answer\n", audio_hz);
+        return;
+    }
+
+    audio_get_stats(&stats);
+    if (stats.blocks == 0)
+    {
+        printf("No audio processed yet\n");
+        return;
+    }
+    // Share of the time sampled that was spent detecting, in hundredths of a percent
+    share = (unsigned long)((uint64_t)stats.busy_us * 10000 / ((uint64_t)stats.blocks * AUDIO_BLOCK_US));
+    printf("Audio: %lu blocks, %lu lost, %lu us a block on average, %lu us at worst, %lu.%02lu%% of the CPU\n",
+           (unsigned long)stats.blocks, (unsigned long)stats.overruns, (unsigned long)(stats.busy_us / stats.blocks),
+           (unsigned long)stats.worst_us, share / 100, share % 100);
+}
+
+static void run_command(char *command)
+{
+    char *argument = strchr(command, ' ');
+
+    if (argument != NULL)
+    {
+        *argument++ = '\0';
+        while (*argument == ' ')
+        {
+            argument++;
+        }
+    }
+
+    if (strcmp(command, "add") == 0 && argument != NULL && *argument != '\0')
+    {
+        add_word(argument);
+    }
+    else if (strcmp(command, "del") == 0 && argument != NULL && *argument != '\0')
+    {
+        delete_word(argument);
+    }
+    else if (strcmp(command, "words") == 0)
+    {
+        list_words();
+    }
+    else if (strcmp(command, "stats") == 0)
+    {
+        print_stats();
+    }
+    else if (strcmp(command, "tolerance") == 0 && argument != NULL && *argument != '\0')
+    {
+        set_tolerance(argument);
+    }
+    else if (strcmp(command, "seed") == 0)
+    {
+        set_seed(argument);
+    }
+    else if (strcmp(command, "deck") == 0)
+    {
+        set_deck(argument != NULL ? argument : "");
+    }
+    else if (strcmp(command, "keyer") == 0)
+    {
+        set_keyer(argument != NULL ? argument : "");
+    }
+    else if (strcmp(command, "audio") == 0)
+    {
+        set_audio(argument != NULL ? argument : "");
+    }
+    else if (strcmp(command, "bench") == 0)
+    {
+        if (argument == NULL)
+        {
+            bench_requested = CONSOLE_BENCH_EDGES;
+        }
+        else if (strcmp(argument, "led") == 0)
+        {
+            bench_requested = CONSOLE_BENCH_LED;
+        }
+        else
+        {
+            printf("Usage: bench [led]\n");
+        }
+    }
+    else if (*command != '\0')
+    {
+        printf("Commands: add <word>, del <word>, words, stats, tolerance <n>, seed [hex], deck [on|off], "
+               "keyer [off|a|b] [wpm], audio [off|hz], bench [led]\n");
+    }
+}
+
+void console_poll(void)
+{
+    int c;
+
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT)
+    {
+        if (c == '\r' || c == '\n')
+        {
+            line[line_length] = '\0';
+            line_length = 0;
+            run_command(line);
+        }
+        else if (line_length < CONSOLE_LINE_MAX - 1)
+        {
+            line[line_length++] = (char)c;
+        }
+    }
+}
+
+unsigned console_tolerance(void)
+{
+    return tolerance;
+}
+
+enum keyer_mode console_keyer_mode(void)
+{
+    return keyer_mode;
+}
+
+unsigned console_keyer_wpm(void)
+{
+    return keyer_wpm;
+}
+
+unsigned console_audio_hz(void)
+{
+    return audio_hz;
+}
+
+enum console_bench console_take_bench(void)
+{
+    enum console_bench requested = bench_requested;
+
+    bench_requested = CONSOLE_BENCH_NONE;
+    return requested;
+}
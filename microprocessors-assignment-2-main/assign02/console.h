@@ -0,0 +1,58 @@
+#ifndef ASSIGN02_CONSOLE_H
+#define ASSIGN02_CONSOLE_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include "keyer.h"
+
+/*
+ * Serial console commands, read without blocking from stdin:
+ *   add <word>     adds a drill word to the runtime dictionary
+ *   del <word>     removes a drill word
+ *   words          lists the uploaded words
+ *   stats          prints the dictionary fill level
+ *   tolerance <n>  accepts answers up to n symbols off (0 for exact answers only)
+ *   seed [hex]     prints the random seed, or restarts the challenges from one
+ *   deck [on|off]  switches between shuffled decks and error-weighted draws
+ *   keyer [off|a|b] [wpm]  keys answers on an iambic paddle (mode A or B) instead of the button
+ *   audio [off|hz] takes answers from a tone on the ADC instead of the button, or prints its CPU use
+ *   bench [led]    sends edge trains through the key input and prints how fast it keeps up,
+ *                  or times LED updates blocking and through the DMA
+ */
+
+enum console_bench
+{
+    CONSOLE_BENCH_NONE,
+    CONSOLE_BENCH_EDGES, // bench
+    CONSOLE_BENCH_LED    // bench led
+};
+
+/*
+ * Processes any characters waiting on the console, returns without waiting for more
+ */
+void console_poll(void);
+
+/*
+ * Returns how many wrong, extra or missing symbols an answer may have and still be accepted
+ */
+unsigned console_tolerance(void);
+
+/*
+ * Returns the paddle keyer mode and speed set with the keyer command
+ */
+enum keyer_mode console_keyer_mode(void);
+unsigned console_keyer_wpm(void);
+
+/*
+ * Returns the tone set with the audio command, 0 while answers come from the button
+ */
+unsigned console_audio_hz(void);
+
+/*
+ * Returns the benchmark the bench command asked for, once, for the main loop to run it
+ */
+enum console_bench console_take_bench(void);
+
+#endif
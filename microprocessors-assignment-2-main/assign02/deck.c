@@ -0,0 +1,127 @@
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include "deck.h"
+#include "rng.h"
+
+#define FEISTEL_ROUNDS 4
+
+/*
+ * Fisher-Yates shuffle. With keep_apart the last card drawn from the old
+ * order does not open the new one.
+ */
+static void shuffle(struct card_deck *deck, bool keep_apart)
+{
+    unsigned last = deck->cards[deck->count - 1];
+
+    for (unsigned i = deck->count - 1; i > 0; i--)
+    {
+        unsigned j = rng_below(i + 1);
+        uint8_t card = deck->cards[i];
+        deck->cards[i] = deck->cards[j];
+        deck->cards[j] = card;
+    }
+    if (keep_apart && deck->count > 1 && deck->cards[0] == last)
+    {
+        unsigned j = 1 + rng_below(deck->count - 1u);
+        deck->cards[0] = deck->cards[j];
+        deck->cards[j] = (uint8_t)last;
+    }
+    deck->next = 0;
+}
+
+/*
+ * A fresh set of round keys makes a new permutation for the next pass
+ */
+static void rekey(struct index_deck *deck)
+{
+    for (int i = 0; i < FEISTEL_ROUNDS; i++)
+    {
+        deck->keys[i] = rng_next();
+    }
+    deck->next = 0;
+}
+
+/*
+ * Permutes value within [0, 2^(2 * half_bits))
+ */
+static uint32_t feistel(const struct index_deck *deck, uint32_t value)
+{
+    uint32_t mask = (1u << deck->half_bits) - 1;
+    uint32_t left = value >> deck->half_bits;
+    uint32_t right = value & mask;
+
+    for (int i = 0; i < FEISTEL_ROUNDS; i++)
+    {
+        uint32_t f = (right ^ deck->keys[i]) * 0x9E3779B1u;
+        f ^= f >> 15;
+        uint32_t next = left ^ (f & mask);
+        left = right;
+        right = next;
+    }
+    return (left << deck->half_bits) | right;
+}
+
+void card_deck_init(struct card_deck *deck, unsigned count)
+{
+    if (count > DECK_MAX_CARDS)
+    {
+        count = DECK_MAX_CARDS;
+    }
+    for (unsigned i = 0; i < count; i++)
+    {
+        deck->cards[i] = (uint8_t)i;
+    }
+    deck->count = (uint8_t)count;
+    if (count > 0)
+    {
+        shuffle(deck, false);
+    }
+}
+
+unsigned card_deck_draw(struct card_deck *deck)
+{
+    if (deck->count == 0)
+    {
+        return 0;
+    }
+    if (deck->next >= deck->count)
+    {
+        shuffle(deck, true);
+    }
+    return deck->cards[deck->next++];
+}
+
+void index_deck_init(struct index_deck *deck, uint32_t count)
+{
+    deck->count = count;
+    deck->half_bits = 1;
+    while (deck->half_bits < 16 && ((uint32_t)1 << (2 * deck->half_bits)) < count)
+    {
+        deck->half_bits++;
+    }
+    rekey(deck);
+}
+
+uint32_t index_deck_draw(struct index_deck *deck)
+{
+    uint32_t value;
+
+    if (deck->count == 0)
+    {
+        return 0;
+    }
+    if (deck->next >= deck->count)
+    {
+        rekey(deck);
+    }
+
+    // The range is at most four times count, so this takes four steps on average
+    value = deck->next++;
+    do
+    {
+        value = feistel(deck, value);
+    } while (value >= deck->count);
+    return value;
+}
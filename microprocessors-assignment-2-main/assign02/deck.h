@@ -0,0 +1,55 @@
+#ifndef ASSIGN02_DECK_H
+#define ASSIGN02_DECK_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+
+/*
+ * Shuffled decks: every card is drawn once before any is drawn again.
+ * A card deck holds up to DECK_MAX_CARDS cards and is reshuffled with
+ * Fisher-Yates each time it runs out. An index deck covers any range of
+ * indices (such as the dictionary) without storing them: a keyed Feistel
+ * network permutes the smallest even power-of-two range that holds them
+ * and draws outside the range are walked on until they land inside it.
+ * All randomness comes from rng.h, so decks replay with the seed.
+ */
+#define DECK_MAX_CARDS 64
+
+struct card_deck
+{
+    uint8_t cards[DECK_MAX_CARDS];
+    uint8_t count;  // Cards in the deck
+    uint8_t next;   // Cards already drawn from this shuffle
+};
+
+struct index_deck
+{
+    uint32_t keys[4];   // Feistel round keys, new for each pass
+    uint32_t count;     // Indices in the deck
+    uint32_t next;      // Indices already drawn in this pass
+    uint8_t half_bits;  // Width of each Feistel half
+};
+
+/*
+ * Starts a deck of cards 0 to count - 1
+ */
+void card_deck_init(struct card_deck *deck, unsigned count);
+
+/*
+ * Draws the next card, never the card just drawn when the deck is reshuffled
+ */
+unsigned card_deck_draw(struct card_deck *deck);
+
+/*
+ * Starts a deck of indices 0 to count - 1
+ */
+void index_deck_init(struct index_deck *deck, uint32_t count);
+
+/*
+ * Draws the next index
+ */
+uint32_t index_deck_draw(struct index_deck *deck);
+
+#endif
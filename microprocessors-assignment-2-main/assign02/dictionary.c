@@ -0,0 +1,201 @@
+/*
+ * Import header files
+ */
+#include <ctype.h>
+#include <string.h>
+#include "dictionary.h"
+#include "word_hash.h"
+
+static const uint16_t *section16(const struct dictionary *dict, uint32_t offset)
+{
+    return (const uint16_t *)(dict->base + offset);
+}
+
+/*
+ * Reduces a word hash to one of n slots. The low bits of an FNV-1a hash
+ * only depend on the low bits of its seed, so they are mixed with the high
+ * bits first, or a displacement could not move a word to every slot when n
+ * is a power of two. Must match hash_slot() in tools/mkdict.py.
+ */
+static uint32_t hash_slot(uint32_t hash, uint32_t n)
+{
+    return (hash ^ (hash >> 16)) % n;
+}
+
+/*
+ * First 8 characters of word as a big endian number, so keys order like
+ * the words they came from. Must match search_key() in tools/mkdict.py.
+ */
+static uint64_t search_key(const char *word)
+{
+    uint64_t key = 0;
+
+    for (int i = 0; i < 8; i++)
+    {
+        key <<= 8;
+        if (*word != '\0')
+        {
+            key |= (uint8_t)*word++;
+        }
+    }
+    return key;
+}
+
+/*
+ * Returns the position in block of the first word that sorts at or after
+ * prefix, or the number of words in the block if there is none
+ */
+static size_t block_lower_bound(const struct dictionary *dict, size_t block, const char *prefix)
+{
+    const struct dictionary_header *header = dict->header;
+    const uint32_t *block_index = (const uint32_t *)(dict->base + header->block_index_offset);
+    const uint8_t *p = dict->base + block_index[block];
+    size_t words = header->word_count - block * header->block_size;
+    char word[DICTIONARY_WORD_MAX + 1];
+
+    if (words > header->block_size)
+    {
+        words = header->block_size;
+    }
+    for (size_t i = 0; i < words; i++)
+    {
+        // The first word is stored whole, the rest reuse a prefix of the one before
+        size_t shared = i == 0 ? 0 : *p >> 4;
+        size_t suffix = i == 0 ? *p++ : *p++ & 0x0Fu;
+        memcpy(word + shared, p, suffix);
+        p += suffix;
+        word[shared + suffix] = '\0';
+        if (strcmp(word, prefix) >= 0)
+        {
+            return i;
+        }
+    }
+    return words;
+}
+
+bool dictionary_open(struct dictionary *dict, const void *blob, size_t size)
+{
+    const struct dictionary_header *header = blob;
+
+    if (size < sizeof *header || ((uintptr_t)blob & 7u) != 0 || header->magic != DICTIONARY_MAGIC ||
+        header->version != DICTIONARY_VERSION || header->size > size || header->word_count == 0)
+    {
+        return false;
+    }
+    dict->base = blob;
+    dict->header = header;
+    dict->size = size;
+    return true;
+}
+
+bool dictionary_word(const struct dictionary *dict, size_t index, char word[DICTIONARY_WORD_MAX + 1])
+{
+    const struct dictionary_header *header = dict->header;
+
+    if (index >= header->word_count)
+    {
+        return false;
+    }
+
+    const uint32_t *block_index = (const uint32_t *)(dict->base + header->block_index_offset);
+    const uint8_t *p = dict->base + block_index[index / header->block_size];
+    size_t length = *p++;
+
+    memcpy(word, p, length);
+    p += length;
+
+    // Each following word reuses a prefix of the one before it
+    for (size_t i = index % header->block_size; i > 0; i--)
+    {
+        size_t prefix = *p >> 4;
+        size_t suffix = *p++ & 0x0Fu;
+        memcpy(word + prefix, p, suffix);
+        p += suffix;
+        length = prefix + suffix;
+    }
+    word[length] = '\0';
+    return true;
+}
+
+int dictionary_lookup(const struct dictionary *dict, const char *word)
+{
+    const struct dictionary_header *header = dict->header;
+    char key[DICTIONARY_WORD_MAX + 1];
+    char stored[DICTIONARY_WORD_MAX + 1];
+    size_t length = strlen(word);
+
+    if (length == 0 || length > DICTIONARY_WORD_MAX)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i <= length; i++)
+    {
+        key[i] = (char)tolower((unsigned char)word[i]);
+    }
+
+    uint32_t bucket = hash_slot(word_hash(key, 0), header->hash_buckets);
+    uint32_t displacement = section16(dict, header->hash_displacement_offset)[bucket];
+    uint32_t slot = hash_slot(word_hash(key, displacement), header->word_count);
+    size_t index = section16(dict, header->hash_slot_offset)[slot];
+
+    // Words that are not in the dictionary still land on some slot
+    dictionary_word(dict, index, stored);
+    return strcmp(stored, key) == 0 ? (int)index : -1;
+}
+
+size_t dictionary_duration_range(const struct dictionary *dict, unsigned min_units, unsigned max_units,
+                                 size_t *first)
+{
+    const struct dictionary_header *header = dict->header;
+    const uint16_t *starts = section16(dict, header->duration_start_offset);
+
+    if (max_units > header->max_duration)
+    {
+        max_units = header->max_duration;
+    }
+    if (min_units > max_units)
+    {
+        *first = 0;
+        return 0;
+    }
+    *first = starts[min_units];
+    return starts[max_units + 1] - starts[min_units];
+}
+
+size_t dictionary_duration_word(const struct dictionary *dict, size_t position)
+{
+    return section16(dict, dict->header->duration_word_offset)[position];
+}
+
+size_t dictionary_lower_bound(const struct dictionary *dict, const char *prefix)
+{
+    const struct dictionary_header *header = dict->header;
+    const uint64_t *keys = (const uint64_t *)(dict->base + header->search_key_offset);
+    uint64_t target = search_key(prefix);
+    size_t k = 1;
+
+    // Eytzinger search for the first block whose key is above target: the
+    // next node is always at 2k or 2k + 1, so the top levels share cache lines
+    while (k <= header->block_count)
+    {
+        k = 2 * k + (keys[k] <= target);
+    }
+    // Undo the right turns taken after the last left one
+    k >>= __builtin_ffs((int)~k);
+
+    size_t block = k != 0 ? section16(dict, header->search_block_offset)[k] : header->block_count;
+    if (block == 0)
+    {
+        return 0;
+    }
+    block--;
+
+    // Blocks can share their first 8 characters, so step back until the
+    // block starts before prefix
+    while (block > 0 && block_lower_bound(dict, block, prefix) == 0)
+    {
+        block--;
+    }
+
+    return block * header->block_size + block_lower_bound(dict, block, prefix);
+}
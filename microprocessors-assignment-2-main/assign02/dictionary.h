@@ -0,0 +1,140 @@
+#ifndef ASSIGN02_DICTIONARY_H
+#define ASSIGN02_DICTIONARY_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "morse.h"
+
+/*
+ * Compressed word dictionary built by tools/mkdict.py.
+ * The blob is used where it lies (linked into flash on the Pico, mmap()ed
+ * on a host): opening it only checks the header, and every query reads at
+ * most one front-coded block into a caller's buffer, so RAM use does not
+ * depend on the word count. The code, duration and frequency rank of each
+ * word are precomputed by the builder.
+ */
+#define DICTIONARY_MAGIC 0x4349444Du // "MDIC"
+#define DICTIONARY_VERSION 3u
+#define DICTIONARY_WORD_MAX MORSE_WORD_MAX_LETTERS
+
+struct dictionary_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t word_count;
+    uint32_t block_size;               // Words per front-coded block
+    uint32_t block_count;
+    uint32_t block_index_offset;       // uint32_t[block_count + 1]
+    uint32_t hash_buckets;
+    uint32_t hash_displacement_offset; // uint16_t[hash_buckets]
+    uint32_t hash_slot_offset;         // uint16_t[word_count]
+    uint32_t max_duration;             // Longest word in dot units
+    uint32_t duration_start_offset;    // uint16_t[max_duration + 2]
+    uint32_t duration_word_offset;     // uint16_t[word_count]
+    uint32_t morse_offset;             // morse_word_t[word_count]
+    uint32_t unit_offset;              // uint8_t[word_count], duration in dot units
+    uint32_t rank_offset;              // uint16_t[word_count], most frequent first
+    uint32_t search_key_offset;        // uint64_t[block_count + 1], Eytzinger order from index 1
+    uint32_t search_block_offset;      // uint16_t[block_count + 1]
+    uint32_t match_key_offset;         // morse_word_t[word_count], aligned at the first letter
+    uint32_t size;                     // Size of the whole blob in bytes
+};
+
+/*
+ * View of an open dictionary blob
+ */
+struct dictionary
+{
+    const uint8_t *base;
+    const struct dictionary_header *header;
+    size_t size; // Bytes given to dictionary_open(), which may run past header->size
+};
+
+/*
+ * Dictionary built into the firmware from words.txt (dictionary_blob.S)
+ */
+extern const uint64_t dictionary_blob[];
+extern const size_t dictionary_blob_size;
+
+/*
+ * Opens the dictionary blob of size bytes, which must be 8-byte aligned.
+ * Returns false if it is not a dictionary this code can read.
+ */
+bool dictionary_open(struct dictionary *dict, const void *blob, size_t size);
+
+/*
+ * Returns the number of words in the dictionary
+ */
+static inline size_t dictionary_count(const struct dictionary *dict)
+{
+    return dict->header->word_count;
+}
+
+/*
+ * Copies word index (in sorted order) into word. Returns false if index is out of range.
+ */
+bool dictionary_word(const struct dictionary *dict, size_t index, char word[DICTIONARY_WORD_MAX + 1]);
+
+/*
+ * Returns the index of word, or -1 if it is not in the dictionary
+ */
+int dictionary_lookup(const struct dictionary *dict, const char *word);
+
+/*
+ * Returns the index of the first word that sorts at or after prefix
+ * (dictionary_count() if there is none), so the words starting with a
+ * prefix are the range from its lower bound to that of the next prefix.
+ */
+size_t dictionary_lower_bound(const struct dictionary *dict, const char *prefix);
+
+/*
+ * Returns the packed morse code of word index
+ */
+static inline morse_word_t dictionary_morse(const struct dictionary *dict, size_t index)
+{
+    return ((const morse_word_t *)(dict->base + dict->header->morse_offset))[index];
+}
+
+/*
+ * Returns how long word index lasts in dot units
+ */
+static inline unsigned dictionary_units(const struct dictionary *dict, size_t index)
+{
+    return (dict->base + dict->header->unit_offset)[index];
+}
+
+/*
+ * Returns the codes of all words in index order, aligned at their first
+ * letter (see morse_batch_word_key()) for morse_batch_match_words()
+ */
+static inline const morse_word_t *dictionary_match_keys(const struct dictionary *dict)
+{
+    return (const morse_word_t *)(dict->base + dict->header->match_key_offset);
+}
+
+/*
+ * Returns the index of the word with frequency rank rank (0 is the most frequent)
+ */
+static inline size_t dictionary_ranked(const struct dictionary *dict, size_t rank)
+{
+    return ((const uint16_t *)(dict->base + dict->header->rank_offset))[rank];
+}
+
+/*
+ * Finds the words whose morse code lasts min_units to max_units dot units.
+ * Returns how many there are and sets first to the position of the first
+ * one for dictionary_duration_word().
+ */
+size_t dictionary_duration_range(const struct dictionary *dict, unsigned min_units, unsigned max_units,
+                                 size_t *first);
+
+/*
+ * Returns the index of the word at position in duration order
+ */
+size_t dictionary_duration_word(const struct dictionary *dict, size_t position);
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * Import header files
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "dictionary_mmap.h"
+
+bool dictionary_map(struct dictionary *dict, const char *path)
+{
+    struct stat status;
+    void *blob;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (fstat(fd, &status) != 0 || status.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    blob = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (blob == MAP_FAILED)
+    {
+        return false;
+    }
+
+    // Mappings are page aligned, which covers the 8-byte alignment the sections need
+    if (!dictionary_open(dict, blob, (size_t)status.st_size))
+    {
+        munmap(blob, (size_t)status.st_size);
+        return false;
+    }
+    return true;
+}
+
+void dictionary_unmap(struct dictionary *dict)
+{
+    // The whole file was mapped, trailing bytes after the blob included
+    munmap((void *)dict->base, dict->size);
+    dict->base = NULL;
+    dict->header = NULL;
+    dict->size = 0;
+}
@@ -0,0 +1,28 @@
+#ifndef ASSIGN02_DICTIONARY_MMAP_H
+#define ASSIGN02_DICTIONARY_MMAP_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include "dictionary.h"
+
+/*
+ * Host builds only (POSIX): maps a dictionary file written by
+ * tools/mkdict.py read-only and opens it in place. Nothing is parsed or
+ * copied, so opening takes the same time for any word count and pages are
+ * only read from disk when a query touches them.
+ */
+
+/*
+ * Maps and opens the dictionary at path. Returns false if the file cannot
+ * be mapped or is not a dictionary this code can read.
+ */
+bool dictionary_map(struct dictionary *dict, const char *path);
+
+/*
+ * Unmaps a dictionary opened with dictionary_map()
+ */
+void dictionary_unmap(struct dictionary *dict);
+
+#endif
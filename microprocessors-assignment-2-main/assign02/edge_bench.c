@@ -0,0 +1,146 @@
+/*
+ * Import header files
+ */
+#include <stdio.h>
+#include "edge_bench.h"
+
+#define EDGE_BENCH_EXACT 16   // Latencies below this have a bucket each
+#define EDGE_BENCH_STEP_BITS 3 // 8 buckets an octave above that
+
+_Static_assert(EDGE_BENCH_EXACT + (32 - 4) * (1 << EDGE_BENCH_STEP_BITS) == EDGE_BENCH_BUCKETS,
+               "EDGE_BENCH_BUCKETS covers every 32-bit latency");
+
+const uint32_t edge_bench_rates[EDGE_BENCH_RATES] = {1000,  2000,   5000,   10000,  20000,
+                                                     50000, 100000, 200000, 500000, 1000000};
+
+static unsigned bucket(uint32_t us)
+{
+    unsigned octave = 31;
+
+    if (us < EDGE_BENCH_EXACT)
+    {
+        return us;
+    }
+    while ((us >> octave) == 0)
+    {
+        octave--;
+    }
+    // octave is 4 or more here, the three bits after the leading one pick the step
+    return EDGE_BENCH_EXACT + (octave - 4) * (1u << EDGE_BENCH_STEP_BITS) +
+           ((us >> (octave - EDGE_BENCH_STEP_BITS)) & ((1u << EDGE_BENCH_STEP_BITS) - 1));
+}
+
+// Largest latency that falls in bucket index
+static uint32_t bucket_top(unsigned index)
+{
+    unsigned octave;
+    unsigned step;
+
+    if (index < EDGE_BENCH_EXACT)
+    {
+        return index;
+    }
+    octave = 4 + (index - EDGE_BENCH_EXACT) / (1u << EDGE_BENCH_STEP_BITS);
+    step = (index - EDGE_BENCH_EXACT) % (1u << EDGE_BENCH_STEP_BITS);
+    return (uint32_t)((((uint64_t)(1u << EDGE_BENCH_STEP_BITS) + step + 1) << (octave - EDGE_BENCH_STEP_BITS)) - 1);
+}
+
+void edge_bench_start(struct edge_bench *bench, unsigned channel, uint64_t now)
+{
+    for (int i = 0; i < EDGE_BENCH_BUCKETS; i++)
+    {
+        bench->histogram[i] = 0;
+    }
+    bench->received = 0;
+    bench->disorder = 0;
+    bench->max_us = 0;
+    bench->last_us = 0;
+    bench->channel = (uint8_t)channel;
+    bench->expected = EDGE_PRESSED;
+    session_init(&bench->session, EDGE_BENCH_WPM);
+    session_start(&bench->session, MORSE_WORD_EMPTY, NULL, now, false);
+}
+
+void edge_bench_edge(struct edge_bench *bench, const struct edge_event *edge, uint64_t now)
+{
+    uint64_t elapsed = now > edge->time_us ? now - edge->time_us : 0;
+    uint32_t latency = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+
+    // The answer fills up long before a train ends, keep it open so every edge costs what a keyed one does
+    if (bench->session.input.complete)
+    {
+        session_start(&bench->session, MORSE_WORD_EMPTY, NULL, now, false);
+    }
+    session_edge(&bench->session, edge);
+    session_expire(&bench->session, now);
+
+    if (edge->channel != bench->channel || edge->type != bench->expected || edge->time_us < bench->last_us)
+    {
+        bench->disorder++;
+    }
+    bench->expected = edge->type == EDGE_PRESSED ? EDGE_RELEASED : EDGE_PRESSED;
+    bench->last_us = edge->time_us;
+    bench->histogram[bucket(latency)]++;
+    if (latency > bench->max_us)
+    {
+        bench->max_us = latency;
+    }
+    bench->received++;
+}
+
+uint32_t edge_bench_percentile(const struct edge_bench *bench, unsigned permille)
+{
+    // Rounded up, so the 99.9th percentile of a short train takes in its slowest edge
+    uint32_t rank = (uint32_t)(((uint64_t)bench->received * permille + 999) / 1000);
+    uint32_t seen = 0;
+
+    if (bench->received == 0)
+    {
+        return 0;
+    }
+    for (unsigned i = 0; i < EDGE_BENCH_BUCKETS; i++)
+    {
+        seen += bench->histogram[i];
+        if (seen >= rank && seen > 0)
+        {
+            // The bucket can reach past the slowest edge there was
+            return bucket_top(i) < bench->max_us ? bucket_top(i) : bench->max_us;
+        }
+    }
+    return UINT32_MAX;
+}
+
+void edge_bench_finish(const struct edge_bench *bench, uint32_t rate, uint32_t sent, uint32_t ring_full,
+                       struct edge_bench_result *result)
+{
+    uint32_t lost = sent > bench->received ? sent - bench->received : 0;
+
+    result->rate = rate;
+    result->sent = sent;
+    result->received = bench->received;
+    result->ring_full = ring_full;
+    result->merged = lost > ring_full ? lost - ring_full : 0;
+    result->disorder = bench->disorder;
+    result->p50_us = edge_bench_percentile(bench, 500);
+    result->p99_us = edge_bench_percentile(bench, 990);
+    result->p999_us = edge_bench_percentile(bench, 999);
+    result->max_us = bench->max_us;
+}
+
+bool edge_bench_sustained(const struct edge_bench_result *result)
+{
+    return result->received == result->sent && result->disorder == 0;
+}
+
+void edge_bench_print(const struct edge_bench_result *result, bool header)
+{
+    if (header)
+    {
+        printf("  edges/s   sent  recvd  ring full  merged  disorder   p50 us   p99 us p99.9 us   max us\n");
+    }
+    printf("%9lu %6lu %6lu %10lu %7lu %9lu %8lu %8lu %8lu %8lu%s\n", (unsigned long)result->rate,
+           (unsigned long)result->sent, (unsigned long)result->received, (unsigned long)result->ring_full,
+           (unsigned long)result->merged, (unsigned long)result->disorder, (unsigned long)result->p50_us,
+           (unsigned long)result->p99_us, (unsigned long)result->p999_us, (unsigned long)result->max_us,
+           edge_bench_sustained(result) ? "" : "  dropped");
+}
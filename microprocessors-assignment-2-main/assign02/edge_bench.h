@@ -0,0 +1,94 @@
+#ifndef ASSIGN02_EDGE_BENCH_H
+#define ASSIGN02_EDGE_BENCH_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "edge_ring.h"
+#include "session.h"
+
+/*
+ * Edge-storm benchmark for the key input path: trains of edges at rising
+ * rates go through the capture (gpio_isr and button_edges) and the same
+ * classification the game uses (session_edge()), to find the highest rate
+ * the path keeps up with. Bounce on a worn key comes as bursts like these.
+ *
+ * This side only consumes and accounts: it classifies each edge as it is
+ * read, records the time from the capture timestamp to then, and checks
+ * the train arrives whole and in order. Where the edges come from is up to
+ * the caller: on the board a PIO state machine toggling a loopback pin
+ * (edge_storm in assign02.pio), on a host the simulated GPIO in
+ * gpio_model.c. No board figures have been measured yet.
+ *
+ * Latencies go into a histogram exact to 1 us below 16 us and with 8 steps
+ * an octave above, so percentiles are within 12.5%.
+ */
+
+#define EDGE_BENCH_RATES 10     // Rates tried, see edge_bench_rates
+#define EDGE_BENCH_EDGES 2000   // Edges in each train, press and release alternately starting with a press
+#define EDGE_BENCH_BUCKETS 240  // Latency histogram
+#define EDGE_BENCH_WPM 20       // Speed the classifying session starts from
+
+extern const uint32_t edge_bench_rates[EDGE_BENCH_RATES]; // Edges a second, lowest first
+
+struct edge_bench
+{
+    struct session session;                  // Classifies the train like a key's answer
+    uint32_t histogram[EDGE_BENCH_BUCKETS];  // Capture to classification, by bucket
+    uint32_t received;                       // Edges read from the ring
+    uint32_t disorder;                       // Edges of the wrong channel or type, or earlier than the last
+    uint32_t max_us;                         // Slowest edge, exactly
+    uint64_t last_us;
+    uint8_t channel;                         // Channel the train is keyed on
+    uint8_t expected;                        // enum edge_type of the next edge
+};
+
+struct edge_bench_result
+{
+    uint32_t rate;       // Edges a second, as sent
+    uint32_t sent;
+    uint32_t received;
+    uint32_t ring_full;  // Lost because button_edges was full
+    uint32_t merged;     // Lost before they were queued: an edge came again before the interrupt took it
+    uint32_t disorder;
+    uint32_t p50_us;     // Latency percentiles
+    uint32_t p99_us;
+    uint32_t p999_us;
+    uint32_t max_us;
+};
+
+/*
+ * Starts a train on channel: clears the counts and starts the session
+ */
+void edge_bench_start(struct edge_bench *bench, unsigned channel, uint64_t now);
+
+/*
+ * Classifies one edge read from the ring at now and records it
+ */
+void edge_bench_edge(struct edge_bench *bench, const struct edge_event *edge, uint64_t now);
+
+/*
+ * Works out the result of a train of sent edges, ring_full of them dropped by the ring
+ */
+void edge_bench_finish(const struct edge_bench *bench, uint32_t rate, uint32_t sent, uint32_t ring_full,
+                       struct edge_bench_result *result);
+
+/*
+ * Returns the latency below which permille thousandths of the edges were
+ * read (the top of its histogram bucket)
+ */
+uint32_t edge_bench_percentile(const struct edge_bench *bench, unsigned permille);
+
+/*
+ * Returns true if every edge of the train came through, in order
+ */
+bool edge_bench_sustained(const struct edge_bench_result *result);
+
+/*
+ * Prints one train's result as a table row, and the header before the first
+ */
+void edge_bench_print(const struct edge_bench_result *result, bool header);
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef ASSIGN02_EDGE_RING_H
+#define ASSIGN02_EDGE_RING_H
+
+/*
+ * Import header files
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Single-producer, single-consumer ring of key edges. The GPIO
+ * interrupt is the only producer and the main loop the only consumer, so
+ * each side owns one index and no lock or interrupt masking is needed: the
+ * producer publishes a record with a release store of head, the consumer
+ * frees it with a release store of tail. Only 32-bit atomic loads and
+ * stores are used, which the Cortex-M0+ does without LDREX/STREX.
+ *
+ * In the firmware the producer is the push_edge macro in assign02.S, which
+ * does what edge_ring_push() does; the layout is fixed to match it.
+ */
+
+#define EDGE_RING_SIZE 128u // Records, a power of two, enough for every key at once
+
+enum edge_type
+{
+    EDGE_PRESSED,  // Falling edge, the key went down
+    EDGE_RELEASED, // Rising edge, the key came up
+};
+
+struct edge_event
+{
+    uint64_t time_us; // Timer count when the edge was seen
+    uint8_t type;     // enum edge_type
+    uint8_t channel;  // Which key, see keys.h
+};
+
+struct edge_ring
+{
+    _Atomic uint32_t head;       // Written by the producer only
+    _Atomic uint32_t tail;       // Written by the consumer only
+    _Atomic uint32_t dropped;    // Edges lost because the ring was full, written by the producer only
+    uint32_t high_water;         // Most records ever waiting, written by the consumer only
+    struct edge_event events[EDGE_RING_SIZE];
+};
+
+/*
+ * Empties the ring and its counters, only while neither side is running
+ */
+void edge_ring_init(struct edge_ring *ring);
+
+/*
+ * Producer side: adds an edge, or counts it as dropped if the ring is full
+ * Returns false if the edge was dropped
+ */
+bool edge_ring_push(struct edge_ring *ring, unsigned channel, enum edge_type type, uint64_t time_us);
+
+/*
+ * Consumer side: takes the oldest edge into event
+ * Returns false if the ring is empty
+ */
+bool edge_ring_pop(struct edge_ring *ring, struct edge_event *event);
+
+/*
+ * Consumer side: throws away every edge waiting in the ring
+ */
+void edge_ring_discard(struct edge_ring *ring);
+
+/*
+ * Returns how many edges have been dropped since edge_ring_init()
+ */
+static inline uint32_t edge_ring_dropped(struct edge_ring *ring)
+{
+    return atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,29 @@
+/*
+ * Import header files
+ */
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "assign02.pio.h"
+#include "edge_storm.h"
+
+static PIO storm_pio;
+static uint storm_sm;
+
+void edge_storm_init(PIO pio, uint pin)
+{
+    uint offset = pio_add_program(pio, &edge_storm_program);
+
+    storm_pio = pio;
+    storm_sm = (uint)pio_claim_unused_sm(pio, true);
+    edge_storm_program_init(pio, storm_sm, offset, pin);
+}
+
+uint32_t edge_storm_send(uint32_t rate, uint32_t edges)
+{
+    uint32_t half = clock_get_hz(clk_sys) / rate;
+
+    half = half > EDGE_STORM_MIN_HALF_CYCLES ? half : EDGE_STORM_MIN_HALF_CYCLES;
+    pio_sm_put_blocking(storm_pio, storm_sm, edges / 2 - 1);
+    pio_sm_put_blocking(storm_pio, storm_sm, half - EDGE_STORM_OVERHEAD_CYCLES);
+    return clock_get_hz(clk_sys) / half;
+}
@@ -0,0 +1,31 @@
+#ifndef ASSIGN02_EDGE_STORM_H
+#define ASSIGN02_EDGE_STORM_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+#include "hardware/pio.h"
+
+/*
+ * Edge trains for the input benchmark (edge_bench.h) on the board: the
+ * edge_storm PIO program (in assign02.pio) toggles a pin at a set rate, and
+ * with that pin mapped as a key gpio_isr takes its edges like a key's. The
+ * pin is driven from then on, so it must not be wired to anything.
+ */
+
+#define EDGE_STORM_MIN_HALF_CYCLES 4 // Fastest the program toggles: a half period of 4 cycles
+
+/*
+ * Loads the program onto a free state machine of pio and drives pin high (released)
+ */
+void edge_storm_init(PIO pio, uint pin);
+
+/*
+ * Starts a train of edges (an even number, a press first) at rate edges a
+ * second, and returns immediately. Returns the rate the program gets
+ * closest to, which the train runs at.
+ */
+uint32_t edge_storm_send(uint32_t rate, uint32_t edges);
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * Import header files
+ */
+#include "gpio_model.h"
+
+// From the estimated cycle counts in assign02.S, not measured: exception entry (15) and gpio_isr up to reading INTR0 (22)
+#define GPIO_MODEL_ENTRY_CYCLES 37
+// The rest of gpio_isr with one edge (135 - 22) and the exception return (15)
+#define GPIO_MODEL_ISR_CYCLES 128
+#define GPIO_MODEL_EXTRA_EDGE_CYCLES 47
+#define GPIO_MODEL_PAIR_CYCLES 22 // Both edges of the pin pending, reading its level
+#define GPIO_MODEL_START_NS 1000000u // First edge, clear of time 0
+#define GPIO_MODEL_NEVER UINT64_MAX
+
+enum isr_state
+{
+    ISR_IDLE,
+    ISR_ENTERING, // Taken, INTR not read yet
+    ISR_RUNNING   // INTR read, queueing
+};
+
+void gpio_model_isr_cost(struct gpio_model_cost *cost, uint32_t sys_hz)
+{
+    cost->entry_ns = (uint32_t)(GPIO_MODEL_ENTRY_CYCLES * 1000000000ull / sys_hz);
+    cost->isr_ns = (uint32_t)(GPIO_MODEL_ISR_CYCLES * 1000000000ull / sys_hz);
+    cost->extra_edge_ns = (uint32_t)(GPIO_MODEL_EXTRA_EDGE_CYCLES * 1000000000ull / sys_hz);
+    cost->pair_ns = (uint32_t)(GPIO_MODEL_PAIR_CYCLES * 1000000000ull / sys_hz);
+    cost->consume_ns = 0;
+}
+
+void gpio_model_storm(const struct gpio_model_cost *cost, uint32_t rate, unsigned channel, struct edge_ring *ring,
+                      struct edge_bench *bench, struct edge_bench_result *result)
+{
+    enum isr_state isr = ISR_IDLE;
+    bool pending[2] = {false, false}; // INTR edge low and edge high, by enum edge_type
+    uint64_t now = 0;
+    uint64_t isr_at = 0;              // When the ISR reads INTR, or returns
+    uint64_t consume_left = 0;        // CPU time the main loop still needs for the edge it has
+    bool consuming = false;
+    struct edge_event edge;
+    uint32_t sent = 0;
+    uint32_t dropped = edge_ring_dropped(ring);
+
+    edge_bench_start(bench, channel, GPIO_MODEL_START_NS / 1000);
+    while (1)
+    {
+        uint64_t edge_at = sent < EDGE_BENCH_EDGES ? GPIO_MODEL_START_NS + sent * 1000000000ull / rate
+                                                   : GPIO_MODEL_NEVER;
+        uint64_t isr_next = isr != ISR_IDLE ? isr_at : GPIO_MODEL_NEVER;
+        // The main loop only runs while the interrupt does not
+        uint64_t consume_at = consuming && isr == ISR_IDLE ? now + consume_left : GPIO_MODEL_NEVER;
+        uint64_t next = edge_at;
+
+        if (isr_next < next)
+        {
+            next = isr_next;
+        }
+        if (consume_at < next)
+        {
+            next = consume_at;
+        }
+        if (next == GPIO_MODEL_NEVER)
+        {
+            break;
+        }
+        if (consuming && isr == ISR_IDLE)
+        {
+            consume_left -= next - now;
+        }
+        now = next;
+
+        // On a tie the pin changes first, so the ISR sees it
+        if (now == edge_at)
+        {
+            pending[sent % 2 == 0 ? EDGE_PRESSED : EDGE_RELEASED] = true; // Lost if it was already set
+            sent++;
+            if (isr == ISR_IDLE)
+            {
+                isr = ISR_ENTERING;
+                isr_at = now + cost->entry_ns;
+            }
+        }
+        else if (now == isr_next && isr == ISR_ENTERING)
+        {
+            unsigned queued = 0;
+            // With both pending the pin's level says which came last: low again after an odd number of edges
+            bool pair = pending[EDGE_PRESSED] && pending[EDGE_RELEASED];
+            int first = pair && sent % 2 == 1 ? EDGE_RELEASED : EDGE_PRESSED;
+
+            for (int type = first, i = 0; i < 2; type ^= 1, i++)
+            {
+                if (pending[type])
+                {
+                    pending[type] = false;
+                    edge_ring_push(ring, channel, (enum edge_type)type, now / 1000);
+                    queued++;
+                }
+            }
+            isr = ISR_RUNNING;
+            isr_at = now + cost->isr_ns + (queued > 1 ? (queued - 1) * cost->extra_edge_ns : 0) +
+                     (pair ? cost->pair_ns : 0);
+        }
+        else if (now == isr_next)
+        {
+            // Edges that came while it ran take it again at once
+            if (pending[EDGE_PRESSED] || pending[EDGE_RELEASED])
+            {
+                isr = ISR_ENTERING;
+                isr_at = now + cost->entry_ns;
+            }
+            else
+            {
+                isr = ISR_IDLE;
+            }
+        }
+        else
+        {
+            consuming = false;
+            edge_bench_edge(bench, &edge, now / 1000);
+        }
+
+        if (!consuming && isr == ISR_IDLE && edge_ring_pop(ring, &edge))
+        {
+            consuming = true;
+            consume_left = cost->consume_ns;
+        }
+    }
+    edge_bench_finish(bench, rate, sent, edge_ring_dropped(ring) - dropped, result);
+}
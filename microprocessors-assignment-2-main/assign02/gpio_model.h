@@ -0,0 +1,55 @@
+#ifndef ASSIGN02_GPIO_MODEL_H
+#define ASSIGN02_GPIO_MODEL_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+#include "edge_bench.h"
+#include "edge_ring.h"
+
+/*
+ * Simulated GPIO for running the edge-storm benchmark (edge_bench.h) on a
+ * host. A key pin toggles at a fixed rate, and its edges latch in the two
+ * IO_BANK0 INTR bits for a pin (edge low, edge high). An edge that comes
+ * again while its bit is still set is lost, as on the chip. gpio_isr is
+ * modelled by its timing:
+ * - it reads INTR entry_ns after a bit is set, or after the last pass ends;
+ * - it queues the edges it finds into a real edge_ring, lowest bit first
+ *   unless both are pending and the pin is low again (keys_next_edge());
+ * - it holds the CPU for isr_ns, plus extra_edge_ns for each further edge.
+ * The main loop takes the edges out and runs them through edge_bench_edge(),
+ * needing consume_ns of CPU time each. The interrupt stops it meanwhile.
+ *
+ * Time is virtual nanoseconds, so the run does not depend on the host's
+ * speed. The costs have to come from the target: the cycle counts in
+ * assign02.S give the interrupt's, the board benchmark the main loop's.
+ * Those cycle counts are estimates and the board benchmark has not been
+ * run yet, so the rates this model gives are unmeasured predictions.
+ * tests/test_edge_bench.c checks the model, tests/bench_edge_storm.c runs
+ * it with the host's main loop cost.
+ */
+
+struct gpio_model_cost
+{
+    uint32_t entry_ns;       // From an INTR bit being set (or the last pass ending) to gpio_isr reading INTR
+    uint32_t isr_ns;         // From reading INTR to returning, with one edge
+    uint32_t extra_edge_ns;  // For each further edge in the same pass
+    uint32_t pair_ns;        // Once when both edges are pending, to order them by the pin's level
+    uint32_t consume_ns;     // Main loop time to read and classify one edge
+};
+
+/*
+ * Fills in the interrupt costs from the estimated cycle counts in assign02.S at
+ * sys_hz, leaving consume_ns at 0 for the caller
+ */
+void gpio_model_isr_cost(struct gpio_model_cost *cost, uint32_t sys_hz);
+
+/*
+ * Sends a train of edges, edges a second, on channel
+ * through the model and fills in result
+ */
+void gpio_model_storm(const struct gpio_model_cost *cost, uint32_t rate, unsigned channel, struct edge_ring *ring,
+                      struct edge_bench *bench, struct edge_bench_result *result);
+
+#endif
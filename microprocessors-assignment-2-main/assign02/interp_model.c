@@ -0,0 +1,72 @@
+/*
+ * Import header files
+ */
+#include "interp_model.h"
+
+struct lane_outputs
+{
+    uint32_t masked[2];  // Shifted, masked and sign extended inputs
+    uint32_t result[3];  // LANE0, LANE1 and FULL results on the internal datapath
+};
+
+static void evaluate(const struct interp_model *interp, struct lane_outputs *out)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        const struct interp_model_lane *lane = &interp->lane[i];
+        uint32_t input = interp->accum[lane->cross_input ? 1 - i : i];
+        uint32_t mask = (lane->mask_msb >= 31 ? UINT32_MAX : ((uint32_t)2 << lane->mask_msb) - 1) &
+                        (UINT32_MAX << lane->mask_lsb);
+        uint32_t masked = (input >> lane->shift) & mask;
+
+        if (lane->is_signed && lane->mask_msb < 31 && (masked >> lane->mask_msb) & 1u)
+        {
+            masked |= UINT32_MAX << (lane->mask_msb + 1);
+        }
+        out->masked[i] = masked;
+        out->result[i] = interp->base[i] + (lane->add_raw ? input : masked);
+    }
+    out->result[2] = interp->base[2] + out->masked[0] + out->masked[1];
+}
+
+/*
+ * The value as the processor sees it on the bus
+ */
+static uint32_t presented(const struct interp_model *interp, const struct lane_outputs *out, int lane)
+{
+    if (lane < 2)
+    {
+        return out->result[lane] | ((uint32_t)interp->lane[lane].force_msb << 28);
+    }
+    return out->result[2];
+}
+
+struct interp_model_lane interp_model_default_lane(void)
+{
+    struct interp_model_lane lane = {0};
+
+    lane.mask_msb = 31;
+    return lane;
+}
+
+uint32_t interp_model_peek(const struct interp_model *interp, int lane)
+{
+    struct lane_outputs out;
+
+    evaluate(interp, &out);
+    return presented(interp, &out, lane);
+}
+
+uint32_t interp_model_pop(struct interp_model *interp, int lane)
+{
+    struct lane_outputs out;
+    uint32_t value;
+
+    evaluate(interp, &out);
+    value = presented(interp, &out, lane);
+    for (int i = 0; i < 2; i++)
+    {
+        interp->accum[i] = out.result[interp->lane[i].cross_result ? 1 - i : i];
+    }
+    return value;
+}
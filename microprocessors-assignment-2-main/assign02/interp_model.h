@@ -0,0 +1,54 @@
+#ifndef ASSIGN02_INTERP_MODEL_H
+#define ASSIGN02_INTERP_MODEL_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Software model of one RP2040 SIO interpolator (datasheet section
+ * 2.3.1.6), for checking lane configurations such as those in lookup.c on
+ * a host. It follows the register descriptions bit for bit for shift,
+ * mask, SIGNED, CROSS_INPUT, CROSS_RESULT, ADD_RAW and FORCE_MSB, and the
+ * PEEK/POP reads of LANE0, LANE1 and FULL. Blend mode (interp0) and clamp
+ * mode (interp1) are not modelled.
+ */
+struct interp_model_lane
+{
+    uint8_t shift;      // Logical right shift applied to the input
+    uint8_t mask_lsb;   // Lowest bit kept after the shift
+    uint8_t mask_msb;   // Highest bit kept after the shift
+    bool is_signed;     // Sign extend from mask_msb
+    bool cross_input;   // Take the input from the other lane's accumulator
+    bool cross_result;  // A POP loads the other lane's result into this accumulator
+    bool add_raw;       // Add the unshifted, unmasked input for this lane's result
+    uint8_t force_msb;  // ORed into bits 29:28 of the result as read
+};
+
+struct interp_model
+{
+    uint32_t accum[2];
+    uint32_t base[3];
+    struct interp_model_lane lane[2];
+};
+
+/*
+ * Returns lane config with the SDK defaults (interp_default_config()):
+ * no shift, mask of all 32 bits, everything else off
+ */
+struct interp_model_lane interp_model_default_lane(void);
+
+/*
+ * Reads PEEK_LANE0 (lane 0), PEEK_LANE1 (lane 1) or PEEK_FULL (lane 2)
+ */
+uint32_t interp_model_peek(const struct interp_model *interp, int lane);
+
+/*
+ * Reads POP_LANE0, POP_LANE1 or POP_FULL: the same value as a peek, and
+ * both accumulators are loaded with their next values
+ */
+uint32_t interp_model_pop(struct interp_model *interp, int lane);
+
+#endif
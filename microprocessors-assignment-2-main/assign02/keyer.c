@@ -0,0 +1,125 @@
+/*
+ * Import header files
+ */
+#include "keyer.h"
+#include "keying.h"
+
+void keyer_init(struct keyer *keyer, enum keyer_mode mode, unsigned wpm)
+{
+    *keyer = (struct keyer){.mode = mode, .state = KEYER_IDLE};
+    keyer->unit_us = KEYING_PARIS_US / (wpm != 0 ? wpm : 1);
+}
+
+static void start_element(struct keyer *keyer, bool dash, uint64_t start_us)
+{
+    keyer->state = KEYER_MARK;
+    keyer->dash = dash;
+    keyer->start_us = start_us;
+    keyer->until_us = start_us + (dash ? 3 : 1) * (uint64_t)keyer->unit_us;
+    // Each element answers every press seen before it, the memories start again
+    keyer->dot_memory = false;
+    keyer->dash_memory = false;
+}
+
+// Picks the element to send after the last one, returns false to stop
+static bool choose_next(struct keyer *keyer, bool dot_lever, bool dash_lever, bool *dash)
+{
+    bool opposite_memory = keyer->dash ? keyer->dot_memory : keyer->dash_memory;
+    bool same = keyer->dash ? dash_lever || keyer->dash_memory : dot_lever || keyer->dot_memory;
+    bool opposite = keyer->dash ? dot_lever : dash_lever;
+
+    // Mode A drops whatever a released squeeze left in the memories, a tap's memory is kept
+    if (keyer->mode == KEYER_IAMBIC_A && keyer->squeezed && !dot_lever && !dash_lever)
+    {
+        keyer->dot_memory = false;
+        keyer->dash_memory = false;
+        return false;
+    }
+    // The opposite element goes first, so a squeeze alternates
+    if (opposite_memory || opposite)
+    {
+        *dash = !keyer->dash;
+        return true;
+    }
+    if (same)
+    {
+        *dash = keyer->dash;
+        return true;
+    }
+    return false;
+}
+
+int keyer_update(struct keyer *keyer, uint64_t now, bool dot_lever, bool dash_lever,
+                 struct keyer_element *done, int max)
+{
+    int count = 0;
+    bool dash;
+
+    if (keyer->mode == KEYER_OFF)
+    {
+        return 0;
+    }
+    keyer->squeezed |= dot_lever && dash_lever;
+
+    while (1)
+    {
+        switch (keyer->state)
+        {
+        case KEYER_IDLE:
+            if (!dot_lever && !dash_lever)
+            {
+                return count;
+            }
+            start_element(keyer, !dot_lever, now);
+            break;
+
+        case KEYER_MARK:
+            // Only the other lever is remembered while an element is sent
+            if (keyer->dash ? dot_lever : dash_lever)
+            {
+                *(keyer->dash ? &keyer->dot_memory : &keyer->dash_memory) = true;
+            }
+            if (now < keyer->until_us)
+            {
+                return count;
+            }
+            if (count < max)
+            {
+                done[count++] = (struct keyer_element){.dash = keyer->dash, .start_us = keyer->start_us,
+                                                       .end_us = keyer->until_us};
+            }
+            keyer->state = KEYER_SPACE;
+            keyer->until_us += keyer->unit_us;
+            break;
+
+        case KEYER_SPACE:
+            keyer->dot_memory |= dot_lever;
+            keyer->dash_memory |= dash_lever;
+            if (now < keyer->until_us)
+            {
+                return count;
+            }
+            if (choose_next(keyer, dot_lever, dash_lever, &dash))
+            {
+                start_element(keyer, dash, keyer->until_us);
+            }
+            else
+            {
+                keyer->state = KEYER_IDLE;
+                keyer->squeezed = dot_lever && dash_lever;
+                return count;
+            }
+            break;
+        }
+    }
+}
+
+bool keyer_next(const struct keyer *keyer, uint64_t *deadline)
+{
+    if (keyer->mode == KEYER_OFF || keyer->state == KEYER_IDLE)
+    {
+        return false;
+    }
+    *deadline = keyer->until_us;
+    return true;
+}
@@ -0,0 +1,89 @@
+#ifndef ASSIGN02_KEYER_H
+#define ASSIGN02_KEYER_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Iambic keyer for a dual-lever paddle. Holding the dot lever sends dots,
+ * holding the dash lever sends dashes and squeezing both alternates them,
+ * every element exactly 1 or 3 units long with 1 unit between. A lever
+ * pressed while the other element is being sent is remembered (dot and
+ * dash memory) and its element follows, as is one pressed in the gap
+ * after an element. The modes differ when a squeeze is let go: mode A
+ * stops after the element being sent, mode B sends one more of the
+ * opposite element. A tap's memory is kept in both modes.
+ *
+ * The keyer only runs when keyer_update() is called, with the time and
+ * the lever states then. Element edges fall on the unit grid from the
+ * first press however late the calls are, so the caller only needs to
+ * call it on every lever change and at keyer_next().
+ */
+
+#define KEYER_ELEMENTS_MAX 4 // Elements one keyer_update() call can complete
+
+enum keyer_mode
+{
+    KEYER_OFF,
+    KEYER_IAMBIC_A,
+    KEYER_IAMBIC_B
+};
+
+enum keyer_state
+{
+    KEYER_IDLE,  // Waiting for a lever
+    KEYER_MARK,  // Sending an element
+    KEYER_SPACE  // In the gap after an element
+};
+
+struct keyer_element
+{
+    bool dash;
+    uint64_t start_us;
+    uint64_t end_us;
+};
+
+struct keyer
+{
+    enum keyer_mode mode;
+    enum keyer_state state;
+    uint32_t unit_us;
+    uint64_t until_us;   // End of the current mark or space
+    uint64_t start_us;   // Start of the current mark
+    bool dash;           // Element being sent, or last sent
+    bool dot_memory;
+    bool dash_memory;
+    bool squeezed;       // Both levers have been down together since the keyer was idle
+};
+
+/*
+ * Sets the keyer up idle, sending at wpm (PARIS timing)
+ */
+void keyer_init(struct keyer *keyer, enum keyer_mode mode, unsigned wpm);
+
+/*
+ * Runs the keyer up to now with the levers as they are now. Elements
+ * completed on the way are written to done (up to max), oldest first.
+ * Returns how many were written.
+ */
+int keyer_update(struct keyer *keyer, uint64_t now, bool dot_lever, bool dash_lever,
+                 struct keyer_element *done, int max);
+
+/*
+ * Gives the time keyer_update() must next be called by even if no lever
+ * changes, returns false while the keyer is idle
+ */
+bool keyer_next(const struct keyer *keyer, uint64_t *deadline);
+
+/*
+ * Returns true while an element is being sent
+ */
+static inline bool keyer_key_down(const struct keyer *keyer)
+{
+    return keyer->state == KEYER_MARK;
+}
+
+#endif
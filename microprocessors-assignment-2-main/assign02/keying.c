@@ -0,0 +1,116 @@
+/*
+ * Import header files
+ */
+#include "keying.h"
+
+#define UNIT_MIN_US (KEYING_PARIS_US / KEYING_MAX_WPM)
+#define UNIT_MAX_US (KEYING_PARIS_US / KEYING_MIN_WPM)
+
+struct clusters
+{
+    uint64_t short_sum;
+    uint64_t long_sum;
+    uint8_t short_count;
+    uint8_t long_count;
+};
+
+void keying_init(struct keying *keying, unsigned wpm)
+{
+    *keying = (struct keying){0};
+    keying->unit_us = KEYING_PARIS_US / (wpm != 0 ? wpm : 1);
+}
+
+static void remember(uint32_t *history, uint8_t *count, uint8_t *next, uint32_t width_us)
+{
+    history[*next] = width_us;
+    *next = (uint8_t)((*next + 1) % KEYING_HISTORY);
+    if (*count < KEYING_HISTORY)
+    {
+        (*count)++;
+    }
+}
+
+// Splits widths in two where the between-cluster variance is largest, returns false if they are all alike
+static bool split(const uint32_t *history, unsigned count, struct clusters *out)
+{
+    uint32_t sorted[KEYING_HISTORY];
+    uint64_t prefix[KEYING_HISTORY + 1];
+    uint64_t best_score = 0;
+    unsigned best = 0;
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        unsigned j = i;
+        while (j > 0 && sorted[j - 1] > history[i])
+        {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = history[i];
+    }
+    // Widths from one cluster are well within a factor of 2 of each other, dots and dashes are 3 apart
+    if (count < 2 || sorted[count - 1] < 2 * sorted[0])
+    {
+        return false;
+    }
+
+    prefix[0] = 0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        prefix[i + 1] = prefix[i] + sorted[i];
+    }
+    for (unsigned k = 1; k < count; k++)
+    {
+        // n1 * n2 * (mean2 - mean1)^2 scaled by n1 * n2, which fits 64 bits for widths below 2^25
+        uint64_t difference = (prefix[count] - prefix[k]) * k - prefix[k] * (count - k);
+        uint64_t score = difference * difference / ((uint64_t)k * (count - k));
+
+        if (score > best_score)
+        {
+            best_score = score;
+            best = k;
+        }
+    }
+    out->short_sum = prefix[best];
+    out->short_count = (uint8_t)best;
+    out->long_sum = prefix[count] - prefix[best];
+    out->long_count = (uint8_t)(count - best);
+    return true;
+}
+
+static void set_unit(struct keying *keying, uint64_t unit_us)
+{
+    keying->unit_us = (uint32_t)(unit_us < UNIT_MIN_US ? UNIT_MIN_US : unit_us > UNIT_MAX_US ? UNIT_MAX_US : unit_us);
+}
+
+bool keying_mark(struct keying *keying, uint32_t width_us)
+{
+    struct clusters clusters;
+
+    if (width_us <= KEYING_WIDTH_MAX_US)
+    {
+        remember(keying->marks, &keying->mark_count, &keying->mark_next, width_us);
+        if (split(keying->marks, keying->mark_count, &clusters))
+        {
+            set_unit(keying, (clusters.short_sum + clusters.long_sum / 3) / (clusters.short_count + clusters.long_count));
+        }
+        else if (split(keying->gaps, keying->gap_count, &clusters))
+        {
+            set_unit(keying, clusters.short_sum / clusters.short_count);
+        }
+    }
+    return width_us >= 2 * keying->unit_us;
+}
+
+enum keying_gap keying_gap(struct keying *keying, uint32_t width_us)
+{
+    if (width_us <= KEYING_WIDTH_MAX_US)
+    {
+        remember(keying->gaps, &keying->gap_count, &keying->gap_next, width_us);
+    }
+    if (width_us >= 5 * keying->unit_us)
+    {
+        return KEYING_GAP_WORD;
+    }
+    return width_us >= 2 * keying->unit_us ? KEYING_GAP_LETTER : KEYING_GAP_ELEMENT;
+}
@@ -0,0 +1,71 @@
+#ifndef ASSIGN02_KEYING_H
+#define ASSIGN02_KEYING_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Learns how fast the player keys. The last KEYING_HISTORY presses are
+ * split into a short (dot) and a long (dash) cluster wherever that
+ * separates them best (Otsu's method on the sorted widths), and the dot
+ * unit is taken from both clusters, a dash counting as three units. While
+ * the presses are all alike (only dots or only dashes so far) the short
+ * gaps between elements, one unit each, give the unit instead. Presses
+ * are then dashes from 2 units, gaps between letters from 2 units and
+ * gaps between words from 5 units, halfway between the 1:3:7 spacing.
+ *
+ * Everything is integer arithmetic in microseconds, there is no floating
+ * point on the Cortex-M0+.
+ */
+
+#define KEYING_HISTORY 16               // Presses and gaps kept for learning
+#define KEYING_PARIS_US 1200000u        // A dot lasts 1.2 s / WPM (the PARIS standard)
+#define KEYING_MIN_WPM 3
+#define KEYING_MAX_WPM 60
+#define KEYING_WIDTH_MAX_US 2000000u    // Longer presses and pauses are not learnt from
+
+enum keying_gap
+{
+    KEYING_GAP_ELEMENT, // Between the elements of a letter
+    KEYING_GAP_LETTER,  // Between letters
+    KEYING_GAP_WORD     // Between words
+};
+
+struct keying
+{
+    uint32_t unit_us;                  // Current estimate of one dot
+    uint32_t marks[KEYING_HISTORY];    // Recent press widths, oldest overwritten first
+    uint32_t gaps[KEYING_HISTORY];     // Recent gap widths
+    uint8_t mark_count;
+    uint8_t mark_next;
+    uint8_t gap_count;
+    uint8_t gap_next;
+};
+
+/*
+ * Starts learning from nothing, assuming wpm until the first presses arrive
+ */
+void keying_init(struct keying *keying, unsigned wpm);
+
+/*
+ * Learns from a press and returns true if it was a dash
+ */
+bool keying_mark(struct keying *keying, uint32_t width_us);
+
+/*
+ * Learns from a gap between two presses and returns what kind it was
+ */
+enum keying_gap keying_gap(struct keying *keying, uint32_t width_us);
+
+/*
+ * Returns the estimated speed in words per minute
+ */
+static inline unsigned keying_wpm(const struct keying *keying)
+{
+    return (KEYING_PARIS_US + keying->unit_us / 2) / keying->unit_us;
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * Import header files
+ */
+#include "keys.h"
+#include "edge_ring.h"
+
+#define KEYS_EDGE_LOW 2  // Bit of a pin's four in INTR, a press
+#define KEYS_EDGE_HIGH 3 // A release
+
+// gpio_isr in assign02.S reads the tables with these offsets
+_Static_assert(sizeof key_edge_mask == 4 * KEYS_BANKS, "scan_bank in assign02.S");
+_Static_assert(sizeof key_edge_codes[0] == 32, "KEYS_CODES_SIZE in assign02.S");
+_Static_assert(KEYS_DEBRUIJN == 0x077CB531u, "KEYS_DEBRUIJN in assign02.S");
+_Static_assert(sizeof key_pins[0] == 1, "ldrb of key_pins in scan_bank");
+_Static_assert((KEYS_EDGE_LOW & 1) == EDGE_PRESSED && (KEYS_EDGE_HIGH & 1) == EDGE_RELEASED,
+               "the low bit of the INTR bit number is the edge type");
+
+uint32_t key_edge_mask[KEYS_BANKS];
+uint8_t key_edge_codes[KEYS_BANKS][32];
+uint8_t key_pins[KEYS_MAX];
+
+static unsigned debruijn_index(uint32_t bit)
+{
+    return (bit * KEYS_DEBRUIJN) >> 27;
+}
+
+void keys_clear(void)
+{
+    for (unsigned bank = 0; bank < KEYS_BANKS; bank++)
+    {
+        key_edge_mask[bank] = 0;
+    }
+}
+
+bool keys_add(unsigned channel, unsigned pin)
+{
+    unsigned bank = pin / 8;
+    unsigned shift = (pin % 8) * 4;
+
+    if (channel >= KEYS_MAX || bank >= KEYS_BANKS)
+    {
+        return false;
+    }
+    key_edge_codes[bank][debruijn_index(1u << (shift + KEYS_EDGE_LOW))] = (uint8_t)(channel << 1 | EDGE_PRESSED);
+    key_edge_codes[bank][debruijn_index(1u << (shift + KEYS_EDGE_HIGH))] = (uint8_t)(channel << 1 | EDGE_RELEASED);
+    key_edge_mask[bank] |= 1u << (shift + KEYS_EDGE_LOW) | 1u << (shift + KEYS_EDGE_HIGH);
+    key_pins[channel] = (uint8_t)pin;
+    return true;
+}
+
+int keys_decode(unsigned bank, uint32_t bit)
+{
+    if (bank >= KEYS_BANKS || (key_edge_mask[bank] & bit) == 0)
+    {
+        return -1;
+    }
+    return key_edge_codes[bank][debruijn_index(bit)];
+}
+
+uint32_t keys_next_edge(unsigned bank, uint32_t pending, uint32_t gpio_in)
+{
+    uint32_t bit = pending & (0u - pending);
+
+    // Only a pin's edge low has a key bit above it, its own edge high
+    if ((pending & bit << 1) != 0)
+    {
+        unsigned pin = key_pins[key_edge_codes[bank][debruijn_index(bit)] >> 1];
+        if ((gpio_in >> pin & 1u) == 0)
+        {
+            return bit << 1;
+        }
+    }
+    return bit;
+}
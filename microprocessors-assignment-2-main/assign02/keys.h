@@ -0,0 +1,59 @@
+#ifndef ASSIGN02_KEYS_H
+#define ASSIGN02_KEYS_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Which GPIO edges are keys, for gpio_isr in assign02.S. Each pin has four
+ * bits in the IO_BANK0 INTR registers (level low, level high, edge low,
+ * edge high), eight pins to a register. For every register the ISR masks
+ * the pending bits with key_edge_mask and takes them lowest first,
+ * isolating each with x & -x and numbering it with a de Bruijn multiply,
+ * which indexes key_edge_codes for the channel and edge type. That is the
+ * same handful of instructions for every edge however many keys there are.
+ *
+ * Keys are active low (pressed pulls the pin down), so an edge low is a
+ * press and an edge high a release. Both edges of one pin can be pending
+ * at once: a tap, or a release and a new press, quicker than the interrupt.
+ * The pin's level then says which came last, so the other goes first
+ * (keys_next_edge()).
+ */
+
+#define KEYS_MAX 8           // Channels, one per key
+#define KEYS_BANKS 3         // INTR0-2 cover GP0-GP23, the pins a key can use
+#define KEYS_DEBRUIJN 0x077CB531u
+
+extern uint32_t key_edge_mask[KEYS_BANKS];       // Edge bits of key pins in each INTR register
+extern uint8_t key_edge_codes[KEYS_BANKS][32];   // channel << 1 | enum edge_type, by de Bruijn index
+extern uint8_t key_pins[KEYS_MAX];               // GPIO of each channel's key
+
+/*
+ * Forgets every key
+ */
+void keys_clear(void);
+
+/*
+ * Makes pin the key for channel, only while gpio_isr is not installed
+ * Returns false if the pin or channel is out of range
+ */
+bool keys_add(unsigned channel, unsigned pin);
+
+/*
+ * What gpio_isr does with one pending bit of INTR register bank: gives the
+ * edge's channel << 1 | type, or -1 if the bit is not a key edge
+ */
+int keys_decode(unsigned bank, uint32_t bit);
+
+/*
+ * What gpio_isr does to pick the next of the pending key edges of INTR
+ * register bank (masked with key_edge_mask): the lowest, unless the other
+ * edge of its pin is pending too and the pin is low again (a bit of
+ * gpio_in, SIO GPIO_IN), when the release came first and goes first
+ */
+uint32_t keys_next_edge(unsigned bank, uint32_t pending, uint32_t gpio_in);
+
+#endif
@@ -0,0 +1,179 @@
+/*
+ * Import header files
+ */
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/structs/systick.h"
+#include "led.h"
+
+#define LED_SYSTICK_MAX 0x00FFFFFFu // SysTick counts down 24 bits
+#define LED_SYSTICK_ENABLE 0x5u     // ENABLE, CLKSOURCE the processor clock, no interrupt
+#define LED_NONE 0xFFFFFFFFu         // No colour: the low byte of a shifted colour is always 0
+
+static PIO led_pio;
+static uint led_sm;
+static int channel = -1;
+static uint32_t frame_us;          // Time the bits of one colour take on the line
+static uint32_t frame = LED_NONE;  // Word the DMA reads, the colour going out
+static uint32_t wanted = LED_NONE; // Colour last asked for
+static bool waiting;               // wanted has not gone out yet
+static volatile bool busy;         // The DMA has not finished with frame
+static volatile uint64_t done_us;  // When the DMA last finished
+static struct led_stats stats;
+
+// The last word is in the FIFO by now, not on the line, so the latch is counted from when it will be
+static void __isr dma_done(void)
+{
+    if (dma_channel_get_irq0_status(channel))
+    {
+        dma_channel_acknowledge_irq0(channel);
+        done_us = time_us_64();
+        busy = false;
+    }
+}
+
+void led_init(PIO pio, uint sm, bool rgbw)
+{
+    dma_channel_config config;
+
+    led_pio = pio;
+    led_sm = sm;
+    frame_us = (rgbw ? 32 : 24) * 1000000u / LED_BIT_HZ;
+    done_us = 0;
+    busy = false;
+    waiting = false;
+
+    channel = dma_claim_unused_channel(true);
+    config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, pio_get_dreq(pio, sm, true));
+    dma_channel_configure(channel, &config, &pio->txf[sm], &frame, 1, false);
+
+    dma_channel_set_irq0_enabled(channel, true);
+    irq_add_shared_handler(DMA_IRQ_0, dma_done, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+bool led_show(uint32_t pixel_grb)
+{
+    uint32_t word = pixel_grb << 8u; // The program shifts out the top bits first
+
+    if (word != wanted)
+    {
+        if (waiting)
+        {
+            stats.replaced++;
+        }
+        wanted = word;
+        waiting = word != frame;
+    }
+    else if (!waiting)
+    {
+        stats.skipped++;
+        return true;
+    }
+    if (!waiting)
+    {
+        // Changed back to the colour the LED has before the new one went out
+        return true;
+    }
+    if (busy || time_us_64() < done_us + frame_us + LED_RESET_US)
+    {
+        return false;
+    }
+
+    frame = wanted;
+    waiting = false;
+    busy = true;
+    dma_channel_set_read_addr(channel, &frame, true);
+    stats.sent++;
+    return true;
+}
+
+bool led_next(uint64_t *when)
+{
+    if (!waiting)
+    {
+        return false;
+    }
+    // A frame still in the DMA finishes within a few microseconds of starting
+    *when = (busy ? time_us_64() : done_us) + frame_us + LED_RESET_US;
+    return true;
+}
+
+void led_get_stats(struct led_stats *copy)
+{
+    *copy = stats;
+}
+
+// Cycles from start, SysTick counting down
+static uint32_t cycles_since(uint32_t start)
+{
+    return (start - systick_hw->cvr) & LED_SYSTICK_MAX;
+}
+
+void led_bench(struct led_bench_result *result)
+{
+    uint32_t shown = wanted;
+    struct led_stats kept = stats;
+    uint32_t csr = systick_hw->csr; // gpio_isr times itself on SysTick too
+    uint32_t start;
+
+    systick_hw->rvr = LED_SYSTICK_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = LED_SYSTICK_ENABLE;
+    while (busy)
+    {
+        tight_loop_contents();
+    }
+
+    // Before: what put_pixel() did, which stalls once the FIFO is full
+    result->blocking_cycles = 0;
+    for (uint32_t i = 0; i < LED_BENCH_UPDATES; i++)
+    {
+        start = systick_hw->cvr;
+        pio_sm_put_blocking(led_pio, led_sm, (i & 1 ? 0x00FF00u : 0x0000FFu) << 8u);
+        result->blocking_cycles += cycles_since(start);
+    }
+    while (!pio_sm_is_tx_fifo_empty(led_pio, led_sm))
+    {
+        tight_loop_contents();
+    }
+
+    // Untimed, each waits out the frame before it and the latch, so no led_show() is turned away
+    result->dma_cycles = 0;
+    result->dma_sent = stats.sent;
+    for (uint32_t i = 0; i < LED_BENCH_UPDATES; i++)
+    {
+        while (busy)
+        {
+            tight_loop_contents();
+        }
+        busy_wait_us_32(frame_us + LED_RESET_US);
+        start = systick_hw->cvr;
+        led_show(i & 1 ? 0x00FF00u : 0x0000FFu);
+        result->dma_cycles += cycles_since(start);
+    }
+    result->dma_sent = stats.sent - result->dma_sent;
+    result->unchanged_cycles = 0;
+    for (uint32_t i = 0; i < LED_BENCH_UPDATES; i++)
+    {
+        start = systick_hw->cvr;
+        led_show(wanted >> 8u);
+        result->unchanged_cycles += cycles_since(start);
+    }
+    systick_hw->csr = csr;
+
+    // The LED is left on a bench colour, send the one before again (led_next() says when)
+    stats = kept;
+    frame = LED_NONE;
+    wanted = LED_NONE;
+    waiting = false;
+    if (shown != LED_NONE)
+    {
+        led_show(shown >> 8u);
+    }
+}
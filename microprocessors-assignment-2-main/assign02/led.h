@@ -0,0 +1,76 @@
+#ifndef ASSIGN02_LED_H
+#define ASSIGN02_LED_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+
+/*
+ * The WS2812 without waiting on it: led_show() hands the colour to a DMA
+ * channel that feeds the ws2812 state machine's TX FIFO, and returns. The
+ * channel's completion interrupt marks it free again. A colour the LED
+ * already has, or is about to get, is not sent again.
+ *
+ * The LED takes a colour once its data line has stayed low for
+ * LED_RESET_US after the last bit, so a colour that comes while one is
+ * still going out waits (only the latest is kept) until led_next() says it
+ * can go, when led_show() is to be called again.
+ */
+
+#define LED_BIT_HZ 800000u    // ws2812 program's bit rate
+#define LED_RESET_US 300      // Low time that latches a colour, newer parts need 280 us
+#define LED_BENCH_UPDATES 64  // Colour changes led_bench() times each way
+
+struct led_stats
+{
+    uint32_t sent;     // Colours handed to the DMA
+    uint32_t skipped;  // led_show() calls with nothing new to send
+    uint32_t replaced; // Colours overtaken by a later one before they went out
+};
+
+struct led_bench_result
+{
+    uint32_t blocking_cycles;  // CPU cycles for LED_BENCH_UPDATES writes with pio_sm_put_blocking()
+    uint32_t dma_cycles;       // The same through led_show(), each one starting a transfer
+    uint32_t dma_sent;         // Transfers those led_show() calls started, LED_BENCH_UPDATES unless one was skipped
+    uint32_t unchanged_cycles; // led_show() of the colour already shown, LED_BENCH_UPDATES times
+};
+
+/*
+ * Claims a DMA channel to feed state machine sm of pio, which runs the
+ * ws2812 program for one pixel (32 bits with rgbw, else 24), and installs
+ * the completion interrupt
+ */
+void led_init(PIO pio, uint sm, bool rgbw);
+
+/*
+ * Shows pixel_grb as lookup_led_colour() gives it, without waiting.
+ * Returns false if it has to wait for the frame going out, see led_next()
+ */
+bool led_show(uint32_t pixel_grb);
+
+/*
+ * Gives the time a waiting colour can go out, returns false if none is waiting
+ */
+bool led_next(uint64_t *when);
+
+/*
+ * Copies the counters
+ */
+void led_get_stats(struct led_stats *stats);
+
+/*
+ * Times LED updates the old way (a blocking FIFO write each) against
+ * led_show() on SysTick. Each led_show() is timed alone, after the frame
+ * before it has gone out and latched, so every one starts a transfer.
+ * Then it asks for the colour that was showing before,
+ * which may have to wait for led_next(). It has not been run on a board
+ * yet, so there are no cycle figures for either way; tests/test_led.c
+ * checks the logic against faked DMA, not the timing.
+ */
+void led_bench(struct led_bench_result *result);
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Import header files
+ */
+#include "lookup.h"
+
+#if ASSIGN02_USE_INTERP
+#include "hardware/interp.h"
+#endif
+
+const uint32_t led_palette[LED_COLOURS] = {
+    [LED_BLUE] = LOOKUP_URGB(0x00, 0x00, 0xFF),
+    [LED_GREEN] = LOOKUP_URGB(0x80, 0xFF, 0x00),
+    [LED_YELLOW] = LOOKUP_URGB(0xFF, 0xFF, 0x00),
+    [LED_ORANGE] = LOOKUP_URGB(0xFF, 0x80, 0x00),
+    [LED_RED] = LOOKUP_URGB(0xFF, 0x00, 0x00),
+};
+
+void lookup_init(void)
+{
+#if ASSIGN02_USE_INTERP
+    interp_config config = interp_default_config();
+    interp_config_set_mask(&config, LOOKUP_DECODE_MASK_LSB, LOOKUP_DECODE_MASK_MSB);
+    interp_set_config(interp0, 0, &config);
+    interp0->base[0] = (uintptr_t)morse_decode_table;
+
+    config = interp_default_config();
+    interp_config_set_mask(&config, LOOKUP_COLOUR_MASK_LSB, LOOKUP_COLOUR_MASK_MSB);
+    interp_set_config(interp1, 0, &config);
+    interp1->base[0] = (uintptr_t)led_palette;
+#endif
+}
+
+char lookup_morse_decode(morse_code_t code)
+{
+    // The mask would wrap a longer code onto a real entry
+    if (code >= MORSE_DECODE_SIZE)
+    {
+        return '\0';
+    }
+#if ASSIGN02_USE_INTERP
+    interp0->accum[0] = code;
+    return *(const char *)interp0->peek[0];
+#else
+    return morse_decode_table[code];
+#endif
+}
+
+uint32_t lookup_led_colour(enum led_colour colour)
+{
+    if ((unsigned)colour >= LED_COLOURS)
+    {
+        colour = LED_BLUE;
+    }
+#if ASSIGN02_USE_INTERP
+    interp1->accum[0] = (uint32_t)colour * sizeof led_palette[0];
+    return *(const uint32_t *)interp1->peek[0];
+#else
+    return led_palette[colour];
+#endif
+}
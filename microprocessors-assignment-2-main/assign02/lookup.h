@@ -0,0 +1,65 @@
+#ifndef ASSIGN02_LOOKUP_H
+#define ASSIGN02_LOOKUP_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+#include "morse.h"
+
+/*
+ * Table lookups done by the SIO interpolators when ASSIGN02_USE_INTERP is
+ * set (the firmware build), by plain C otherwise. Lane 0 of interp0 masks a
+ * character code and adds the address of morse_decode_table, lane 0 of
+ * interp1 does the same for an LED colour and led_palette, so the address
+ * of the entry is one register read away.
+ *
+ * The interpolators belong to the core, not to the code running on it, so
+ * only the main loop may use these: an interrupt handler that wants them
+ * must save and restore the lanes (interp_save()/interp_restore()).
+ *
+ * Cycle counts have not been measured on the board. From the Cortex-M0+
+ * timings, with the table and SIO addresses already in registers, the
+ * plain path is a 2-cycle indexed load and the interpolator path is a
+ * 1-cycle accumulator store, a 1-cycle PEEK read and a 2-cycle load, so a
+ * lone lookup gains nothing. tests/test_lookup.c checks the lane set-up
+ * against interp_model.c.
+ */
+#define LOOKUP_DECODE_MASK_LSB 0
+#define LOOKUP_DECODE_MASK_MSB MORSE_MAX_ELEMENTS // Codes are below MORSE_DECODE_SIZE
+#define LOOKUP_COLOUR_MASK_LSB 2                  // Colour index arrives scaled by 4, the lanes only shift right
+#define LOOKUP_COLOUR_MASK_MSB 4
+
+/*
+ * Packs a colour the way the WS2812 expects it, at compile time
+ */
+#define LOOKUP_URGB(r, g, b) (((uint32_t)(r) << 8) | ((uint32_t)(g) << 16) | (uint32_t)(b))
+
+enum led_colour
+{
+    LED_BLUE,   // Game not in progress
+    LED_GREEN,  // 3 lives
+    LED_YELLOW, // 2 lives
+    LED_ORANGE, // 1 life
+    LED_RED,    // Game over
+    LED_COLOURS
+};
+
+extern const uint32_t led_palette[LED_COLOURS];
+
+/*
+ * Sets up the interpolator lanes on the calling core, call once before any lookup
+ */
+void lookup_init(void);
+
+/*
+ * Returns the character for a code, or '\0' if it is not a letter or digit (as morse_decode())
+ */
+char lookup_morse_decode(morse_code_t code);
+
+/*
+ * Returns the packed value of an LED colour for put_pixel()
+ */
+uint32_t lookup_led_colour(enum led_colour colour);
+
+#endif
@@ -0,0 +1,232 @@
+/*
+ * Import header files
+ */
+#include "morse.h"
+
+/*
+ * Lookup tables
+ */
+const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+const morse_code_t alpha_morse[26] = {MORSE_A, MORSE_B, MORSE_C, MORSE_D, MORSE_E, MORSE_F, MORSE_G,
+                                      MORSE_H, MORSE_I, MORSE_J, MORSE_K, MORSE_L, MORSE_M, MORSE_N,
+                                      MORSE_O, MORSE_P, MORSE_Q, MORSE_R, MORSE_S, MORSE_T, MORSE_U,
+                                      MORSE_V, MORSE_W, MORSE_X, MORSE_Y, MORSE_Z};
+const morse_code_t num_morse[10] = {MORSE_0, MORSE_1, MORSE_2, MORSE_3, MORSE_4,
+                                    MORSE_5, MORSE_6, MORSE_7, MORSE_8, MORSE_9};
+/*
+ * Conversion tables, built by the compiler from the codes above
+ */
+const char morse_decode_table[MORSE_DECODE_SIZE] = {
+    [MORSE_A] = 'A',
+    [MORSE_B] = 'B',
+    [MORSE_C] = 'C',
+    [MORSE_D] = 'D',
+    [MORSE_E] = 'E',
+    [MORSE_F] = 'F',
+    [MORSE_G] = 'G',
+    [MORSE_H] = 'H',
+    [MORSE_I] = 'I',
+    [MORSE_J] = 'J',
+    [MORSE_K] = 'K',
+    [MORSE_L] = 'L',
+    [MORSE_M] = 'M',
+    [MORSE_N] = 'N',
+    [MORSE_O] = 'O',
+    [MORSE_P] = 'P',
+    [MORSE_Q] = 'Q',
+    [MORSE_R] = 'R',
+    [MORSE_S] = 'S',
+    [MORSE_T] = 'T',
+    [MORSE_U] = 'U',
+    [MORSE_V] = 'V',
+    [MORSE_W] = 'W',
+    [MORSE_X] = 'X',
+    [MORSE_Y] = 'Y',
+    [MORSE_Z] = 'Z',
+    [MORSE_0] = '0',
+    [MORSE_1] = '1',
+    [MORSE_2] = '2',
+    [MORSE_3] = '3',
+    [MORSE_4] = '4',
+    [MORSE_5] = '5',
+    [MORSE_6] = '6',
+    [MORSE_7] = '7',
+    [MORSE_8] = '8',
+    [MORSE_9] = '9',
+};
+const morse_code_t morse_encode_table[MORSE_ENCODE_SIZE] = {
+    ['A'] = MORSE_A, ['a'] = MORSE_A,
+    ['B'] = MORSE_B, ['b'] = MORSE_B,
+    ['C'] = MORSE_C, ['c'] = MORSE_C,
+    ['D'] = MORSE_D, ['d'] = MORSE_D,
+    ['E'] = MORSE_E, ['e'] = MORSE_E,
+    ['F'] = MORSE_F, ['f'] = MORSE_F,
+    ['G'] = MORSE_G, ['g'] = MORSE_G,
+    ['H'] = MORSE_H, ['h'] = MORSE_H,
+    ['I'] = MORSE_I, ['i'] = MORSE_I,
+    ['J'] = MORSE_J, ['j'] = MORSE_J,
+    ['K'] = MORSE_K, ['k'] = MORSE_K,
+    ['L'] = MORSE_L, ['l'] = MORSE_L,
+    ['M'] = MORSE_M, ['m'] = MORSE_M,
+    ['N'] = MORSE_N, ['n'] = MORSE_N,
+    ['O'] = MORSE_O, ['o'] = MORSE_O,
+    ['P'] = MORSE_P, ['p'] = MORSE_P,
+    ['Q'] = MORSE_Q, ['q'] = MORSE_Q,
+    ['R'] = MORSE_R, ['r'] = MORSE_R,
+    ['S'] = MORSE_S, ['s'] = MORSE_S,
+    ['T'] = MORSE_T, ['t'] = MORSE_T,
+    ['U'] = MORSE_U, ['u'] = MORSE_U,
+    ['V'] = MORSE_V, ['v'] = MORSE_V,
+    ['W'] = MORSE_W, ['w'] = MORSE_W,
+    ['X'] = MORSE_X, ['x'] = MORSE_X,
+    ['Y'] = MORSE_Y, ['y'] = MORSE_Y,
+    ['Z'] = MORSE_Z, ['z'] = MORSE_Z,
+    ['0'] = MORSE_0,
+    ['1'] = MORSE_1,
+    ['2'] = MORSE_2,
+    ['3'] = MORSE_3,
+    ['4'] = MORSE_4,
+    ['5'] = MORSE_5,
+    ['6'] = MORSE_6,
+    ['7'] = MORSE_7,
+    ['8'] = MORSE_8,
+    ['9'] = MORSE_9,
+};
+
+void morse_input_reset(volatile struct morse_input *input)
+{
+    input->word = MORSE_WORD_EMPTY;
+    input->letter = MORSE_CODE_EMPTY;
+    input->letters = 0;
+    input->complete = false;
+}
+
+void morse_input_element(volatile struct morse_input *input, bool dash)
+{
+    if (input->letter >= (1u << MORSE_MAX_ELEMENTS))
+    {
+        // Too many elements for any character, the answer can no longer match
+        input->word = MORSE_WORD_INVALID;
+        input->letter = MORSE_CODE_EMPTY;
+        return;
+    }
+    input->letter = (morse_code_t)((input->letter << 1) | (dash ? 1u : 0u));
+}
+
+void morse_input_gap(volatile struct morse_input *input)
+{
+    if (input->letter == MORSE_CODE_EMPTY)
+    {
+        return;
+    }
+    if (input->word != MORSE_WORD_INVALID)
+    {
+        if (input->letters < MORSE_WORD_MAX_LETTERS)
+        {
+            input->word = MORSE_WORD_APPEND(input->word, input->letter);
+            input->letters++;
+        }
+        else
+        {
+            input->word = MORSE_WORD_INVALID;
+        }
+    }
+    input->letter = MORSE_CODE_EMPTY;
+}
+
+void morse_input_end(volatile struct morse_input *input)
+{
+    morse_input_gap(input);
+    input->complete = true;
+}
+
+morse_word_t morse_encode_word(const char *text)
+{
+    morse_word_t word = MORSE_WORD_EMPTY;
+    int letters = 0;
+
+    for (; *text != '\0'; text++)
+    {
+        morse_code_t code = morse_encode(*text);
+        if (code == 0 || ++letters > MORSE_WORD_MAX_LETTERS)
+        {
+            return MORSE_WORD_INVALID;
+        }
+        word = MORSE_WORD_APPEND(word, code);
+    }
+    return letters > 0 ? word : MORSE_WORD_INVALID;
+}
+
+int morse_code_length(morse_code_t code)
+{
+    int length = 0;
+    while (code > MORSE_CODE_EMPTY)
+    {
+        code >>= 1;
+        length++;
+    }
+    return length;
+}
+
+unsigned morse_duration(morse_word_t word)
+{
+    unsigned units = 0;
+
+    if (word == MORSE_WORD_INVALID)
+    {
+        return 0;
+    }
+    for (; word != MORSE_WORD_EMPTY; word >>= MORSE_FIELD_BITS)
+    {
+        morse_code_t code = (morse_code_t)(word & MORSE_FIELD_MASK);
+        int length = morse_code_length(code);
+
+        // Dashes add 2 units on top of a dot, then 1 unit per element and 1 per gap inside the letter
+        for (int bit = 0; bit < length; bit++)
+        {
+            units += (code >> bit) & 1u ? 3 : 1;
+        }
+        units += (unsigned)length - 1;
+        if ((word >> MORSE_FIELD_BITS) != MORSE_WORD_EMPTY)
+        {
+            units += 3;
+        }
+    }
+    return units;
+}
+
+char *morse_format(morse_word_t word, char *buffer, size_t size)
+{
+    morse_code_t letters[MORSE_WORD_MAX_LETTERS];
+    int count = 0;
+    size_t pos = 0;
+
+    if (word == MORSE_WORD_INVALID)
+    {
+        word = MORSE_WORD_EMPTY;
+    }
+    while (word != MORSE_WORD_EMPTY && count < MORSE_WORD_MAX_LETTERS)
+    {
+        letters[count++] = (morse_code_t)(word & MORSE_FIELD_MASK);
+        word >>= MORSE_FIELD_BITS;
+    }
+
+    // Fields come out last letter first, so walk them backwards
+    while (count > 0 && pos + 1 < size)
+    {
+        morse_code_t code = letters[--count];
+        for (int bit = morse_code_length(code) - 1; bit >= 0 && pos + 1 < size; bit--)
+        {
+            buffer[pos++] = (code >> bit) & 1u ? '-' : '.';
+        }
+        if (count > 0 && pos + 1 < size)
+        {
+            buffer[pos++] = ' ';
+        }
+    }
+    if (size > 0)
+    {
+        buffer[pos] = '\0';
+    }
+    return buffer;
+}
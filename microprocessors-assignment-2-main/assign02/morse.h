@@ -0,0 +1,182 @@
+#ifndef ASSIGN02_MORSE_H
+#define ASSIGN02_MORSE_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Packed Morse code for a single character.
+ * The length and the elements share one byte: a leading 1 bit marks the
+ * length and is followed by one bit per element (0 = dot, 1 = dash), first
+ * element most significant. ".-" is 0b101, "-..." is 0b11000.
+ * 0 is never a valid code.
+ */
+typedef uint8_t morse_code_t;
+
+/*
+ * Packed Morse code for a word: one 6-bit character code per letter, first
+ * letter most significant. A one-letter word has the same value as its
+ * character code, so the same compare grades characters and words.
+ */
+typedef uint64_t morse_word_t;
+
+#define MORSE_MAX_ELEMENTS 5       // Longest character code (digits)
+#define MORSE_FIELD_BITS 6         // Bits per letter in a morse_word_t
+#define MORSE_FIELD_MASK 0x3Fu     // Mask for one letter of a morse_word_t
+#define MORSE_WORD_MAX_LETTERS 10  // Letters that fit in a morse_word_t
+#define MORSE_CODE_EMPTY 0x01      // Character code with no elements yet
+#define MORSE_WORD_EMPTY 0         // Word code with no letters yet
+#define MORSE_WORD_INVALID UINT64_MAX // Never equal to a valid word code
+#define MORSE_STRING_MAX (MORSE_WORD_MAX_LETTERS * (MORSE_MAX_ELEMENTS + 1))
+
+#define MORSE_A 0x05 // .-
+#define MORSE_B 0x18 // -...
+#define MORSE_C 0x1A // -.-.
+#define MORSE_D 0x0C // -..
+#define MORSE_E 0x02 // .
+#define MORSE_F 0x12 // ..-.
+#define MORSE_G 0x0E // --.
+#define MORSE_H 0x10 // ....
+#define MORSE_I 0x04 // ..
+#define MORSE_J 0x17 // .---
+#define MORSE_K 0x0D // -.-
+#define MORSE_L 0x14 // .-..
+#define MORSE_M 0x07 // --
+#define MORSE_N 0x06 // -.
+#define MORSE_O 0x0F // ---
+#define MORSE_P 0x16 // .--.
+#define MORSE_Q 0x1D // --.-
+#define MORSE_R 0x0A // .-.
+#define MORSE_S 0x08 // ...
+#define MORSE_T 0x03 // -
+#define MORSE_U 0x09 // ..-
+#define MORSE_V 0x11 // ...-
+#define MORSE_W 0x0B // .--
+#define MORSE_X 0x19 // -..-
+#define MORSE_Y 0x1B // -.--
+#define MORSE_Z 0x1C // --..
+#define MORSE_0 0x3F // -----
+#define MORSE_1 0x2F // .----
+#define MORSE_2 0x27 // ..---
+#define MORSE_3 0x23 // ...--
+#define MORSE_4 0x21 // ....-
+#define MORSE_5 0x20 // .....
+#define MORSE_6 0x30 // -....
+#define MORSE_7 0x38 // --...
+#define MORSE_8 0x3C // ---..
+#define MORSE_9 0x3E // ----.
+
+/*
+ * Build packed word codes from character codes at compile time
+ */
+#define MORSE_WORD_APPEND(word, code) (((morse_word_t)(word) << MORSE_FIELD_BITS) | (code))
+#define MORSE_WORD3(a, b, c) MORSE_WORD_APPEND(MORSE_WORD_APPEND(a, b), c)
+#define MORSE_WORD4(a, b, c, d) MORSE_WORD_APPEND(MORSE_WORD3(a, b, c), d)
+#define MORSE_WORD5(a, b, c, d, e) MORSE_WORD_APPEND(MORSE_WORD4(a, b, c, d), e)
+
+/*
+ * Lookup tables, all const so they stay in flash
+ */
+extern const char alphabet[];
+extern const morse_code_t alpha_morse[26];
+extern const morse_code_t num_morse[10];
+
+/*
+ * Constant-time conversion tables, filled in by the compiler.
+ * morse_decode_table is indexed by a character code and holds '\0' for
+ * patterns that are not a letter or digit. morse_encode_table is indexed
+ * by ASCII and holds 0 for characters without a code; lower case letters
+ * map to the same code as upper case.
+ */
+#define MORSE_DECODE_SIZE (1u << (MORSE_MAX_ELEMENTS + 1))
+#define MORSE_ENCODE_SIZE 128u
+extern const char morse_decode_table[MORSE_DECODE_SIZE];
+extern const morse_code_t morse_encode_table[MORSE_ENCODE_SIZE];
+
+/*
+ * Returns the character for a code, or '\0' if it is not a letter or digit
+ */
+static inline char morse_decode(morse_code_t code)
+{
+    return code < MORSE_DECODE_SIZE ? morse_decode_table[code] : '\0';
+}
+
+/*
+ * Returns the code for a character, or 0 if it has none
+ */
+static inline morse_code_t morse_encode(char c)
+{
+    return (unsigned char)c < MORSE_ENCODE_SIZE ? morse_encode_table[(unsigned char)c] : 0;
+}
+
+/*
+ * Input captured from the button, accumulated in packed form.
+ * Written from the GPIO interrupt, read by the game loop.
+ */
+struct morse_input
+{
+    morse_word_t word;   // Letters closed by a gap, MORSE_WORD_INVALID on overflow
+    morse_code_t letter; // Letter currently being keyed
+    uint8_t letters;     // Number of letters in word
+    bool complete;       // End of transmission has been received
+};
+
+/*
+ * Clears the captured input ready for a new answer
+ */
+void morse_input_reset(volatile struct morse_input *input);
+
+/*
+ * Appends a dot (dash == false) or dash (dash == true) to the current letter
+ */
+void morse_input_element(volatile struct morse_input *input, bool dash);
+
+/*
+ * Closes the current letter and appends it to the word
+ */
+void morse_input_gap(volatile struct morse_input *input);
+
+/*
+ * Closes the current letter and marks the answer as complete
+ */
+void morse_input_end(volatile struct morse_input *input);
+
+/*
+ * Returns the number of elements in a character code
+ */
+int morse_code_length(morse_code_t code);
+
+/*
+ * Packs the text of a word (letters and digits) into a word code.
+ * Returns MORSE_WORD_INVALID if a character has no code or the word is too long.
+ */
+morse_word_t morse_encode_word(const char *text);
+
+/*
+ * Returns how long a packed word takes to key in dot units: a dot is 1,
+ * a dash 3, the gap inside a letter 1 and the gap between letters 3
+ */
+unsigned morse_duration(morse_word_t word);
+
+/*
+ * Returns true if node is on the path from the root of the Morse tree to
+ * code, i.e. the elements of node are the leading elements of code
+ */
+static inline bool morse_code_leads_to(morse_code_t node, morse_code_t code)
+{
+    int node_length = morse_code_length(node);
+    int code_length = morse_code_length(code);
+    return node_length <= code_length && (code >> (code_length - node_length)) == node;
+}
+
+/*
+ * Writes the dot/dash text of a packed word (or character) into buffer,
+ * letters separated by a space. Returns buffer.
+ */
+char *morse_format(morse_word_t word, char *buffer, size_t size);
+
+#endif
@@ -0,0 +1,257 @@
+/*
+ * Import header files
+ */
+#include "morse_batch.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define CHAR_ELEMENT_LOWS 0x0155u                      // Low bit of each 2-bit element position
+#define WORD_FIELD_LOWS 0x0041041041041041ull          // Low bit of each 6-bit letter field
+#define CHUNK 64                                       // Distances computed before they are ranked
+
+/*
+ * Character match keys built by the compiler, see morse_char_key_t
+ */
+#define CODE_LENGTH(c) ((c) >= 32 ? 5 : (c) >= 16 ? 4 : (c) >= 8 ? 3 : (c) >= 4 ? 2 : 1)
+#define ELEMENT_KEY(c, i) \
+    ((i) < CODE_LENGTH(c) ? (1u + (((c) >> ((CODE_LENGTH(c) - 1 - (i)) & 7)) & 1u)) << (2 * (4 - (i))) : 0u)
+#define CHAR_KEY(c) \
+    (ELEMENT_KEY(c, 0) | ELEMENT_KEY(c, 1) | ELEMENT_KEY(c, 2) | ELEMENT_KEY(c, 3) | ELEMENT_KEY(c, 4))
+
+const morse_char_key_t morse_batch_char_keys[MORSE_BATCH_CHARACTERS] = {
+    CHAR_KEY(MORSE_A), CHAR_KEY(MORSE_B), CHAR_KEY(MORSE_C), CHAR_KEY(MORSE_D), CHAR_KEY(MORSE_E),
+    CHAR_KEY(MORSE_F), CHAR_KEY(MORSE_G), CHAR_KEY(MORSE_H), CHAR_KEY(MORSE_I), CHAR_KEY(MORSE_J),
+    CHAR_KEY(MORSE_K), CHAR_KEY(MORSE_L), CHAR_KEY(MORSE_M), CHAR_KEY(MORSE_N), CHAR_KEY(MORSE_O),
+    CHAR_KEY(MORSE_P), CHAR_KEY(MORSE_Q), CHAR_KEY(MORSE_R), CHAR_KEY(MORSE_S), CHAR_KEY(MORSE_T),
+    CHAR_KEY(MORSE_U), CHAR_KEY(MORSE_V), CHAR_KEY(MORSE_W), CHAR_KEY(MORSE_X), CHAR_KEY(MORSE_Y),
+    CHAR_KEY(MORSE_Z), CHAR_KEY(MORSE_0), CHAR_KEY(MORSE_1), CHAR_KEY(MORSE_2), CHAR_KEY(MORSE_3),
+    CHAR_KEY(MORSE_4), CHAR_KEY(MORSE_5), CHAR_KEY(MORSE_6), CHAR_KEY(MORSE_7), CHAR_KEY(MORSE_8),
+    CHAR_KEY(MORSE_9)};
+
+/*
+ * Counts the set bits of each 16-bit lane of v, which may only have the
+ * low bit of each element position set
+ */
+static uint32_t lane_count16(uint32_t v)
+{
+    v = (v & 0x33333333u) + ((v >> 2) & 0x33333333u);
+    v = (v + (v >> 4)) & 0x0F0F0F0Fu;
+    return (v + (v >> 8)) & 0x001F001Fu;
+}
+
+/*
+ * Returns the number of letter fields that differ between two word keys
+ */
+static unsigned word_distance(morse_word_t a, morse_word_t b)
+{
+    uint64_t x = a ^ b;
+    uint64_t y = (x | (x >> 1) | (x >> 2) | (x >> 3) | (x >> 4) | (x >> 5)) & WORD_FIELD_LOWS;
+
+    // Sum the fields into the lowest one, none can reach 64
+    y += y >> 6;
+    y += y >> 12;
+    y += y >> 24;
+    y += y >> 48;
+    return (unsigned)(y & 0x3Fu);
+}
+
+/*
+ * Fills distance[i] with the distance of keys[i] from key, for i < count
+ */
+static void char_distances(const morse_char_key_t *keys, size_t count, morse_char_key_t key, uint8_t *distance)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i k = _mm256_set1_epi16((short)key);
+    const __m256i lows = _mm256_set1_epi16(CHAR_ELEMENT_LOWS);
+    for (; i + 16 <= count; i += 16)
+    {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(keys + i)), k);
+        __m256i v = _mm256_and_si256(_mm256_or_si256(x, _mm256_srli_epi16(x, 1)), lows);
+        v = _mm256_add_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x3333)),
+                             _mm256_and_si256(_mm256_srli_epi16(v, 2), _mm256_set1_epi16(0x3333)));
+        v = _mm256_and_si256(_mm256_add_epi16(v, _mm256_srli_epi16(v, 4)), _mm256_set1_epi16(0x0F0F));
+        v = _mm256_and_si256(_mm256_add_epi16(v, _mm256_srli_epi16(v, 8)), _mm256_set1_epi16(0x001F));
+        // Each count fits in the low byte of its lane
+        __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        _mm_storeu_si128((__m128i *)(distance + i), packed);
+    }
+#elif defined(__ARM_NEON)
+    const uint16x8_t k = vdupq_n_u16(key);
+    const uint16x8_t lows = vdupq_n_u16(CHAR_ELEMENT_LOWS);
+    for (; i + 8 <= count; i += 8)
+    {
+        uint16x8_t x = veorq_u16(vld1q_u16(keys + i), k);
+        uint8x16_t bits = vreinterpretq_u8_u16(vandq_u16(vorrq_u16(x, vshrq_n_u16(x, 1)), lows));
+        // Bytes counted by the hardware, then the two bytes of each lane added
+        uint16x8_t v = vpaddlq_u8(vcntq_u8(bits));
+        vst1_u8(distance + i, vmovn_u16(v));
+    }
+#else
+    // SWAR: two keys per 32-bit word
+    const uint32_t k = key * 0x00010001u;
+    for (; i + 2 <= count; i += 2)
+    {
+        uint32_t x = (keys[i] | ((uint32_t)keys[i + 1] << 16)) ^ k;
+        uint32_t v = lane_count16((x | (x >> 1)) & (CHAR_ELEMENT_LOWS * 0x00010001u));
+        distance[i] = (uint8_t)v;
+        distance[i + 1] = (uint8_t)(v >> 16);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        uint32_t x = keys[i] ^ key;
+        distance[i] = (uint8_t)lane_count16((x | (x >> 1)) & CHAR_ELEMENT_LOWS);
+    }
+}
+
+/*
+ * Fills distance[i] with the distance of keys[i] from key, for i < count
+ */
+static void word_distances(const morse_word_t *keys, size_t count, morse_word_t key, uint8_t *distance)
+{
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i k = _mm256_set1_epi64x((long long)key);
+    const __m256i lows = _mm256_set1_epi64x((long long)WORD_FIELD_LOWS);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m256i x = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(keys + i)), k);
+        __m256i y = _mm256_or_si256(_mm256_or_si256(x, _mm256_srli_epi64(x, 1)),
+                                    _mm256_or_si256(_mm256_srli_epi64(x, 2), _mm256_srli_epi64(x, 3)));
+        y = _mm256_or_si256(y, _mm256_or_si256(_mm256_srli_epi64(x, 4), _mm256_srli_epi64(x, 5)));
+        y = _mm256_and_si256(y, lows);
+        y = _mm256_add_epi64(y, _mm256_srli_epi64(y, 6));
+        y = _mm256_add_epi64(y, _mm256_srli_epi64(y, 12));
+        y = _mm256_add_epi64(y, _mm256_srli_epi64(y, 24));
+        y = _mm256_add_epi64(y, _mm256_srli_epi64(y, 48));
+        uint64_t lanes[4];
+        _mm256_storeu_si256((__m256i *)lanes, y);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            distance[i + lane] = (uint8_t)(lanes[lane] & 0x3Fu);
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint64x2_t k = vdupq_n_u64(key);
+    const uint64x2_t lows = vdupq_n_u64(WORD_FIELD_LOWS);
+    for (; i + 2 <= count; i += 2)
+    {
+        uint64x2_t x = veorq_u64(vld1q_u64(keys + i), k);
+        uint64x2_t y = vorrq_u64(vorrq_u64(x, vshrq_n_u64(x, 1)), vorrq_u64(vshrq_n_u64(x, 2), vshrq_n_u64(x, 3)));
+        y = vorrq_u64(y, vorrq_u64(vshrq_n_u64(x, 4), vshrq_n_u64(x, 5)));
+        y = vandq_u64(y, lows);
+        y = vaddq_u64(y, vshrq_n_u64(y, 6));
+        y = vaddq_u64(y, vshrq_n_u64(y, 12));
+        y = vaddq_u64(y, vshrq_n_u64(y, 24));
+        y = vaddq_u64(y, vshrq_n_u64(y, 48));
+        distance[i] = (uint8_t)(vgetq_lane_u64(y, 0) & 0x3Fu);
+        distance[i + 1] = (uint8_t)(vgetq_lane_u64(y, 1) & 0x3Fu);
+    }
+#endif
+    // SWAR: all ten letter fields of a key at once
+    for (; i < count; i++)
+    {
+        distance[i] = (uint8_t)word_distance(keys[i], key);
+    }
+}
+
+/*
+ * Adds an entry to the k nearest found so far if it is nearer than the
+ * worst of them. Returns the new number found.
+ */
+static int offer(struct morse_batch_candidate *candidates, int found, int k, size_t index, uint8_t distance)
+{
+    int i;
+
+    if (found == k)
+    {
+        if (distance >= candidates[k - 1].distance)
+        {
+            return found;
+        }
+        i = k - 1;
+    }
+    else
+    {
+        i = found++;
+    }
+    while (i > 0 && candidates[i - 1].distance > distance)
+    {
+        candidates[i] = candidates[i - 1];
+        i--;
+    }
+    candidates[i].index = (uint16_t)index;
+    candidates[i].distance = distance;
+    return found;
+}
+
+morse_char_key_t morse_batch_char_key(morse_code_t code)
+{
+    int length = morse_code_length(code);
+    morse_char_key_t key = 0;
+
+    for (int i = 0; i < length && i < MORSE_MAX_ELEMENTS; i++)
+    {
+        unsigned dash = (code >> (length - 1 - i)) & 1u;
+        key |= (morse_char_key_t)((1u + dash) << (2 * (MORSE_MAX_ELEMENTS - 1 - i)));
+    }
+    return key;
+}
+
+morse_word_t morse_batch_word_key(morse_word_t word)
+{
+    int letters = 0;
+
+    if (word == MORSE_WORD_INVALID)
+    {
+        return word;
+    }
+    for (morse_word_t rest = word; rest != MORSE_WORD_EMPTY; rest >>= MORSE_FIELD_BITS)
+    {
+        letters++;
+    }
+    return letters < MORSE_WORD_MAX_LETTERS ? word << (MORSE_FIELD_BITS * (MORSE_WORD_MAX_LETTERS - letters)) : word;
+}
+
+int morse_batch_match_chars(const morse_char_key_t *keys, size_t count, morse_char_key_t key,
+                            struct morse_batch_candidate *candidates, int k)
+{
+    uint8_t distance[CHUNK];
+    int found = 0;
+
+    for (size_t base = 0; base < count && k > 0; base += CHUNK)
+    {
+        size_t n = count - base < CHUNK ? count - base : CHUNK;
+        char_distances(keys + base, n, key, distance);
+        for (size_t i = 0; i < n; i++)
+        {
+            found = offer(candidates, found, k, base + i, distance[i]);
+        }
+    }
+    return found;
+}
+
+int morse_batch_match_words(const morse_word_t *keys, size_t count, morse_word_t key,
+                            struct morse_batch_candidate *candidates, int k)
+{
+    uint8_t distance[CHUNK];
+    int found = 0;
+
+    for (size_t base = 0; base < count && k > 0; base += CHUNK)
+    {
+        size_t n = count - base < CHUNK ? count - base : CHUNK;
+        word_distances(keys + base, n, key, distance);
+        for (size_t i = 0; i < n; i++)
+        {
+            found = offer(candidates, found, k, base + i, distance[i]);
+        }
+    }
+    return found;
+}
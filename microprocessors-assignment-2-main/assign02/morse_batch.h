@@ -0,0 +1,68 @@
+#ifndef ASSIGN02_MORSE_BATCH_H
+#define ASSIGN02_MORSE_BATCH_H
+
+/*
+ * Import header files
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "morse.h"
+
+/*
+ * Compares one keyed code against a whole table of codes in one pass.
+ * The tables are plain arrays of match keys (structure of arrays: the key
+ * column is separate from the text it belongs to), laid out so that many
+ * entries are compared per instruction: SWAR on the Cortex-M0+, AVX2 or
+ * NEON vectors when built for a host that has them.
+ *
+ * The distance between two codes is the number of positions at which they
+ * differ once lined up at their start: elements for a character, letters
+ * for a word. A missing position differs from any present one.
+ */
+#define MORSE_BATCH_CHARACTERS 36   // Entries in morse_batch_char_keys, in alphabet[] order
+
+/*
+ * Character match key: two bits per element position, first element in
+ * bits 8-9, 00 for no element, 01 for a dot and 10 for a dash
+ */
+typedef uint16_t morse_char_key_t;
+
+/*
+ * An entry of a table and its distance from the keyed code
+ */
+struct morse_batch_candidate
+{
+    uint16_t index;
+    uint8_t distance;
+};
+
+/*
+ * Match keys of A-Z then 0-9, the same order as alphabet[], alpha_morse and num_morse
+ */
+extern const morse_char_key_t morse_batch_char_keys[MORSE_BATCH_CHARACTERS];
+
+/*
+ * Returns the match key of a character code
+ */
+morse_char_key_t morse_batch_char_key(morse_code_t code);
+
+/*
+ * Returns the match key of a packed word: the same code shifted so its
+ * first letter is in bits 54-59
+ */
+morse_word_t morse_batch_word_key(morse_word_t word);
+
+/*
+ * Finds the k entries of keys nearest to key, nearest first (an exact
+ * match has distance 0, ties keep table order). Returns how many were found.
+ */
+int morse_batch_match_chars(const morse_char_key_t *keys, size_t count, morse_char_key_t key,
+                            struct morse_batch_candidate *candidates, int k);
+
+/*
+ * As morse_batch_match_chars() for word match keys
+ */
+int morse_batch_match_words(const morse_word_t *keys, size_t count, morse_word_t key,
+                            struct morse_batch_candidate *candidates, int k);
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Import header files
+ */
+#include <ctype.h>
+#include <string.h>
+#include "morse_beam.h"
+#include "lookup.h"
+
+/*
+ * One way of reading the marks so far
+ */
+struct hypothesis
+{
+    char prefix[DICTIONARY_WORD_MAX + 1]; // Letters closed so far
+    uint8_t length;                       // Letters in prefix
+    morse_code_t node;                    // Elements of the letter being keyed
+    uint16_t first;                       // Dictionary words starting with prefix are
+    uint16_t last;                        // the indices first to last - 1
+    uint32_t cost;
+};
+
+static struct hypothesis beam[MORSE_BEAM_WIDTH];
+static struct hypothesis expanded[2 * MORSE_BEAM_WIDTH]; // Each hypothesis has at most two successors
+
+/*
+ * Cost of reading a gap as the space between two elements of one letter
+ */
+static uint32_t stay_cost(uint16_t gap)
+{
+    return gap > MORSE_BEAM_ELEMENT_GAP ? gap - MORSE_BEAM_ELEMENT_GAP : 0;
+}
+
+/*
+ * Cost of reading a gap as the space between two letters
+ */
+static uint32_t close_cost(uint16_t gap)
+{
+    return gap < MORSE_BEAM_LETTER_GAP ? MORSE_BEAM_LETTER_GAP - gap : 0;
+}
+
+/*
+ * Closes the letter being keyed in from into to. Returns false if the
+ * elements are not a character or no dictionary word continues that way.
+ */
+static bool close_letter(const struct dictionary *dict, const struct hypothesis *from, struct hypothesis *to)
+{
+    char letter = (char)tolower((unsigned char)lookup_morse_decode(from->node));
+
+    if (letter == '\0' || from->length == DICTIONARY_WORD_MAX)
+    {
+        return false;
+    }
+    *to = *from;
+    to->prefix[to->length + 1] = '\0';
+
+    // The words starting with prefix + letter end where those starting with prefix + (letter + 1) begin
+    to->prefix[to->length] = (char)(letter + 1);
+    to->last = (uint16_t)dictionary_lower_bound(dict, to->prefix);
+    to->prefix[to->length] = letter;
+    to->first = (uint16_t)dictionary_lower_bound(dict, to->prefix);
+    to->length++;
+    return to->first < to->last;
+}
+
+/*
+ * Sorts the first count hypotheses of expanded by cost, keeping the order of equal costs
+ */
+static void sort_expanded(int count)
+{
+    for (int i = 1; i < count; i++)
+    {
+        struct hypothesis hypothesis = expanded[i];
+        int j = i;
+        while (j > 0 && expanded[j - 1].cost > hypothesis.cost)
+        {
+            expanded[j] = expanded[j - 1];
+            j--;
+        }
+        expanded[j] = hypothesis;
+    }
+}
+
+void morse_beam_input_clear(volatile struct morse_beam_input *input)
+{
+    input->dashes = 0;
+    input->marks = 0;
+    input->overflow = false;
+    input->next_gap = MORSE_BEAM_ELEMENT_GAP;
+}
+
+void morse_beam_input_gap(volatile struct morse_beam_input *input, uint16_t gap)
+{
+    input->next_gap = gap;
+}
+
+void morse_beam_input_mark(volatile struct morse_beam_input *input, bool dash)
+{
+    if (input->marks == MORSE_BEAM_MAX_MARKS)
+    {
+        input->overflow = true;
+        return;
+    }
+    input->gaps[input->marks] = input->next_gap;
+    input->dashes |= (uint64_t)(dash ? 1u : 0u) << input->marks;
+    input->marks++;
+    input->next_gap = MORSE_BEAM_ELEMENT_GAP;
+}
+
+int morse_beam_decode(const struct dictionary *dict, const struct morse_beam_input *input,
+                      struct morse_beam_candidate *candidates, int k)
+{
+    int width = 1;
+    int found = 0;
+
+    if (input->marks == 0 || input->overflow || dict->header == NULL)
+    {
+        return 0;
+    }
+
+    beam[0].prefix[0] = '\0';
+    beam[0].length = 0;
+    beam[0].node = (morse_code_t)((MORSE_CODE_EMPTY << 1) | (input->dashes & 1u));
+    beam[0].first = 0;
+    beam[0].last = (uint16_t)dictionary_count(dict);
+    beam[0].cost = 0;
+
+    for (int mark = 1; mark < input->marks; mark++)
+    {
+        unsigned dash = (unsigned)(input->dashes >> mark) & 1u;
+        uint16_t gap = input->gaps[mark];
+        int count = 0;
+
+        for (int i = 0; i < width; i++)
+        {
+            // Either the mark extends the letter...
+            if (morse_code_length(beam[i].node) < MORSE_MAX_ELEMENTS)
+            {
+                expanded[count] = beam[i];
+                expanded[count].node = (morse_code_t)((beam[i].node << 1) | dash);
+                expanded[count].cost += stay_cost(gap);
+                count++;
+            }
+            // ...or the gap before it ended one
+            if (close_letter(dict, &beam[i], &expanded[count]))
+            {
+                expanded[count].node = (morse_code_t)((MORSE_CODE_EMPTY << 1) | dash);
+                expanded[count].cost += close_cost(gap);
+                count++;
+            }
+        }
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        sort_expanded(count);
+        width = count < MORSE_BEAM_WIDTH ? count : MORSE_BEAM_WIDTH;
+        memcpy(beam, expanded, (size_t)width * sizeof beam[0]);
+    }
+
+    // The end of the answer closes the last letter, the beam is already in cost order
+    for (int i = 0; i < width && found < k; i++)
+    {
+        struct hypothesis closed;
+        if (close_letter(dict, &beam[i], &closed))
+        {
+            dictionary_word(dict, closed.first, candidates[found].word);
+            if (strcmp(candidates[found].word, closed.prefix) == 0)
+            {
+                candidates[found].cost = closed.cost;
+                found++;
+            }
+        }
+    }
+    return found;
+}
@@ -0,0 +1,71 @@
+#ifndef ASSIGN02_MORSE_BEAM_H
+#define ASSIGN02_MORSE_BEAM_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "morse.h"
+#include "dictionary.h"
+
+/*
+ * Beam-search decoder for keying whose letter gaps cannot be trusted.
+ * Dots and dashes are taken as keyed, but every gap between two of them
+ * may either stay inside a letter or close it, at a cost that grows with
+ * how far the gap is from the length that choice implies. Hypotheses walk
+ * the sorted dictionary as a trie (each prefix is a range of word indices)
+ * and only the MORSE_BEAM_WIDTH cheapest survive each element, so memory
+ * is fixed and the work per element has a fixed upper bound.
+ */
+#define MORSE_BEAM_WIDTH 16                                 // Hypotheses kept after each element
+#define MORSE_BEAM_MAX_MARKS 64                             // Dots and dashes in one answer
+#define MORSE_BEAM_UNIT 256                                 // One dot unit in gap lengths and costs
+#define MORSE_BEAM_ELEMENT_GAP (1 * MORSE_BEAM_UNIT)        // Nominal gap inside a letter
+#define MORSE_BEAM_LETTER_GAP (3 * MORSE_BEAM_UNIT)         // Nominal gap between letters
+
+/*
+ * Marks keyed for one answer with the gap before each, in MORSE_BEAM_UNIT
+ * fixed point. Written from the GPIO interrupt, read by the game loop.
+ */
+struct morse_beam_input
+{
+    uint64_t dashes;                        // Bit i set if mark i is a dash
+    uint8_t marks;                          // Marks keyed
+    bool overflow;                          // More than MORSE_BEAM_MAX_MARKS were keyed
+    uint16_t next_gap;                      // Gap before the next mark
+    uint16_t gaps[MORSE_BEAM_MAX_MARKS];    // gaps[i] is the gap before mark i, gaps[0] is unused
+};
+
+/*
+ * A decoded word and the cost of reading the gaps that way, lower is better
+ */
+struct morse_beam_candidate
+{
+    char word[DICTIONARY_WORD_MAX + 1];
+    uint32_t cost;
+};
+
+/*
+ * Empties the input ready for a new answer
+ */
+void morse_beam_input_clear(volatile struct morse_beam_input *input);
+
+/*
+ * Records the length of the gap before the next mark, MORSE_BEAM_ELEMENT_GAP if never called
+ */
+void morse_beam_input_gap(volatile struct morse_beam_input *input, uint16_t gap);
+
+/*
+ * Appends a dot (dash == false) or dash (dash == true)
+ */
+void morse_beam_input_mark(volatile struct morse_beam_input *input, bool dash);
+
+/*
+ * Finds the dictionary words the input most likely spells.
+ * Fills up to k candidates, cheapest first, and returns how many.
+ */
+int morse_beam_decode(const struct dictionary *dict, const struct morse_beam_input *input,
+                      struct morse_beam_candidate *candidates, int k);
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Import header files
+ */
+#include "morse_decoder.h"
+
+/*
+ * Returns the character code of letter index in a packed word of letters letters
+ */
+static morse_code_t target_letter(morse_word_t target, int letters, int index)
+{
+    return (morse_code_t)((target >> (MORSE_FIELD_BITS * (letters - 1 - index))) & MORSE_FIELD_MASK);
+}
+
+static enum morse_verdict reject(volatile struct morse_decoder *decoder)
+{
+    decoder->verdict = MORSE_REJECTED;
+    return MORSE_REJECTED;
+}
+
+void morse_decoder_start(volatile struct morse_decoder *decoder, morse_word_t target)
+{
+    int letters = 0;
+
+    for (morse_word_t rest = target; rest != MORSE_WORD_EMPTY; rest >>= MORSE_FIELD_BITS)
+    {
+        letters++;
+    }
+
+    decoder->target = target;
+    decoder->node = MORSE_CODE_EMPTY;
+    decoder->letter = 0;
+    decoder->letters = (uint8_t)letters;
+    decoder->verdict = MORSE_PENDING;
+}
+
+enum morse_verdict morse_decoder_element(volatile struct morse_decoder *decoder, bool dash)
+{
+    if (decoder->verdict != MORSE_PENDING)
+    {
+        return decoder->verdict;
+    }
+
+    morse_code_t next = (morse_code_t)((decoder->node << 1) | (dash ? 1u : 0u));
+    if (decoder->target == MORSE_WORD_EMPTY)
+    {
+        // Only decoding, a code too long for any character falls off the tree to 0
+        decoder->node = decoder->node < (1u << MORSE_MAX_ELEMENTS) ? next : 0;
+        return decoder->verdict;
+    }
+
+    morse_code_t expected = target_letter(decoder->target, decoder->letters, decoder->letter);
+
+    // Still on the path to the expected letter?
+    if (!morse_code_leads_to(next, expected))
+    {
+        return reject(decoder);
+    }
+    decoder->node = next;
+
+    // Even on the target letter a longer code can still follow, so only the gap accepts it
+    return decoder->verdict;
+}
+
+enum morse_verdict morse_decoder_gap(volatile struct morse_decoder *decoder)
+{
+    if (decoder->verdict != MORSE_PENDING || decoder->node == MORSE_CODE_EMPTY)
+    {
+        return decoder->verdict;
+    }
+    if (decoder->target == MORSE_WORD_EMPTY)
+    {
+        decoder->node = MORSE_CODE_EMPTY;
+        return decoder->verdict;
+    }
+
+    if (decoder->node != target_letter(decoder->target, decoder->letters, decoder->letter))
+    {
+        // Letter closed before it was finished
+        return reject(decoder);
+    }
+
+    decoder->letter++;
+    decoder->node = MORSE_CODE_EMPTY;
+    if (decoder->letter == decoder->letters)
+    {
+        decoder->verdict = MORSE_ACCEPTED;
+    }
+    return decoder->verdict;
+}
+
+enum morse_verdict morse_decoder_end(volatile struct morse_decoder *decoder)
+{
+    // The last letter is closed by the end of transmission rather than a gap
+    morse_decoder_gap(decoder);
+    if (decoder->verdict == MORSE_PENDING && decoder->target != MORSE_WORD_EMPTY)
+    {
+        return reject(decoder);
+    }
+    return decoder->verdict;
+}
@@ -0,0 +1,67 @@
+#ifndef ASSIGN02_MORSE_DECODER_H
+#define ASSIGN02_MORSE_DECODER_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "morse.h"
+
+/*
+ * Result of checking an answer while it is being keyed
+ */
+enum morse_verdict
+{
+    MORSE_PENDING,  // Input so far is a prefix of the target
+    MORSE_ACCEPTED, // Target has been keyed completely and its last letter closed
+    MORSE_REJECTED  // Input has diverged from the target
+};
+
+/*
+ * Streaming decoder that walks the Morse tree one element at a time.
+ * A character code doubles as its node in the tree: the root is
+ * MORSE_CODE_EMPTY and the children of node n are 2n (dot) and 2n + 1 (dash),
+ * so a node is on the path to the target letter exactly when it is a
+ * leading part of the target's code.
+ */
+struct morse_decoder
+{
+    morse_word_t target;     // Packed target, MORSE_WORD_EMPTY to only decode
+    morse_code_t node;       // Current node in the Morse tree
+    uint8_t letter;          // Index of the letter being keyed
+    uint8_t letters;         // Number of letters in target
+    enum morse_verdict verdict;
+};
+
+/*
+ * Starts checking a new answer against target
+ */
+void morse_decoder_start(volatile struct morse_decoder *decoder, morse_word_t target);
+
+/*
+ * Feeds one element (dash == false for a dot) into the decoder
+ */
+enum morse_verdict morse_decoder_element(volatile struct morse_decoder *decoder, bool dash);
+
+/*
+ * Feeds an inter-letter gap into the decoder, which accepts the answer once
+ * it closes the last letter of the target
+ */
+enum morse_verdict morse_decoder_gap(volatile struct morse_decoder *decoder);
+
+/*
+ * Feeds the end of transmission into the decoder, an unfinished answer is rejected
+ */
+enum morse_verdict morse_decoder_end(volatile struct morse_decoder *decoder);
+
+/*
+ * Returns the character at the current tree node, or '\0' if the elements
+ * keyed so far are not a complete character
+ */
+static inline char morse_decoder_current(const volatile struct morse_decoder *decoder)
+{
+    return morse_decode(decoder->node);
+}
+
+#endif
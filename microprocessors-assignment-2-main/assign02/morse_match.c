@@ -0,0 +1,180 @@
+/*
+ * Import header files
+ */
+#include "morse_match.h"
+
+/*
+ * Returns a mask of the low bits bits
+ */
+static uint64_t low_bits(int bits)
+{
+    return bits >= 64 ? UINT64_MAX : ((uint64_t)1 << bits) - 1;
+}
+
+/*
+ * Returns the distance between the first row symbols of the target and the
+ * first column symbols of the answer. Row 0 holds column, and each set bit
+ * of vp/vn adds/subtracts one going down the column.
+ */
+static int cell(const struct morse_match *match, int row, int column)
+{
+    uint64_t rows = low_bits(row);
+    return column + __builtin_popcountll(match->vp[column] & rows) - __builtin_popcountll(match->vn[column] & rows);
+}
+
+void morse_symbols_clear(volatile struct morse_symbols *symbols)
+{
+    for (int s = 0; s < MORSE_SYMBOL_COUNT; s++)
+    {
+        symbols->mask[s] = 0;
+    }
+    symbols->length = 0;
+    symbols->overflow = false;
+}
+
+void morse_symbols_append(volatile struct morse_symbols *symbols, enum morse_symbol symbol)
+{
+    if (symbol == MORSE_SYMBOL_GAP &&
+        (symbols->length == 0 || (symbols->mask[MORSE_SYMBOL_GAP] >> (symbols->length - 1)) & 1u))
+    {
+        return;
+    }
+    if (symbols->length == MORSE_MATCH_MAX_SYMBOLS)
+    {
+        symbols->overflow = true;
+        return;
+    }
+    symbols->mask[symbol] |= (uint64_t)1 << symbols->length;
+    symbols->length++;
+}
+
+void morse_symbols_from_word(struct morse_symbols *symbols, morse_word_t word)
+{
+    morse_symbols_clear(symbols);
+    if (word == MORSE_WORD_INVALID)
+    {
+        return;
+    }
+
+    int letters = 0;
+    for (morse_word_t rest = word; rest != MORSE_WORD_EMPTY; rest >>= MORSE_FIELD_BITS)
+    {
+        letters++;
+    }
+    for (int letter = letters - 1; letter >= 0; letter--)
+    {
+        morse_code_t code = (morse_code_t)((word >> (MORSE_FIELD_BITS * letter)) & MORSE_FIELD_MASK);
+        for (int element = morse_code_length(code) - 1; element >= 0; element--)
+        {
+            morse_symbols_append(symbols, ((code >> element) & 1u) ? MORSE_SYMBOL_DASH : MORSE_SYMBOL_DOT);
+        }
+        morse_symbols_append(symbols, MORSE_SYMBOL_GAP);
+    }
+
+    // Drop the gap after the last letter
+    if (symbols->length > 0)
+    {
+        symbols->length--;
+        symbols->mask[MORSE_SYMBOL_GAP] &= low_bits(symbols->length);
+    }
+}
+
+/*
+ * Runs the bit-parallel recurrence over keyed, storing each column's
+ * deltas in match if it is not NULL. Returns the distance.
+ */
+static int run(const struct morse_symbols *expected, const struct morse_symbols *keyed, struct morse_match *match)
+{
+    int m = expected->length;
+    uint64_t rows = low_bits(m);
+    uint64_t last = m > 0 ? (uint64_t)1 << (m - 1) : 0;
+    uint64_t vp = rows; // Column 0 counts up from 0 to m
+    uint64_t vn = 0;
+    int score = m;
+
+    if (match != NULL)
+    {
+        match->vp[0] = vp;
+        match->vn[0] = vn;
+    }
+    for (int j = 0; j < keyed->length; j++)
+    {
+        uint64_t eq = expected->mask[morse_symbol_at(keyed, j)];
+        uint64_t d0 = (((eq & vp) + vp) ^ vp) | eq | vn;
+        uint64_t hp = vn | ~(d0 | vp);
+        uint64_t hn = vp & d0;
+
+        score += (hp & last) ? 1 : 0;
+        score -= (hn & last) ? 1 : 0;
+
+        // The top row grows by one per keyed symbol, so a 1 is shifted in
+        uint64_t x = (hp << 1) | 1u;
+        vn = x & d0 & rows;
+        vp = ((hn << 1) | ~(x | d0)) & rows;
+
+        if (match != NULL)
+        {
+            match->vp[j + 1] = vp;
+            match->vn[j + 1] = vn;
+        }
+    }
+    return m > 0 ? score : keyed->length;
+}
+
+int morse_distance(const struct morse_symbols *expected, const struct morse_symbols *keyed)
+{
+    return run(expected, keyed, NULL);
+}
+
+int morse_match(const struct morse_symbols *expected, const struct morse_symbols *keyed, struct morse_match *match)
+{
+    int row = expected->length;
+    int column = keyed->length;
+    int length = 0;
+
+    match->distance = (uint8_t)run(expected, keyed, match);
+    match->substitutions = 0;
+    match->insertions = 0;
+    match->deletions = 0;
+
+    // Walk back from the bottom right corner, the steps come out in reverse
+    while (row > 0 || column > 0)
+    {
+        struct morse_match_step *step = &match->steps[length++];
+        int here = cell(match, row, column);
+
+        step->expected = row > 0 ? (uint8_t)morse_symbol_at(expected, row - 1) : 0;
+        step->keyed = column > 0 ? (uint8_t)morse_symbol_at(keyed, column - 1) : 0;
+
+        if (row > 0 && column > 0 &&
+            cell(match, row - 1, column - 1) + (step->expected != step->keyed) == here)
+        {
+            step->edit = step->expected == step->keyed ? MORSE_EDIT_MATCH : MORSE_EDIT_SUBSTITUTE;
+            match->substitutions += step->edit == MORSE_EDIT_SUBSTITUTE;
+            row--;
+            column--;
+        }
+        else if (column > 0 && cell(match, row, column - 1) + 1 == here)
+        {
+            step->edit = MORSE_EDIT_INSERT;
+            match->insertions++;
+            column--;
+        }
+        else
+        {
+            step->edit = MORSE_EDIT_DELETE;
+            match->deletions++;
+            row--;
+        }
+    }
+
+    // Put the steps in keying order
+    for (int i = 0; i < length / 2; i++)
+    {
+        struct morse_match_step swap = match->steps[i];
+        match->steps[i] = match->steps[length - 1 - i];
+        match->steps[length - 1 - i] = swap;
+    }
+    match->length = (uint8_t)length;
+    return match->distance;
+}
@@ -0,0 +1,109 @@
+#ifndef ASSIGN02_MORSE_MATCH_H
+#define ASSIGN02_MORSE_MATCH_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "morse.h"
+
+/*
+ * Edit distance between a keyed answer and its target, counted in
+ * symbols (dot, dash and the gap between letters), using the bit-parallel
+ * algorithm of Myers as described by Hyyrö: one 64-bit word holds a whole
+ * column of the distance matrix as +1/-1 deltas, so each keyed symbol
+ * costs a handful of shifts, adds and logic operations.
+ */
+#define MORSE_MATCH_MAX_SYMBOLS 64 // Symbols in one sequence, one bit each
+
+enum morse_symbol
+{
+    MORSE_SYMBOL_DOT,
+    MORSE_SYMBOL_DASH,
+    MORSE_SYMBOL_GAP,
+    MORSE_SYMBOL_COUNT
+};
+
+/*
+ * A sequence of symbols as one bit mask per symbol: bit i of mask[s] is
+ * set if symbol i is s. These are the match masks the algorithm needs.
+ */
+struct morse_symbols
+{
+    uint64_t mask[MORSE_SYMBOL_COUNT];
+    uint8_t length;
+    bool overflow;       // More than MORSE_MATCH_MAX_SYMBOLS were appended
+};
+
+enum morse_edit
+{
+    MORSE_EDIT_MATCH,
+    MORSE_EDIT_SUBSTITUTE, // Wrong symbol keyed
+    MORSE_EDIT_INSERT,     // Extra symbol keyed
+    MORSE_EDIT_DELETE      // Expected symbol missing
+};
+
+/*
+ * One column of the alignment of the keyed answer with its target
+ */
+struct morse_match_step
+{
+    uint8_t edit;      // enum morse_edit
+    uint8_t expected;  // enum morse_symbol, unused for MORSE_EDIT_INSERT
+    uint8_t keyed;     // enum morse_symbol, unused for MORSE_EDIT_DELETE
+};
+
+struct morse_match
+{
+    uint8_t distance;
+    uint8_t substitutions;
+    uint8_t insertions;
+    uint8_t deletions;
+    uint8_t length;    // Steps in the alignment
+    struct morse_match_step steps[2 * MORSE_MATCH_MAX_SYMBOLS];
+
+    // Vertical deltas of every column, kept for the traceback
+    uint64_t vp[MORSE_MATCH_MAX_SYMBOLS + 1];
+    uint64_t vn[MORSE_MATCH_MAX_SYMBOLS + 1];
+};
+
+/*
+ * Empties a symbol sequence
+ */
+void morse_symbols_clear(volatile struct morse_symbols *symbols);
+
+/*
+ * Appends a symbol. A gap is only kept between two elements, like a letter
+ * is only closed once it has an element.
+ */
+void morse_symbols_append(volatile struct morse_symbols *symbols, enum morse_symbol symbol);
+
+/*
+ * Converts a packed word code into its symbols
+ */
+void morse_symbols_from_word(struct morse_symbols *symbols, morse_word_t word);
+
+/*
+ * Returns the symbol at index
+ */
+static inline enum morse_symbol morse_symbol_at(const struct morse_symbols *symbols, int index)
+{
+    uint64_t bit = (uint64_t)1 << index;
+    return (symbols->mask[MORSE_SYMBOL_DASH] & bit) ? MORSE_SYMBOL_DASH
+         : (symbols->mask[MORSE_SYMBOL_GAP] & bit)  ? MORSE_SYMBOL_GAP
+                                                    : MORSE_SYMBOL_DOT;
+}
+
+/*
+ * Returns the edit distance from expected to keyed
+ */
+int morse_distance(const struct morse_symbols *expected, const struct morse_symbols *keyed);
+
+/*
+ * Aligns keyed with expected and counts each kind of edit.
+ * Returns the edit distance.
+ */
+int morse_match(const struct morse_symbols *expected, const struct morse_symbols *keyed, struct morse_match *match);
+
+#endif
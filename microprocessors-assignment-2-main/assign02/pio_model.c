@@ -0,0 +1,290 @@
+/*
+ * Import header files
+ */
+#include "pio_model.h"
+
+enum
+{
+    OP_JMP,
+    OP_WAIT,
+    OP_IN,
+    OP_OUT,
+    OP_PUSH_PULL,
+    OP_MOV,
+    OP_IRQ,
+    OP_SET
+};
+
+enum
+{
+    SRC_PINS,
+    SRC_X,
+    SRC_Y,
+    SRC_NULL,
+    SRC_STATUS = 5, // MOV only
+    SRC_ISR,
+    SRC_OSR
+};
+
+void pio_model_init(struct pio_model *sm, const uint16_t *program, uint8_t length, uint8_t wrap_target, uint8_t wrap)
+{
+    *sm = (struct pio_model){.program = program, .length = length, .wrap_target = wrap_target, .wrap = wrap};
+}
+
+bool pio_model_put(struct pio_model *sm, uint32_t value)
+{
+    if (sm->tx_count == PIO_MODEL_FIFO_DEPTH)
+    {
+        return false;
+    }
+    sm->tx[sm->tx_count++] = value;
+    return true;
+}
+
+bool pio_model_get(struct pio_model *sm, uint32_t *value)
+{
+    if (sm->rx_count == 0)
+    {
+        return false;
+    }
+    *value = sm->rx[0];
+    for (int i = 1; i < sm->rx_count; i++)
+    {
+        sm->rx[i - 1] = sm->rx[i];
+    }
+    sm->rx_count--;
+    return true;
+}
+
+static bool read_source(struct pio_model *sm, unsigned source, bool pin, uint32_t *value)
+{
+    switch (source)
+    {
+    case SRC_PINS:
+        *value = pin;
+        return true;
+    case SRC_X:
+        *value = sm->x;
+        return true;
+    case SRC_Y:
+        *value = sm->y;
+        return true;
+    case SRC_NULL:
+        *value = 0;
+        return true;
+    case SRC_ISR:
+        *value = sm->isr;
+        return true;
+    case SRC_OSR:
+        *value = sm->osr;
+        return true;
+    default:
+        sm->unsupported = true;
+        return false;
+    }
+}
+
+static bool jump_condition(struct pio_model *sm, unsigned condition, bool pin)
+{
+    bool taken;
+
+    switch (condition)
+    {
+    case 0:
+        return true;
+    case 1:
+        return sm->x == 0;
+    case 2:
+        // X-- and Y-- test the value before the decrement, and always decrement
+        taken = sm->x != 0;
+        sm->x--;
+        return taken;
+    case 3:
+        return sm->y == 0;
+    case 4:
+        taken = sm->y != 0;
+        sm->y--;
+        return taken;
+    case 5:
+        return sm->x != sm->y;
+    case 6:
+        return pin;
+    default:
+        return sm->osr == 0; // !OSRE, shift counts are not modelled
+    }
+}
+
+// Runs one instruction, returns false if it stalled
+static bool execute(struct pio_model *sm, uint16_t instruction, bool pin, uint8_t *next)
+{
+    unsigned opcode = instruction >> 13;
+    unsigned argument = instruction & 0x1F;
+    unsigned destination = (instruction >> 5) & 0x7;
+    uint32_t value;
+
+    switch (opcode)
+    {
+    case OP_JMP:
+        if (jump_condition(sm, destination, pin))
+        {
+            *next = (uint8_t)argument;
+        }
+        return true;
+
+    case OP_IN:
+    {
+        unsigned bits = argument == 0 ? 32 : argument;
+
+        if (!read_source(sm, destination, pin, &value))
+        {
+            return true;
+        }
+        value &= bits == 32 ? UINT32_MAX : (1u << bits) - 1;
+        // Shift direction is left (sm_config_set_in_shift(.., false, ..)), the only one modelled
+        sm->isr = bits == 32 ? value : (sm->isr << bits) | value;
+        sm->isr_count = (uint8_t)(sm->isr_count + bits > 32 ? 32 : sm->isr_count + bits);
+        return true;
+    }
+
+    case OP_PUSH_PULL:
+    {
+        bool pull = instruction & 0x80;
+        bool if_flag = instruction & 0x40;
+        bool block = instruction & 0x20;
+
+        if (if_flag)
+        {
+            sm->unsupported = true;
+            return true;
+        }
+        if (pull)
+        {
+            if (sm->tx_count == 0)
+            {
+                if (block)
+                {
+                    return false;
+                }
+                sm->osr = sm->x;
+                return true;
+            }
+            sm->osr = sm->tx[0];
+            for (int i = 1; i < sm->tx_count; i++)
+            {
+                sm->tx[i - 1] = sm->tx[i];
+            }
+            sm->tx_count--;
+            return true;
+        }
+        if (sm->rx_count == PIO_MODEL_FIFO_DEPTH)
+        {
+            if (block)
+            {
+                return false;
+            }
+            sm->rx_dropped++;
+        }
+        else
+        {
+            sm->rx[sm->rx_count++] = sm->isr;
+        }
+        sm->isr = 0;
+        sm->isr_count = 0;
+        return true;
+    }
+
+    case OP_MOV:
+    {
+        unsigned operation = (instruction >> 3) & 0x3;
+
+        if (!read_source(sm, instruction & 0x7, pin, &value))
+        {
+            return true;
+        }
+        if (operation == 1)
+        {
+            value = ~value;
+        }
+        else if (operation == 2)
+        {
+            uint32_t reversed = 0;
+            for (int i = 0; i < 32; i++)
+            {
+                reversed |= ((value >> i) & 1u) << (31 - i);
+            }
+            value = reversed;
+        }
+        switch (destination)
+        {
+        case SRC_X:
+            sm->x = value;
+            break;
+        case SRC_Y:
+            sm->y = value;
+            break;
+        case SRC_ISR:
+            sm->isr = value;
+            sm->isr_count = 0;
+            break;
+        case SRC_OSR:
+            sm->osr = value;
+            break;
+        default:
+            sm->unsupported = true;
+            break;
+        }
+        return true;
+    }
+
+    case OP_SET:
+        if (destination == SRC_X)
+        {
+            sm->x = argument;
+        }
+        else if (destination == SRC_Y)
+        {
+            sm->y = argument;
+        }
+        else
+        {
+            sm->unsupported = true;
+        }
+        return true;
+
+    default:
+        sm->unsupported = true;
+        return true;
+    }
+}
+
+void pio_model_step(struct pio_model *sm, bool pin)
+{
+    uint16_t instruction;
+    uint8_t next;
+
+    if (sm->unsupported)
+    {
+        return;
+    }
+    if (sm->delay > 0)
+    {
+        sm->delay--;
+        return;
+    }
+
+    if (sm->pc >= sm->length)
+    {
+        sm->unsupported = true;
+        return;
+    }
+    instruction = sm->program[sm->pc];
+    next = sm->pc == sm->wrap ? sm->wrap_target : (uint8_t)(sm->pc + 1);
+    sm->stalled = !execute(sm, instruction, pin, &next);
+    if (sm->stalled)
+    {
+        return;
+    }
+    // No side-set pins, so all five delay/side-set bits are delay
+    sm->delay = (instruction >> 8) & 0x1F;
+    sm->pc = next;
+}
@@ -0,0 +1,64 @@
+#ifndef ASSIGN02_PIO_MODEL_H
+#define ASSIGN02_PIO_MODEL_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Cycle-by-cycle software model of one PIO state machine running with a
+ * clock divider of 1, for checking programs such as button_timer (in
+ * assign02.pio) on a host against synthetic waveforms. It decodes the
+ * instruction words pioasm generates and covers JMP (every condition), IN,
+ * PUSH, PULL, MOV to X, Y, ISR and OSR, SET X/Y and per-instruction delays,
+ * with one input pin for JMP PIN and IN PINS. Side-set, OUT, WAIT, IRQ, the
+ * input synchroniser and autopush/autopull are not modelled: a program
+ * using them stops the model with unsupported set.
+ */
+
+#define PIO_MODEL_FIFO_DEPTH 4
+
+struct pio_model
+{
+    const uint16_t *program;  // Instructions, loaded at offset 0
+    uint8_t length;
+    uint8_t wrap_target;      // Where execution continues after the instruction at wrap
+    uint8_t wrap;
+
+    uint8_t pc;
+    uint8_t delay;            // Cycles left to stall after the last instruction
+    uint8_t isr_count;        // Bits shifted into the ISR since the last push
+    bool unsupported;         // Hit an instruction the model does not cover
+    bool stalled;             // The last cycle was spent waiting on a FIFO
+    uint32_t x, y, isr, osr;
+
+    uint32_t tx[PIO_MODEL_FIFO_DEPTH];
+    uint8_t tx_count;
+    uint32_t rx[PIO_MODEL_FIFO_DEPTH];
+    uint8_t rx_count;
+    uint32_t rx_dropped;      // Words lost to a PUSH NOBLOCK into a full RX FIFO
+};
+
+/*
+ * Resets the state machine to run program from its first instruction
+ */
+void pio_model_init(struct pio_model *sm, const uint16_t *program, uint8_t length, uint8_t wrap_target, uint8_t wrap);
+
+/*
+ * Writes a word to the TX FIFO, returns false if it is full
+ */
+bool pio_model_put(struct pio_model *sm, uint32_t value);
+
+/*
+ * Reads a word from the RX FIFO, returns false if it is empty
+ */
+bool pio_model_get(struct pio_model *sm, uint32_t *value);
+
+/*
+ * Runs one clock cycle with the input pin at level
+ */
+void pio_model_step(struct pio_model *sm, bool pin);
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * Import header files
+ */
+#include "rng.h"
+
+static uint32_t state[4];
+static uint32_t seed_value;
+
+static uint32_t rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+/*
+ * One SplitMix32 step, spreads a seed over the state words
+ */
+static uint32_t splitmix32(uint32_t *x)
+{
+    uint32_t z = (*x += 0x9E3779B9u);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+void rng_seed(uint32_t seed)
+{
+    uint32_t x = seed;
+
+    seed_value = seed;
+    for (int i = 0; i < 4; i++)
+    {
+        state[i] = splitmix32(&x);
+    }
+    // An all-zero state would only ever return zero
+    if ((state[0] | state[1] | state[2] | state[3]) == 0)
+    {
+        state[0] = 1;
+    }
+}
+
+uint32_t rng_get_seed(void)
+{
+    return seed_value;
+}
+
+uint32_t rng_next(void)
+{
+    uint32_t result = rotl(state[1] * 5u, 7) * 9u;
+    uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 11);
+    return result;
+}
+
+uint32_t rng_below(uint32_t bound)
+{
+    // Lemire's method: take the high word of a 64-bit product, and redraw
+    // only in the rare case the low word lands in the biased sliver
+    uint64_t product = (uint64_t)rng_next() * bound;
+    uint32_t low = (uint32_t)product;
+
+    if (low < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            product = (uint64_t)rng_next() * bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
@@ -0,0 +1,36 @@
+#ifndef ASSIGN02_RNG_H
+#define ASSIGN02_RNG_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+
+/*
+ * xoshiro128** pseudo-random generator (Blackman and Vigna): 128 bits of
+ * state, a few shifts, rotates and one multiply per 32-bit output. The
+ * state is expanded from a 32-bit seed with SplitMix32, so a session can
+ * be replayed from the seed alone.
+ */
+
+/*
+ * Restarts the generator from seed
+ */
+void rng_seed(uint32_t seed);
+
+/*
+ * Returns the seed the generator was last started from
+ */
+uint32_t rng_get_seed(void);
+
+/*
+ * Returns 32 random bits
+ */
+uint32_t rng_next(void);
+
+/*
+ * Returns a random number below bound (bound > 0) without modulo bias
+ */
+uint32_t rng_below(uint32_t bound);
+
+#endif
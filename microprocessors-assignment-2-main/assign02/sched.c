@@ -0,0 +1,193 @@
+/*
+ * Import header files
+ */
+#include <stddef.h>
+#include "sched.h"
+#if ASSIGN02_SCHED_WFE
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#endif
+
+#define SCHED_ALARM 0 // ALARM0, its interrupt only wakes the core (alarm_isr in assign02.S)
+
+volatile uint8_t sched_pending[SCHED_EVENTS];
+
+static sched_handler handlers[SCHED_EVENTS];
+static uint64_t post_time[SCHED_EVENTS]; // Valid while the event's bit is in timed
+static uint8_t timed;
+static struct sched_stats stats;
+#if !ASSIGN02_SCHED_WFE
+static uint64_t virtual_us;
+#endif
+
+_Static_assert(SCHED_EVENTS <= 8, "timed holds a bit per event");
+
+void sched_init(void)
+{
+    for (int event = 0; event < SCHED_EVENTS; event++)
+    {
+        sched_pending[event] = 0;
+        handlers[event] = NULL;
+    }
+    timed = 0;
+}
+
+void sched_handle(enum sched_event event, sched_handler handler)
+{
+    handlers[event] = handler;
+}
+
+void sched_post_at(enum sched_event event, uint64_t when)
+{
+    post_time[event] = when;
+    timed |= 1u << event;
+}
+
+void sched_cancel(enum sched_event event)
+{
+    timed &= ~(1u << event);
+}
+
+void sched_get_stats(struct sched_stats *copy)
+{
+    *copy = stats;
+}
+
+#if ASSIGN02_SCHED_WFE
+
+uint64_t sched_now(void)
+{
+    return time_us_64();
+}
+
+static bool any_pending(void)
+{
+    for (int event = 0; event < SCHED_EVENTS; event++)
+    {
+        if (sched_pending[event])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sleeps until an event is flagged or wake_us comes round
+static bool sleep_until(bool armed, uint64_t wake_us)
+{
+    if (!armed)
+    {
+        hw_clear_bits(&timer_hw->inte, 1u << SCHED_ALARM);
+    }
+    else
+    {
+        // ALARM0 only compares the low 32 bits, a time that has already passed would not fire for 71 minutes
+        timer_hw->alarm[SCHED_ALARM] = (uint32_t)wake_us;
+        hw_set_bits(&timer_hw->inte, 1u << SCHED_ALARM);
+        if (time_us_64() >= wake_us)
+        {
+            return true;
+        }
+    }
+
+    stats.sleeps++;
+    // Any interrupt wakes wfe, those that set no flag (USB, the alarm early) just go back to sleep
+    while (!any_pending() && (!armed || time_us_64() < wake_us))
+    {
+        __wfe();
+    }
+    return true;
+}
+
+#else
+
+uint64_t sched_now(void)
+{
+    return virtual_us;
+}
+
+void sched_set_time(uint64_t now)
+{
+    virtual_us = now;
+}
+
+// Nothing interrupts a host, so sleeping is jumping the clock to the next time asked for
+static bool sleep_until(bool armed, uint64_t wake_us)
+{
+    if (!armed)
+    {
+        return false;
+    }
+    stats.sleeps++;
+    if (virtual_us < wake_us)
+    {
+        virtual_us = wake_us;
+    }
+    return true;
+}
+
+#endif
+
+bool sched_run(bool (*done)(void))
+{
+    uint64_t now;
+    uint64_t wake_us = 0;
+    bool armed;
+    bool handled;
+
+    while (1)
+    {
+        now = sched_now();
+        for (int event = 0; event < SCHED_EVENTS; event++)
+        {
+            if ((timed & (1u << event)) && post_time[event] <= now)
+            {
+                timed &= ~(1u << event);
+                sched_pending[event] = 1;
+                if (now - post_time[event] > stats.worst_late_us)
+                {
+                    stats.worst_late_us = (uint32_t)(now - post_time[event]);
+                }
+            }
+        }
+
+        handled = false;
+        for (int event = 0; event < SCHED_EVENTS; event++)
+        {
+            if (sched_pending[event])
+            {
+                // Cleared first, so a post while the handler runs calls it again
+                sched_pending[event] = 0;
+                if (handlers[event] != NULL)
+                {
+                    handlers[event]();
+                    stats.handled++;
+                }
+                handled = true;
+            }
+        }
+        if (done())
+        {
+            return true;
+        }
+        if (handled)
+        {
+            continue;
+        }
+
+        armed = false;
+        for (int event = 0; event < SCHED_EVENTS; event++)
+        {
+            if ((timed & (1u << event)) && (!armed || post_time[event] < wake_us))
+            {
+                wake_us = post_time[event];
+                armed = true;
+            }
+        }
+        if (!sleep_until(armed, wake_us))
+        {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef ASSIGN02_SCHED_H
+#define ASSIGN02_SCHED_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Cooperative, tickless scheduler for the main loop. Work comes as event
+ * flags, set by the interrupt handlers (sched_post()) or by a time asked
+ * for with sched_post_at() coming round. sched_run() calls the handler of
+ * each flag that is set, in the order of enum sched_event, and otherwise
+ * sleeps: ALARM0 is pointed at the earliest time asked for and the core
+ * waits in wfe. A flag set by an interrupt after the scheduler has looked
+ * also sets the event register, so wfe returns at once and no event waits
+ * for the next interrupt. How long a change takes to be seen is then the
+ * interrupt and handler latency, not a polling period.
+ *
+ * Each flag is a byte of its own, written whole by the interrupts and
+ * cleared by sched_run() before the handler runs, so no read-modify-write
+ * has to be protected: a handler drains everything its event stands for.
+ *
+ * Built without ASSIGN02_SCHED_WFE (on a host) the scheduler runs on a
+ * virtual clock instead, which sleeping moves straight to the next time
+ * asked for. tests/test_sched.c runs it that way. The wake-up and reaction
+ * latency on the board have not been measured; worst_late_us in the stats
+ * is the one figure the firmware keeps.
+ */
+
+enum sched_event
+{
+    SCHED_INPUT,    // Key edges, lever changes or audio blocks to read
+    SCHED_TIMEOUT,  // Session deadlines have come due
+    SCHED_LED,      // The LED has a new frame to show
+    SCHED_CONSOLE,  // Characters are waiting on the console
+    SCHED_EVENTS
+};
+
+typedef void (*sched_handler)(void);
+
+struct sched_stats
+{
+    uint32_t sleeps;        // Times the core went to sleep with nothing to do
+    uint32_t handled;       // Handler calls
+    uint32_t worst_late_us; // Longest a timed event was handled after its time
+};
+
+extern volatile uint8_t sched_pending[SCHED_EVENTS]; // Non-zero while the event waits for its handler, gpio_isr sets SCHED_INPUT
+
+/*
+ * Forgets every handler, flag and time asked for
+ */
+void sched_init(void);
+
+/*
+ * Sets the function sched_run() calls for event
+ */
+void sched_handle(enum sched_event event, sched_handler handler);
+
+/*
+ * Flags event, safe from interrupts
+ */
+static inline void sched_post(enum sched_event event)
+{
+    sched_pending[event] = 1;
+}
+
+/*
+ * Flags event at time when, replacing any time asked for it before
+ */
+void sched_post_at(enum sched_event event, uint64_t when);
+
+/*
+ * Forgets the time asked for event, a flag already set stays set
+ */
+void sched_cancel(enum sched_event event);
+
+/*
+ * Handles events, sleeping in between, until done returns true after a
+ * round of handlers. Returns false without waiting if nothing could ever
+ * wake it (only possible on the virtual clock).
+ */
+bool sched_run(bool (*done)(void));
+
+/*
+ * Returns the scheduler's clock in microseconds
+ */
+uint64_t sched_now(void);
+
+/*
+ * Copies the scheduler's counters
+ */
+void sched_get_stats(struct sched_stats *stats);
+
+#if !ASSIGN02_SCHED_WFE
+/*
+ * Sets the virtual clock
+ */
+void sched_set_time(uint64_t now);
+#endif
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Import header files
+ */
+#include "session.h"
+
+void session_init(struct session *session, unsigned wpm)
+{
+    keying_init(&session->keying, wpm);
+    timeout_clear(&session->timeouts);
+    morse_input_reset(&session->input);
+    morse_symbols_clear(&session->symbols);
+    morse_beam_input_clear(&session->marks);
+    morse_decoder_start(&session->decoder, MORSE_WORD_EMPTY);
+    word_verifier_start(&session->verifier, NULL);
+    session->key_down = false;
+    session->element_keyed = false;
+    session->letter_closed = false;
+    session->widths_timed = false;
+    session->wins = 0;
+    session->losses = 0;
+    session->streak = 0;
+}
+
+void session_start(struct session *session, morse_word_t target, const char *word, uint64_t now, bool idle_timeout)
+{
+    morse_input_reset(&session->input);
+    morse_symbols_clear(&session->symbols);
+    morse_beam_input_clear(&session->marks);
+    morse_decoder_start(&session->decoder, target);
+    word_verifier_start(&session->verifier, word);
+    session->key_down = false;
+    session->element_keyed = false;
+    session->letter_closed = false;
+    timeout_clear(&session->timeouts);
+    if (idle_timeout)
+    {
+        timeout_arm(&session->timeouts, TIMEOUT_END, now + SESSION_IDLE_TIMEOUT_US);
+    }
+}
+
+void session_input(struct session *session, int case_received)
+{
+    switch (case_received)
+    {
+    case 0:
+        morse_input_element(&session->input, false);
+        morse_symbols_append(&session->symbols, MORSE_SYMBOL_DOT);
+        morse_beam_input_mark(&session->marks, false);
+        morse_decoder_element(&session->decoder, false);
+        word_verifier_element(&session->verifier, false);
+        break;
+    case 1:
+        morse_input_element(&session->input, true);
+        morse_symbols_append(&session->symbols, MORSE_SYMBOL_DASH);
+        morse_beam_input_mark(&session->marks, true);
+        morse_decoder_element(&session->decoder, true);
+        word_verifier_element(&session->verifier, true);
+        break;
+    case 2:
+        morse_input_gap(&session->input);
+        morse_symbols_append(&session->symbols, MORSE_SYMBOL_GAP);
+        morse_beam_input_gap(&session->marks, MORSE_BEAM_LETTER_GAP);
+        morse_decoder_gap(&session->decoder);
+        word_verifier_gap(&session->verifier);
+        break;
+    case 3:
+        morse_input_end(&session->input);
+        morse_decoder_end(&session->decoder);
+        word_verifier_end(&session->verifier);
+        break;
+    }
+}
+
+/*
+ * Converts a gap to MORSE_BEAM_UNIT fixed point at the key's current speed
+ */
+static uint16_t beam_gap(const struct session *session, uint32_t width_us)
+{
+    uint64_t gap = (uint64_t)width_us * MORSE_BEAM_UNIT / session->keying.unit_us;
+    return gap < UINT16_MAX ? (uint16_t)gap : UINT16_MAX;
+}
+
+void session_width(struct session *session, bool pressed, uint32_t width_us)
+{
+    // Widths the PIO timed after the answer ended are not part of it
+    if (session->input.complete)
+    {
+        return;
+    }
+    if (pressed)
+    {
+        session_input(session, keying_mark(&session->keying, width_us) ? 1 : 0);
+        session->element_keyed = true;
+    }
+    else if (session->element_keyed)
+    {
+        // Answers are single words, so a word gap is only a long letter gap
+        if (keying_gap(&session->keying, width_us) != KEYING_GAP_ELEMENT && !session->letter_closed)
+        {
+            session_input(session, 2);
+        }
+        // The beam search weighs every gap by its length, not by the class it was given above
+        morse_beam_input_gap(&session->marks, beam_gap(session, width_us));
+        session->letter_closed = false;
+    }
+}
+
+void session_edge(struct session *session, const struct edge_event *edge)
+{
+    // A finished answer ignores the key until the next one starts
+    if (session->input.complete)
+    {
+        return;
+    }
+    if (!session->widths_timed)
+    {
+        if (edge->type == EDGE_PRESSED && !session->key_down)
+        {
+            // The first press of an answer has no gap before it
+            if (session->element_keyed)
+            {
+                session_width(session, false, (uint32_t)(edge->time_us - session->release_time));
+            }
+            session->press_time = edge->time_us;
+            session->key_down = true;
+        }
+        else if (edge->type == EDGE_RELEASED && session->key_down)
+        {
+            session_width(session, true, (uint32_t)(edge->time_us - session->press_time));
+            session->release_time = edge->time_us;
+            session->key_down = false;
+        }
+        // Anything else pairs with an edge that was dropped or discarded
+    }
+
+    // After the classification above, so the gaps are timed with the latest speed
+    if (edge->type == EDGE_PRESSED)
+    {
+        timeout_cancel(&session->timeouts, TIMEOUT_LETTER);
+        timeout_cancel(&session->timeouts, TIMEOUT_WORD);
+        timeout_arm(&session->timeouts, TIMEOUT_END, edge->time_us + SESSION_IDLE_TIMEOUT_US);
+    }
+    else
+    {
+        timeout_cancel(&session->timeouts, TIMEOUT_END);
+        timeout_arm(&session->timeouts, TIMEOUT_LETTER,
+                    edge->time_us + SESSION_LETTER_TIMEOUT_UNITS * session->keying.unit_us);
+        timeout_arm(&session->timeouts, TIMEOUT_WORD,
+                    edge->time_us + SESSION_WORD_TIMEOUT_UNITS * session->keying.unit_us);
+    }
+}
+
+unsigned session_expire(struct session *session, uint64_t now)
+{
+    unsigned due = timeout_expire(&session->timeouts, now);
+
+    if ((due & TIMEOUT_BIT(TIMEOUT_LETTER)) && !session->letter_closed)
+    {
+        // Feed the gap now rather than when the next letter starts, so the answer is checked as it goes
+        session_input(session, 2);
+        session->letter_closed = true;
+    }
+    if (due & (TIMEOUT_BIT(TIMEOUT_WORD) | TIMEOUT_BIT(TIMEOUT_END)))
+    {
+        session_input(session, 3);
+        timeout_clear(&session->timeouts);
+    }
+    return due;
+}
+
+bool session_done(const struct session *session, unsigned tolerance)
+{
+    // Closing the last letter of the target ends the answer without waiting for the word timeout
+    if (session->input.complete || session->decoder.verdict == MORSE_ACCEPTED ||
+        session->verifier.verdict == MORSE_ACCEPTED)
+    {
+        return true;
+    }
+    // So does a wrong element, unless a tolerance is set and the whole answer has to be scored
+    return tolerance == 0 && (session->decoder.verdict == MORSE_REJECTED || session->verifier.verdict == MORSE_REJECTED);
+}
+
+bool session_busy(const struct session *session, unsigned tolerance)
+{
+    return (session->element_keyed || session->key_down) && !session_done(session, tolerance);
+}
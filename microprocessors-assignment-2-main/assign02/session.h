@@ -0,0 +1,110 @@
+#ifndef ASSIGN02_SESSION_H
+#define ASSIGN02_SESSION_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "morse.h"
+#include "morse_decoder.h"
+#include "word_verifier.h"
+#include "morse_match.h"
+#include "morse_beam.h"
+#include "edge_ring.h"
+#include "keying.h"
+#include "timeout.h"
+
+/*
+ * Everything one key needs to answer a challenge: the edges turned into
+ * dots, dashes and gaps at the speed learnt for that key, the gap and end
+ * of transmission timeouts, the answer as it is checked and the key's
+ * score. Sessions share nothing, so any number can be keyed at once and
+ * the work per edge does not depend on how many there are.
+ *
+ * Nothing here touches the hardware. The caller feeds in edges (or widths
+ * timed elsewhere, such as by the PIO) and the time, and points ALARM0 at
+ * the earliest session_next() of all the sessions.
+ */
+
+#define SESSION_LETTER_TIMEOUT_UNITS 2  // A gap this long ends the letter
+#define SESSION_WORD_TIMEOUT_UNITS 7    // A gap this long (one word gap) ends the answer
+#define SESSION_IDLE_TIMEOUT_US 2000000 // Ends the answer if nothing is keyed, or the key is held, this long
+
+struct session
+{
+    struct morse_input input;          // Answer keyed so far
+    struct morse_decoder decoder;      // Checks a character answer while it is keyed
+    struct word_verifier verifier;     // Checks a word answer letter by letter
+    struct morse_symbols symbols;      // Every symbol keyed, for scoring a wrong answer
+    struct morse_beam_input marks;     // Marks and gaps keyed, for reading a word with misjudged gaps
+    struct keying keying;              // Learns this key's speed from its presses and gaps
+    struct timeout_service timeouts;   // Gap and end of transmission deadlines
+    uint64_t press_time;               // When the key last went down
+    uint64_t release_time;             // When the key last came up
+    bool key_down;                     // Between a press and its release
+    bool element_keyed;                // A dot or dash has been keyed since the answer started
+    bool letter_closed;                // TIMEOUT_LETTER has fed the gap after the last letter
+    bool widths_timed;                 // Widths come from session_width(), edges only drive the timeouts
+    uint16_t wins;                     // Answers scored right and wrong
+    uint16_t losses;
+    uint16_t streak;                   // Right answers in a row
+};
+
+/*
+ * Sets up a session with no answer started, assuming wpm until the key's
+ * own speed is learnt
+ */
+void session_init(struct session *session, unsigned wpm);
+
+/*
+ * Starts an answer for target (a character, word is NULL) or word. With
+ * idle_timeout the answer ends if nothing is keyed by SESSION_IDLE_TIMEOUT_US
+ * after now, without it the session waits until the key is first pressed.
+ */
+void session_start(struct session *session, morse_word_t target, const char *word, uint64_t now, bool idle_timeout);
+
+/*
+ * Adds a dot (0), dash (1), letter gap (2) or end of transmission (3) to the
+ * answer. A letter gap counts as exactly 3 units for the beam search unless
+ * session_width() measures it.
+ */
+void session_input(struct session *session, int case_received);
+
+/*
+ * Classifies one press (a dot or dash) or gap (a letter gap or not) of the
+ * given length. Does nothing once the answer is complete.
+ */
+void session_width(struct session *session, bool pressed, uint32_t width_us);
+
+/*
+ * Takes one edge of the session's key, in the order they happened
+ */
+void session_edge(struct session *session, const struct edge_event *edge);
+
+/*
+ * Acts on the timeouts due at now and returns them as TIMEOUT_BIT()s,
+ * TIMEOUT_KEYER is only returned for the caller to act on
+ */
+unsigned session_expire(struct session *session, uint64_t now);
+
+/*
+ * Gives the session's earliest deadline, returns false if nothing is armed
+ */
+static inline bool session_next(const struct session *session, uint64_t *deadline)
+{
+    return timeout_next(&session->timeouts, deadline);
+}
+
+/*
+ * Returns true once the answer can be checked: it is complete, or it has
+ * already been accepted, or (at tolerance 0) rejected
+ */
+bool session_done(const struct session *session, unsigned tolerance);
+
+/*
+ * Returns true while an answer is being keyed and is not done
+ */
+bool session_busy(const struct session *session, unsigned tolerance);
+
+#endif
@@ -0,0 +1,50 @@
+/*
+ * Import header files
+ */
+#include "timeout.h"
+
+void timeout_clear(struct timeout_service *service)
+{
+    service->armed = 0;
+}
+
+void timeout_arm(struct timeout_service *service, enum timeout_kind kind, uint64_t deadline)
+{
+    service->deadline[kind] = deadline;
+    service->armed |= TIMEOUT_BIT(kind);
+}
+
+void timeout_cancel(struct timeout_service *service, enum timeout_kind kind)
+{
+    service->armed &= ~TIMEOUT_BIT(kind);
+}
+
+unsigned timeout_expire(struct timeout_service *service, uint64_t now)
+{
+    unsigned due = 0;
+
+    for (int kind = 0; kind < TIMEOUT_KINDS; kind++)
+    {
+        if ((service->armed & TIMEOUT_BIT(kind)) && service->deadline[kind] <= now)
+        {
+            due |= TIMEOUT_BIT(kind);
+        }
+    }
+    service->armed &= ~due;
+    return due;
+}
+
+bool timeout_next(const struct timeout_service *service, uint64_t *deadline)
+{
+    bool found = false;
+
+    for (int kind = 0; kind < TIMEOUT_KINDS; kind++)
+    {
+        if ((service->armed & TIMEOUT_BIT(kind)) && (!found || service->deadline[kind] < *deadline))
+        {
+            *deadline = service->deadline[kind];
+            found = true;
+        }
+    }
+    return found;
+}
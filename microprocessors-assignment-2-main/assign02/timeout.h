@@ -0,0 +1,59 @@
+#ifndef ASSIGN02_TIMEOUT_H
+#define ASSIGN02_TIMEOUT_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Several deadlines in flight on one hardware alarm. The service only does
+ * the bookkeeping against a clock it is given, so it runs the same on a
+ * host under a virtual clock: the caller points ALARM0 at timeout_next()
+ * and calls timeout_expire() with the time whenever it wakes.
+ */
+
+enum timeout_kind
+{
+    TIMEOUT_LETTER, // The gap after an element has outgrown a gap within a letter
+    TIMEOUT_WORD,   // The gap has lasted a whole word gap, the answer is over
+    TIMEOUT_END,    // Nothing keyed for too long, end of transmission
+    TIMEOUT_KEYER,  // The paddle keyer's next element edge
+    TIMEOUT_KINDS
+};
+
+#define TIMEOUT_BIT(kind) (1u << (kind))
+
+struct timeout_service
+{
+    uint64_t deadline[TIMEOUT_KINDS]; // Microseconds, valid while the kind's bit is in armed
+    uint8_t armed;
+};
+
+/*
+ * Cancels every timeout
+ */
+void timeout_clear(struct timeout_service *service);
+
+/*
+ * Arms kind to expire at deadline, replacing any earlier deadline for it
+ */
+void timeout_arm(struct timeout_service *service, enum timeout_kind kind, uint64_t deadline);
+
+/*
+ * Cancels kind if it is armed
+ */
+void timeout_cancel(struct timeout_service *service, enum timeout_kind kind);
+
+/*
+ * Disarms every timeout due at now and returns them as TIMEOUT_BIT()s
+ */
+unsigned timeout_expire(struct timeout_service *service, uint64_t now);
+
+/*
+ * Gives the earliest armed deadline, returns false if nothing is armed
+ */
+bool timeout_next(const struct timeout_service *service, uint64_t *deadline);
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Import header files
+ */
+#include "tone.h"
+
+#define TONE_Q 14
+#define TONE_ANGLE_Q 28
+#define TONE_TWO_PI 1686629713LL // 2 pi in Q28
+#define TONE_SAMPLE_SHIFT 3      // Keeps the filter state within 32 bits
+#define TONE_BLOCK_SHIFT 6       // log2(TONE_BLOCK_SAMPLES)
+
+_Static_assert(TONE_BLOCK_SAMPLES == 1 << TONE_BLOCK_SHIFT, "TONE_BLOCK_SHIFT");
+
+// cos(angle) with angle in Q28 from 0 to pi, by its Taylor series: only used when tuning, so no table
+static int64_t fixed_cos(int64_t angle)
+{
+    int64_t square = (angle * angle) >> TONE_ANGLE_Q;
+    int64_t term = 1LL << TONE_ANGLE_Q;
+    int64_t sum = term;
+
+    for (int k = 1; term != 0; k++)
+    {
+        term = -((term * square) >> TONE_ANGLE_Q) / ((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// 256 log2(power): the exponent, then the 8 bits after the leading one as a straight-line fraction
+static int32_t log2_level(uint64_t power)
+{
+    int exponent = 63;
+
+    if (power == 0)
+    {
+        return 0;
+    }
+    while ((power >> exponent) == 0)
+    {
+        exponent--;
+    }
+    return exponent * 256 + (int32_t)(((power << (63 - exponent)) >> 55) & 0xFF);
+}
+
+void tone_init(struct tone_detector *detector, uint32_t sample_hz, uint32_t tone_hz)
+{
+    int64_t angle = TONE_TWO_PI * tone_hz / sample_hz;
+
+    detector->coeff = (int32_t)((2 * fixed_cos(angle)) >> (TONE_ANGLE_Q - TONE_Q));
+    detector->level = 0;
+    detector->noise = 0;
+    detector->signal = 0;
+    detector->confirm = 0;
+    detector->primed = 0;
+    detector->on = false;
+}
+
+int32_t tone_level(const struct tone_detector *detector, const uint16_t *samples)
+{
+    uint32_t sum = 0;
+    int32_t mean;
+    int32_t s1 = 0;
+    int32_t s2 = 0;
+    int64_t power;
+
+    // Taking off the block's own mean removes the ADC's DC offset exactly
+    for (int i = 0; i < TONE_BLOCK_SAMPLES; i++)
+    {
+        sum += samples[i];
+    }
+    mean = (int32_t)(sum >> TONE_BLOCK_SHIFT);
+
+    for (int i = 0; i < TONE_BLOCK_SAMPLES; i++)
+    {
+        int32_t s0 = ((samples[i] - mean) >> TONE_SAMPLE_SHIFT) + ((detector->coeff * s1) >> TONE_Q) - s2;
+        s2 = s1;
+        s1 = s0;
+    }
+
+    // |X|^2 = s1^2 + s2^2 - coeff s1 s2, once a block so 64 bits are affordable
+    power = (int64_t)s1 * s1 + (int64_t)s2 * s2 - (((int64_t)detector->coeff * s1) >> TONE_Q) * s2;
+    return log2_level(power > 0 ? (uint64_t)power : 0);
+}
+
+bool tone_block(struct tone_detector *detector, const uint16_t *samples)
+{
+    int32_t level = tone_level(detector, samples);
+    int32_t threshold;
+    bool was_on = detector->on;
+
+    detector->level = level;
+    if (detector->primed < TONE_PRIME_BLOCKS)
+    {
+        // The noise floor starts as the mean of the first blocks, one block swings too far
+        detector->noise += (level - detector->noise) / ++detector->primed;
+        detector->signal = detector->noise + TONE_MIN_SNR;
+        return false;
+    }
+
+    if (detector->on)
+    {
+        detector->signal += (level - detector->signal) / 4;
+        // Creeps up meanwhile, so noise mistaken for a tone is let go of within a second or two
+        detector->noise += (level - detector->noise) / 256;
+    }
+    else
+    {
+        detector->noise += (level - detector->noise) / 16;
+        // A tone that has gone quiet is forgotten over a couple of hundred blocks
+        detector->signal -= (detector->signal - detector->noise) / 256;
+    }
+    if (detector->signal < detector->noise + TONE_MIN_SNR)
+    {
+        detector->signal = detector->noise + TONE_MIN_SNR;
+    }
+
+    threshold = (detector->noise + detector->signal) / 2;
+    if (detector->on ? level < threshold - TONE_HYSTERESIS : level > threshold + TONE_HYSTERESIS)
+    {
+        if (++detector->confirm == TONE_CONFIRM_BLOCKS)
+        {
+            detector->on = !detector->on;
+            detector->confirm = 0;
+        }
+    }
+    else
+    {
+        detector->confirm = 0;
+    }
+    return detector->on != was_on;
+}
@@ -0,0 +1,68 @@
+#ifndef ASSIGN02_TONE_H
+#define ASSIGN02_TONE_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Tone detector for keying from a practice oscillator or a radio. Each
+ * block of TONE_BLOCK_SAMPLES ADC samples has its mean taken off and is run
+ * through a Goertzel filter tuned to the tone, which gives the power at
+ * that one frequency for a multiply and two adds a sample. It is all fixed
+ * point, as the Cortex-M0+ has no FPU: the filter coefficient is Q14 and
+ * the state stays within 32 bits for 12-bit samples and tones from 300 Hz.
+ *
+ * Whether the tone is on is decided on the block's power in log2 steps of
+ * 1/256 octave (about 0.012 dB), against a threshold halfway between the
+ * noise floor and the tone level, both learnt as the blocks come in. The
+ * power of one bin of noise swings by several dB from block to block, so
+ * the tone level is kept at least TONE_MIN_SNR above the noise, and the
+ * state only changes once TONE_CONFIRM_BLOCKS blocks in a row are
+ * TONE_HYSTERESIS past the threshold. A fading or noisy signal then does
+ * not chatter, and the change is dated from the first of those blocks.
+ *
+ * Nothing here touches the hardware, so the detector runs the same on a
+ * host fed from a recording.
+ */
+
+#define TONE_BLOCK_SAMPLES 64  // Samples a decision is made on
+#define TONE_MIN_HZ 300        // Lowest tone the fixed point is sized for
+#define TONE_LEVEL_DB 85       // Level steps in 1 dB
+#define TONE_MIN_SNR (18 * TONE_LEVEL_DB)
+#define TONE_HYSTERESIS (3 * TONE_LEVEL_DB / 2)
+#define TONE_CONFIRM_BLOCKS 2  // Blocks past the threshold before the state changes
+#define TONE_PRIME_BLOCKS 8    // Blocks taken as noise before any tone is looked for
+
+struct tone_detector
+{
+    int32_t coeff;   // 2 cos(2 pi f / fs), Q14
+    int32_t level;   // Power of the last block, 1/256 octave steps
+    int32_t noise;   // Learnt level with the tone off
+    int32_t signal;  // Learnt level with the tone on
+    uint8_t confirm; // Blocks in a row that disagree with on
+    uint8_t primed;  // Blocks the noise floor has been set from, up to TONE_PRIME_BLOCKS
+    bool on;         // Tone present
+};
+
+/*
+ * Tunes the detector to tone_hz at sample_hz and forgets the levels
+ */
+void tone_init(struct tone_detector *detector, uint32_t sample_hz, uint32_t tone_hz);
+
+/*
+ * Returns the tone power in a block of TONE_BLOCK_SAMPLES 12-bit samples,
+ * in 1/256 octave steps
+ */
+int32_t tone_level(const struct tone_detector *detector, const uint16_t *samples);
+
+/*
+ * Decides on the next block, returns true if the tone has just come on or
+ * gone off (detector->on says which). The change happened at the start of
+ * the block TONE_CONFIRM_BLOCKS - 1 blocks before this one.
+ */
+bool tone_block(struct tone_detector *detector, const uint16_t *samples);
+
+#endif
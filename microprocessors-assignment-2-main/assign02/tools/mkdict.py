@@ -0,0 +1,318 @@
+#!/usr/bin/env python3
+"""
+Builds the word dictionary for levels 3 and 4.
+
+The dictionary is either read from a word list (one word per line, most
+important first) or ranked by frequency from any number of text corpora,
+which are split into chunks and counted in parallel.
+
+The output is one binary file that is used where it lies, with no parse
+step: the firmware links it in with .incbin (dictionary_blob.S) and a host
+build can mmap() it (dictionary_mmap.c). All values are little endian,
+offsets are from the start of the file and every section is 8-byte aligned:
+
+    header              19 x uint32, see struct dictionary_header
+    block index         uint32[block_count + 1], offset of each block
+    blocks              sorted words, front-coded in BLOCK_SIZE word blocks
+    hash displacements  uint16[hash_buckets]
+    hash slots          uint16[word_count], word index stored at each slot
+    duration starts     uint16[max_duration + 2], first position per duration
+    duration words      uint16[word_count], word indices sorted by duration
+    morse               uint64[word_count], packed code of each word
+    units               uint8[word_count], duration of each word in dot units
+    rank                uint16[word_count], word indices, most frequent first
+    search keys         uint64[block_count + 1], Eytzinger-ordered block keys
+    search blocks       uint16[block_count + 1], block number of each key
+    match keys          uint64[word_count], packed code with the first letter in bits 54-59
+
+Each block starts with one full word, followed by words stored as
+(shared prefix length << 4 | suffix length, suffix), so reading any word
+decodes at most one block. The hash sections are a minimal perfect hash
+(hash and displace) for one-probe lookup by text. The search keys are the
+first 8 characters of each block's first word, big endian, laid out in
+Eytzinger (breadth-first) order so an ordered search walks the array
+front to back. The match keys are the morse column again, shifted so all
+words line up at their first letter for morse_batch.c.
+
+Usage:
+    mkdict.py --words words.txt -o dictionary.bin
+    mkdict.py [-j JOBS] [--top N] [--min-count N] corpus.txt... -o dictionary.bin
+"""
+
+import argparse
+import collections
+import multiprocessing
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x4349444D         # "MDIC"
+VERSION = 3
+BLOCK_SIZE = 16
+HEADER_WORDS = 19
+CHUNK_SIZE = 8 << 20       # Bytes of corpus per worker task
+
+FNV_OFFSET = 2166136261
+FNV_PRIME = 16777619
+MASK32 = 0xFFFFFFFF
+
+MORSE = {
+    'a': '.-', 'b': '-...', 'c': '-.-.', 'd': '-..', 'e': '.', 'f': '..-.',
+    'g': '--.', 'h': '....', 'i': '..', 'j': '.---', 'k': '-.-', 'l': '.-..',
+    'm': '--', 'n': '-.', 'o': '---', 'p': '.--.', 'q': '--.-', 'r': '.-.',
+    's': '...', 't': '-', 'u': '..-', 'v': '...-', 'w': '.--', 'x': '-..-',
+    'y': '-.--', 'z': '--..', '0': '-----', '1': '.----', '2': '..---',
+    '3': '...--', '4': '....-', '5': '.....', '6': '-....', '7': '--...',
+    '8': '---..', '9': '----.',
+}
+
+MAX_LETTERS = 10           # MORSE_WORD_MAX_LETTERS
+FIELD_BITS = 6             # MORSE_FIELD_BITS
+MAX_WORDS = 0xFFFF         # Word indices are stored as uint16
+MAX_DISPLACEMENT = 0xFFFF
+TOKEN = re.compile(rb'[a-z0-9]+')
+
+
+def word_hash(word, seed):
+    """Must match word_hash() in word_hash.h"""
+    h = (FNV_OFFSET ^ seed) & MASK32
+    for b in word.encode('ascii'):
+        h ^= b
+        h = (h * FNV_PRIME) & MASK32
+    return h
+
+
+def hash_slot(h, n):
+    """Must match hash_slot() in dictionary.c"""
+    return (h ^ (h >> 16)) % n
+
+
+def morse_word(word):
+    """Packed word code, see morse_word_t in morse.h"""
+    packed = 0
+    for letter in word:
+        code = 1
+        for element in MORSE[letter]:
+            code = (code << 1) | (1 if element == '-' else 0)
+        packed = (packed << FIELD_BITS) | code
+    return packed
+
+
+def morse_duration(word):
+    """Length of word in dot units, must match morse_duration() in morse.c"""
+    units = 0
+    for letter in word:
+        code = MORSE[letter]
+        units += sum(3 if e == '-' else 1 for e in code) + len(code) - 1
+    return units + 3 * (len(word) - 1)
+
+
+def match_key(word):
+    """Packed code aligned at the first letter, see morse_batch_word_key() in morse_batch.h"""
+    return morse_word(word) << (FIELD_BITS * (MAX_LETTERS - len(word)))
+
+
+def read_word_list(path):
+    """Returns the words of a word list in file order"""
+    words = []
+    seen = set()
+    with open(path, encoding='ascii') as f:
+        for number, line in enumerate(f, 1):
+            word = line.split('#', 1)[0].strip().lower()
+            if not word or word in seen:
+                continue
+            if len(word) > MAX_LETTERS or any(c not in MORSE for c in word):
+                sys.exit('%s:%d: "%s" must be 1-%d letters or digits' % (path, number, word, MAX_LETTERS))
+            seen.add(word)
+            words.append(word)
+    return words
+
+
+def corpus_chunks(paths):
+    for path in paths:
+        size = os.path.getsize(path)
+        for start in range(0, max(size, 1), CHUNK_SIZE):
+            yield path, start, min(start + CHUNK_SIZE, size)
+
+
+def count_chunk(task):
+    """Counts the words on the lines that start inside [start, end) of a file"""
+    path, start, end = task
+    counts = collections.Counter()
+    with open(path, 'rb') as f:
+        if start > 0:
+            # Skip the line that started in the previous chunk
+            f.seek(start - 1)
+            f.readline()
+        while f.tell() < end:
+            line = f.readline()
+            if not line:
+                break
+            counts.update(TOKEN.findall(line.lower()))
+    return counts
+
+
+def rank_corpus(paths, jobs, top, min_count):
+    """Returns the most frequent usable words of the corpora, most frequent first"""
+    totals = collections.Counter()
+    with multiprocessing.Pool(jobs) as pool:
+        for counts in pool.imap_unordered(count_chunk, corpus_chunks(paths)):
+            totals.update(counts)
+
+    ranked = []
+    for token, count in sorted(totals.items(), key=lambda item: (-item[1], item[0])):
+        if count < min_count or len(ranked) == top:
+            break
+        if 2 <= len(token) <= MAX_LETTERS:
+            ranked.append(token.decode('ascii'))
+    return ranked
+
+
+def perfect_hash(words):
+    """Returns (displacements, slots) where slots[i] is the index of the word at slot i"""
+    n = len(words)
+    buckets = [[] for _ in range((n + 1) // 2)]
+    for index, word in enumerate(words):
+        buckets[hash_slot(word_hash(word, 0), len(buckets))].append(index)
+
+    displacements = [0] * len(buckets)
+    slots = [None] * n
+    for b in sorted(range(len(buckets)), key=lambda b: len(buckets[b]), reverse=True):
+        if not buckets[b]:
+            continue
+        for d in range(1, MAX_DISPLACEMENT + 1):
+            taken = [hash_slot(word_hash(words[i], d), n) for i in buckets[b]]
+            if len(set(taken)) == len(taken) and all(slots[t] is None for t in taken):
+                break
+        else:
+            sys.exit('no displacement found for bucket %d' % b)
+        displacements[b] = d
+        for i, t in zip(buckets[b], taken):
+            slots[t] = i
+    return displacements, slots
+
+
+def front_code(words):
+    """Returns (blocks, offsets) with offsets relative to the first block"""
+    blocks = bytearray()
+    offsets = []
+    for start in range(0, len(words), BLOCK_SIZE):
+        offsets.append(len(blocks))
+        previous = words[start]
+        blocks.append(len(previous))
+        blocks += previous.encode('ascii')
+        for word in words[start + 1:start + BLOCK_SIZE]:
+            prefix = 0
+            while prefix < min(len(word), len(previous)) and word[prefix] == previous[prefix]:
+                prefix += 1
+            suffix = word[prefix:]
+            blocks.append(prefix << 4 | len(suffix))
+            blocks += suffix.encode('ascii')
+            previous = word
+    offsets.append(len(blocks))
+    return bytes(blocks), offsets
+
+
+def search_key(word):
+    """First 8 characters of word as a big endian integer, must match dictionary.c"""
+    return int.from_bytes(word[:8].encode('ascii').ljust(8, b'\0'), 'big')
+
+
+def eytzinger(values):
+    """Returns values (sorted) in Eytzinger order, 1-based with a dummy at index 0"""
+    out = [None] * (len(values) + 1)
+    it = iter(values)
+
+    def fill(k):
+        if k <= len(values):
+            fill(2 * k)
+            out[k] = next(it)
+            fill(2 * k + 1)
+
+    fill(1)
+    return out
+
+
+def align(data):
+    return data + b'\0' * (-len(data) % 8)
+
+
+def build(ranked):
+    if not ranked or len(ranked) > MAX_WORDS:
+        sys.exit('need 1-%d words, found %d' % (MAX_WORDS, len(ranked)))
+
+    words = sorted(ranked)
+    index_of = {w: i for i, w in enumerate(words)}
+    blocks, block_offsets = front_code(words)
+    displacements, slots = perfect_hash(words)
+
+    durations = [morse_duration(w) for w in words]
+    max_duration = max(durations)
+    by_duration = sorted(range(len(words)), key=lambda i: (durations[i], i))
+    starts = [0] * (max_duration + 2)
+    for d in durations:
+        starts[d + 1] += 1
+    for d in range(1, len(starts)):
+        starts[d] += starts[d - 1]
+
+    if max_duration > 0xFF:
+        sys.exit('a word lasts %d dot units, the limit is 255' % max_duration)
+
+    block_count = len(block_offsets) - 1
+    tree = eytzinger([(search_key(words[b * BLOCK_SIZE]), b) for b in range(block_count)])
+    tree[0] = (0, 0)
+
+    index_size = 4 * len(block_offsets)
+    sections = [align(blocks),
+                align(struct.pack('<%dH' % len(displacements), *displacements)),
+                align(struct.pack('<%dH' % len(slots), *slots)),
+                align(struct.pack('<%dH' % len(starts), *starts)),
+                align(struct.pack('<%dH' % len(by_duration), *by_duration)),
+                align(struct.pack('<%dQ' % len(words), *(morse_word(w) for w in words))),
+                align(struct.pack('<%dB' % len(words), *durations)),
+                align(struct.pack('<%dH' % len(ranked), *(index_of[w] for w in ranked))),
+                align(struct.pack('<%dQ' % len(tree), *(key for key, _ in tree))),
+                align(struct.pack('<%dH' % len(tree), *(block for _, block in tree))),
+                align(struct.pack('<%dQ' % len(words), *(match_key(w) for w in words)))]
+    header_size = len(align(b'\0' * HEADER_WORDS * 4))
+    blocks_offset = header_size + len(align(b'\0' * index_size))
+    offsets = [blocks_offset]
+    for section in sections:
+        offsets.append(offsets[-1] + len(section))
+
+    header = struct.pack('<%dI' % HEADER_WORDS,
+                         MAGIC, VERSION, len(words), BLOCK_SIZE, block_count,
+                         header_size, len(displacements), offsets[1], offsets[2],
+                         max_duration, offsets[3], offsets[4],
+                         offsets[5], offsets[6], offsets[7], offsets[8], offsets[9],
+                         offsets[10], offsets[11])
+    index = align(struct.pack('<%dI' % len(block_offsets), *(blocks_offset + o for o in block_offsets)))
+    return align(header) + index + b''.join(sections)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Build the Morse game word dictionary.')
+    parser.add_argument('corpus', nargs='*', help='text files to rank words from')
+    parser.add_argument('--words', help='word list to use instead of ranking a corpus')
+    parser.add_argument('-o', '--output', required=True, help='dictionary file to write')
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count(), help='worker processes')
+    parser.add_argument('--top', type=int, default=20000, help='most frequent words to keep')
+    parser.add_argument('--min-count', type=int, default=2, help='ignore rarer words')
+    args = parser.parse_args()
+
+    if bool(args.words) == bool(args.corpus):
+        parser.error('give either --words or corpus files')
+    if args.words:
+        ranked = read_word_list(args.words)
+    else:
+        ranked = rank_corpus(args.corpus, args.jobs, min(args.top, MAX_WORDS), args.min_count)
+
+    blob = build(ranked)
+    with open(args.output, 'wb') as f:
+        f.write(blob)
+    print('%s: %d words, %d bytes' % (args.output, len(ranked), len(blob)))
+
+
+if __name__ == '__main__':
+    main()
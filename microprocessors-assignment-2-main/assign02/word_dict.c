@@ -0,0 +1,171 @@
+/*
+ * Import header files
+ */
+#include <ctype.h>
+#include <string.h>
+#include "word_dict.h"
+#include "word_hash.h"
+
+#define WORD_DICT_MASK (WORD_DICT_CAPACITY - 1)
+#define WORD_DICT_SEED 0x5EEDu // Keeps runtime hashes independent of the built-in perfect hash
+
+static struct word_dict_entry table[WORD_DICT_CAPACITY];
+static size_t count;
+
+/*
+ * Copies word into key in lower case. Returns false if it does not fit.
+ */
+static bool normalise(const char *word, char key[MORSE_WORD_MAX_LETTERS + 1])
+{
+    size_t length = strlen(word);
+
+    if (length == 0 || length > MORSE_WORD_MAX_LETTERS)
+    {
+        return false;
+    }
+    for (size_t i = 0; i <= length; i++)
+    {
+        key[i] = (char)tolower((unsigned char)word[i]);
+    }
+    return true;
+}
+
+/*
+ * Returns the slot holding key, or -1
+ */
+static int find(const char *key)
+{
+    uint32_t slot = word_hash(key, WORD_DICT_SEED) & WORD_DICT_MASK;
+
+    // Entries closer to home than the key would be mean the key is not there
+    for (int probe = 1; table[slot].probe >= probe; probe++)
+    {
+        if (strcmp(table[slot].word, key) == 0)
+        {
+            return (int)slot;
+        }
+        slot = (slot + 1) & WORD_DICT_MASK;
+    }
+    return -1;
+}
+
+enum word_dict_result word_dict_insert(const char *word)
+{
+    char key[MORSE_WORD_MAX_LETTERS + 1];
+    struct word_dict_entry entry;
+
+    if (!normalise(word, key))
+    {
+        return WORD_DICT_INVALID;
+    }
+    entry.morse = morse_encode_word(key);
+    if (entry.morse == MORSE_WORD_INVALID)
+    {
+        return WORD_DICT_INVALID;
+    }
+    if (find(key) >= 0)
+    {
+        return WORD_DICT_EXISTS;
+    }
+    if (count >= WORD_DICT_MAX_WORDS)
+    {
+        return WORD_DICT_FULL;
+    }
+
+    memcpy(entry.word, key, sizeof entry.word);
+    entry.probe = 1;
+
+    uint32_t slot = word_hash(key, WORD_DICT_SEED) & WORD_DICT_MASK;
+    while (table[slot].probe != 0)
+    {
+        // Robin Hood: the entry further from home keeps the slot
+        if (table[slot].probe < entry.probe)
+        {
+            struct word_dict_entry displaced = table[slot];
+            table[slot] = entry;
+            entry = displaced;
+        }
+        slot = (slot + 1) & WORD_DICT_MASK;
+        entry.probe++;
+    }
+    table[slot] = entry;
+    count++;
+    return WORD_DICT_OK;
+}
+
+enum word_dict_result word_dict_delete(const char *word)
+{
+    char key[MORSE_WORD_MAX_LETTERS + 1];
+    int slot;
+
+    if (!normalise(word, key))
+    {
+        return WORD_DICT_INVALID;
+    }
+    slot = find(key);
+    if (slot < 0)
+    {
+        return WORD_DICT_NOT_FOUND;
+    }
+
+    // Shift the rest of the run back one slot so no tombstone is needed
+    for (;;)
+    {
+        int next = (slot + 1) & WORD_DICT_MASK;
+        if (table[next].probe <= 1)
+        {
+            table[slot].probe = 0;
+            break;
+        }
+        table[slot] = table[next];
+        table[slot].probe--;
+        slot = next;
+    }
+    count--;
+    return WORD_DICT_OK;
+}
+
+const struct word_dict_entry *word_dict_lookup(const char *word)
+{
+    char key[MORSE_WORD_MAX_LETTERS + 1];
+    int slot;
+
+    if (!normalise(word, key))
+    {
+        return NULL;
+    }
+    slot = find(key);
+    return slot >= 0 ? &table[slot] : NULL;
+}
+
+size_t word_dict_count(void)
+{
+    return count;
+}
+
+const struct word_dict_entry *word_dict_at(size_t n)
+{
+    for (size_t slot = 0; slot < WORD_DICT_CAPACITY; slot++)
+    {
+        if (table[slot].probe != 0 && n-- == 0)
+        {
+            return &table[slot];
+        }
+    }
+    return NULL;
+}
+
+void word_dict_get_stats(struct word_dict_stats *stats)
+{
+    stats->words = count;
+    stats->capacity = WORD_DICT_MAX_WORDS;
+    stats->bytes = sizeof table;
+    stats->longest_probe = 0;
+    for (size_t slot = 0; slot < WORD_DICT_CAPACITY; slot++)
+    {
+        if (table[slot].probe > stats->longest_probe)
+        {
+            stats->longest_probe = table[slot].probe;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef ASSIGN02_WORD_DICT_H
+#define ASSIGN02_WORD_DICT_H
+
+/*
+ * Import header files
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "morse.h"
+
+/*
+ * Runtime dictionary for drill words uploaded over the serial console.
+ * Words live in a fixed static table using Robin Hood open addressing:
+ * an entry that is further from its home slot takes the place of one that
+ * is closer, which keeps every probe sequence short and lets a lookup stop
+ * as soon as it meets an entry closer to home than the key would be.
+ * Deletion shifts the following entries back, so there are no tombstones.
+ */
+#define WORD_DICT_CAPACITY 128                              // Slots in the table, a power of two
+#define WORD_DICT_MAX_WORDS (WORD_DICT_CAPACITY * 7 / 8)    // Keeps the load factor at or below 7/8
+
+struct word_dict_entry
+{
+    morse_word_t morse;                       // Packed morse code of word
+    char word[MORSE_WORD_MAX_LETTERS + 1];    // Lower case text
+    uint8_t probe;                            // Distance from the home slot + 1, 0 for an empty slot
+};
+
+enum word_dict_result
+{
+    WORD_DICT_OK,
+    WORD_DICT_EXISTS,    // Word is already in the dictionary
+    WORD_DICT_NOT_FOUND, // Word is not in the dictionary
+    WORD_DICT_FULL,      // Load factor limit reached
+    WORD_DICT_INVALID    // Word is empty, too long or has no morse code
+};
+
+/*
+ * Fill level of the table
+ */
+struct word_dict_stats
+{
+    size_t words;        // Words stored
+    size_t capacity;     // Words that can be stored
+    size_t bytes;        // Size of the static table
+    int longest_probe;   // Longest probe sequence of any stored word
+};
+
+/*
+ * Adds word to the dictionary
+ */
+enum word_dict_result word_dict_insert(const char *word);
+
+/*
+ * Removes word from the dictionary
+ */
+enum word_dict_result word_dict_delete(const char *word);
+
+/*
+ * Returns the entry for word, or NULL if it is not in the dictionary
+ */
+const struct word_dict_entry *word_dict_lookup(const char *word);
+
+/*
+ * Returns the number of words in the dictionary
+ */
+size_t word_dict_count(void);
+
+/*
+ * Returns the n-th word in table order (n < word_dict_count()), or NULL
+ */
+const struct word_dict_entry *word_dict_at(size_t n);
+
+/*
+ * Fills in the fill level of the table
+ */
+void word_dict_get_stats(struct word_dict_stats *stats);
+
+#endif
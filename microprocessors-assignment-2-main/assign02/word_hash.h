@@ -0,0 +1,25 @@
+#ifndef ASSIGN02_WORD_HASH_H
+#define ASSIGN02_WORD_HASH_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+
+/*
+ * 32-bit FNV-1a hash of word, mixed with seed.
+ * Used by the dictionary's build-time perfect hash and the runtime word table.
+ * Must match word_hash() in tools/mkdict.py.
+ */
+static inline uint32_t word_hash(const char *word, uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    while (*word != '\0')
+    {
+        hash ^= (uint8_t)*word++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * Import header files
+ */
+#include <stddef.h>
+#include "word_verifier.h"
+
+/*
+ * Moves position forward to the next letter in target, skipping word spaces
+ */
+static void skip_spaces(volatile struct word_verifier *verifier)
+{
+    while (verifier->target[verifier->position] == ' ')
+    {
+        verifier->position++;
+    }
+}
+
+static enum morse_verdict reject(volatile struct word_verifier *verifier)
+{
+    verifier->verdict = MORSE_REJECTED;
+    return MORSE_REJECTED;
+}
+
+void word_verifier_start(volatile struct word_verifier *verifier, const char *target)
+{
+    uint16_t letters = 0;
+
+    for (const char *c = target; c != NULL && *c != '\0'; c++)
+    {
+        if (*c != ' ')
+        {
+            letters++;
+        }
+    }
+
+    verifier->target = target;
+    verifier->position = 0;
+    verifier->correct = 0;
+    verifier->letters = letters;
+    verifier->node = MORSE_CODE_EMPTY;
+    verifier->verdict = MORSE_PENDING;
+    if (target != NULL)
+    {
+        skip_spaces(verifier);
+    }
+}
+
+enum morse_verdict word_verifier_element(volatile struct word_verifier *verifier, bool dash)
+{
+    if (verifier->verdict != MORSE_PENDING || verifier->target == NULL)
+    {
+        return verifier->verdict;
+    }
+
+    morse_code_t expected = morse_encode(verifier->target[verifier->position]);
+    morse_code_t next = (morse_code_t)((verifier->node << 1) | (dash ? 1u : 0u));
+
+    // A letter that has left the path to the expected one can never be right
+    if (expected == 0 || !morse_code_leads_to(next, expected))
+    {
+        return reject(verifier);
+    }
+    verifier->node = next;
+
+    // A letter is only confirmed by the gap that closes it, a longer code can still follow
+    return verifier->verdict;
+}
+
+enum morse_verdict word_verifier_gap(volatile struct word_verifier *verifier)
+{
+    if (verifier->verdict != MORSE_PENDING || verifier->target == NULL ||
+        verifier->node == MORSE_CODE_EMPTY)
+    {
+        return verifier->verdict;
+    }
+
+    if (verifier->node != morse_encode(verifier->target[verifier->position]))
+    {
+        return reject(verifier);
+    }
+
+    verifier->correct++;
+    verifier->position++;
+    verifier->node = MORSE_CODE_EMPTY;
+    skip_spaces(verifier);
+    if (verifier->correct == verifier->letters)
+    {
+        verifier->verdict = MORSE_ACCEPTED;
+    }
+    return verifier->verdict;
+}
+
+enum morse_verdict word_verifier_end(volatile struct word_verifier *verifier)
+{
+    // The last letter is closed by the end of transmission rather than a gap
+    word_verifier_gap(verifier);
+    if (verifier->verdict == MORSE_PENDING && verifier->target != NULL)
+    {
+        return reject(verifier);
+    }
+    return verifier->verdict;
+}
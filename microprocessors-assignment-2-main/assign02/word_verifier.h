@@ -0,0 +1,56 @@
+#ifndef ASSIGN02_WORD_VERIFIER_H
+#define ASSIGN02_WORD_VERIFIER_H
+
+/*
+ * Import header files
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "morse.h"
+#include "morse_decoder.h"
+
+/*
+ * Checks a word or phrase letter by letter as it is keyed.
+ * The target is read straight from its text, so the state is the same few
+ * bytes however long the word or phrase is. Spaces in the target separate
+ * words and are skipped.
+ */
+struct word_verifier
+{
+    const char *target;  // Text being keyed, NULL when not checking a word
+    uint16_t position;   // Index in target of the letter being keyed
+    uint16_t correct;    // Letters confirmed so far
+    uint16_t letters;    // Letters in target
+    morse_code_t node;   // Elements of the letter being keyed
+    enum morse_verdict verdict;
+};
+
+/*
+ * Starts checking a new answer against the text target (NULL to stop checking)
+ */
+void word_verifier_start(volatile struct word_verifier *verifier, const char *target);
+
+/*
+ * Feeds one element (dash == false for a dot) into the verifier
+ */
+enum morse_verdict word_verifier_element(volatile struct word_verifier *verifier, bool dash);
+
+/*
+ * Feeds an inter-letter gap into the verifier, which checks the letter it closes
+ */
+enum morse_verdict word_verifier_gap(volatile struct word_verifier *verifier);
+
+/*
+ * Feeds the end of transmission into the verifier, an unfinished answer is rejected
+ */
+enum morse_verdict word_verifier_end(volatile struct word_verifier *verifier);
+
+/*
+ * Returns the letter the verifier is waiting for, or '\0' once it is done
+ */
+static inline char word_verifier_expected(const volatile struct word_verifier *verifier)
+{
+    return verifier->target != NULL ? verifier->target[verifier->position] : '\0';
+}
+
+#endif
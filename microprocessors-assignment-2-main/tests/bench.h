@@ -0,0 +1,25 @@
+#ifndef ASSIGN02_TESTS_BENCH_H
+#define ASSIGN02_TESTS_BENCH_H
+
+/*
+ * Import header files
+ */
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Monotonic time in nanoseconds for the host benchmarks
+ */
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/*
+ * Stops the compiler from optimising away a result nothing else reads
+ */
+static volatile uint64_t bench_sink;
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Compares looking a word up through the dictionary's perfect hash with the
+ * strcmp scan over the word list that levels 3 and 4 used before it, and
+ * checks that every word (and no other) is found.
+ */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "check.h"
+#include "dictionary_mmap.h"
+
+#define ROUNDS 20
+
+/*
+ * The old lookup: strcmp every word in turn until one matches
+ */
+static int scan_lookup(char (*words)[DICTIONARY_WORD_MAX + 1], size_t count, const char *word)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (strcmp(words[i], word) == 0)
+        {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+int main(void)
+{
+    struct dictionary dict;
+    char(*words)[DICTIONARY_WORD_MAX + 1];
+    char missing[DICTIONARY_WORD_MAX + 2];
+    size_t count;
+    uint64_t start, hash_ns, scan_ns;
+
+    if (!dictionary_map(&dict, DICTIONARY_BIN))
+    {
+        printf("cannot open %s\n", DICTIONARY_BIN);
+        return 1;
+    }
+    count = dictionary_count(&dict);
+    words = malloc(count * sizeof *words);
+    for (size_t i = 0; i < count; i++)
+    {
+        CHECK(dictionary_word(&dict, i, words[i]));
+    }
+
+    // Every word is found where it is, upper case too, and a word with one letter more is not
+    for (size_t i = 0; i < count; i++)
+    {
+        CHECK_EQ(dictionary_lookup(&dict, words[i]), i);
+        for (size_t c = 0; c <= strlen(words[i]); c++)
+        {
+            missing[c] = (char)toupper((unsigned char)words[i][c]);
+        }
+        CHECK_EQ(dictionary_lookup(&dict, missing), i);
+        strcpy(missing, words[i]);
+        strcat(missing, "q");
+        if (scan_lookup(words, count, missing) < 0)
+        {
+            CHECK_EQ(dictionary_lookup(&dict, missing), -1);
+        }
+    }
+    CHECK_EQ(dictionary_lookup(&dict, ""), -1);
+    CHECK_EQ(dictionary_lookup(&dict, "abcdefghijk"), -1);
+
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            bench_sink += (uint64_t)dictionary_lookup(&dict, words[i]);
+        }
+    }
+    hash_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            bench_sink += (uint64_t)scan_lookup(words, count, words[i]);
+        }
+    }
+    scan_ns = bench_now_ns() - start;
+
+    printf("%zu words, %d lookups of each\n", count, ROUNDS);
+    printf("perfect hash: %8.1f ns per lookup\n", (double)hash_ns / (ROUNDS * count));
+    printf("strcmp scan:  %8.1f ns per lookup\n", (double)scan_ns / (ROUNDS * count));
+
+    free(words);
+    dictionary_unmap(&dict);
+    return check_result();
+}
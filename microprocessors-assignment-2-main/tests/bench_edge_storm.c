@@ -0,0 +1,55 @@
+/*
+ * Host edge storm: times the main loop's share of an edge (read from the
+ * ring, classify, record) on this machine, then runs the storm through the
+ * simulated GPIO with that cost and the interrupt's estimated cycle counts.
+ * The table is a host figure; the board's is printed by run_edge_bench.
+ */
+#include "bench.h"
+#include "check.h"
+#include "gpio_model.h"
+
+#define SYS_HZ 125000000u
+#define EDGES 2000000
+
+static struct edge_ring ring;
+static struct edge_bench bench;
+
+int main(void)
+{
+    struct gpio_model_cost cost;
+    struct edge_bench_result result;
+    struct edge_event edge;
+    uint64_t start, elapsed;
+
+    // Pushes stand in for the interrupt and are left out of the timing
+    edge_ring_init(&ring);
+    edge_bench_start(&bench, 2, 0);
+    elapsed = 0;
+    for (uint32_t i = 0; i < EDGES; i += EDGE_RING_SIZE / 2)
+    {
+        for (uint32_t j = i; j < i + EDGE_RING_SIZE / 2; j++)
+        {
+            edge_ring_push(&ring, 2, j % 2 == 0 ? EDGE_PRESSED : EDGE_RELEASED, 1000000 + 50 * (uint64_t)j);
+        }
+        start = bench_now_ns();
+        while (edge_ring_pop(&ring, &edge))
+        {
+            edge_bench_edge(&bench, &edge, edge.time_us + 1);
+        }
+        elapsed += bench_now_ns() - start;
+    }
+    edge_bench_finish(&bench, 0, EDGES, 0, &result);
+    CHECK_EQ(result.received, EDGES);
+    CHECK_EQ(result.disorder, 0);
+    printf("read and classify one edge  %6.2f ns\n\n", elapsed / (double)EDGES);
+
+    gpio_model_isr_cost(&cost, SYS_HZ);
+    cost.consume_ns = (uint32_t)(elapsed / EDGES) + 1;
+    for (int i = 0; i < EDGE_BENCH_RATES; i++)
+    {
+        gpio_model_storm(&cost, edge_bench_rates[i], 2, &ring, &bench, &result);
+        CHECK_EQ(result.received + result.ring_full + result.merged, result.sent);
+        edge_bench_print(&result, i == 0);
+    }
+    return check_result();
+}
@@ -0,0 +1,84 @@
+/*
+ * Throughput of the batch matcher on one core as the table grows
+ */
+#include <stdlib.h>
+#include "bench.h"
+#include "check.h"
+#include "morse_batch.h"
+
+#define MAX_KEYS 65536
+#define KEYS_PER_SIZE (32u << 20) // Keys compared at each table size
+
+static uint32_t state = 9;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static morse_code_t random_code(void)
+{
+    return (morse_code_t)(2 + next_random() % 62);
+}
+
+int main(void)
+{
+    static morse_char_key_t char_keys[MAX_KEYS];
+    static morse_word_t word_keys[MAX_KEYS];
+    struct morse_batch_candidate candidates[3];
+
+#if defined(__AVX2__)
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        printf("no AVX2 on this CPU, skipped\n");
+        return 77;
+    }
+    printf("AVX2 kernels\n");
+#elif defined(__ARM_NEON)
+    printf("NEON kernels\n");
+#else
+    printf("SWAR kernels\n");
+#endif
+
+    for (size_t i = 0; i < MAX_KEYS; i++)
+    {
+        morse_word_t word = MORSE_WORD_EMPTY;
+        for (int letters = 3 + (int)(next_random() % 6); letters > 0; letters--)
+        {
+            word = MORSE_WORD_APPEND(word, random_code());
+        }
+        char_keys[i] = morse_batch_char_key(random_code());
+        word_keys[i] = morse_batch_word_key(word);
+    }
+
+    printf("   keys   chars M/s   words M/s\n");
+    for (size_t count = 64; count <= MAX_KEYS; count *= 4)
+    {
+        size_t passes = KEYS_PER_SIZE / count;
+        uint64_t start, char_ns, word_ns;
+
+        start = bench_now_ns();
+        for (size_t pass = 0; pass < passes; pass++)
+        {
+            int found = morse_batch_match_chars(char_keys, count, char_keys[pass % count], candidates, 3);
+            bench_sink += (uint64_t)found + candidates[0].distance;
+        }
+        char_ns = bench_now_ns() - start;
+
+        start = bench_now_ns();
+        for (size_t pass = 0; pass < passes; pass++)
+        {
+            int found = morse_batch_match_words(word_keys, count, word_keys[pass % count], candidates, 3);
+            CHECK_EQ(candidates[0].distance, 0);
+            bench_sink += (uint64_t)found;
+        }
+        word_ns = bench_now_ns() - start;
+
+        printf("  %5zu   %9.1f   %9.1f\n", count, passes * count * 1e3 / (double)char_ns,
+               passes * count * 1e3 / (double)word_ns);
+    }
+    return check_result();
+}
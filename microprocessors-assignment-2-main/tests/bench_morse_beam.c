@@ -0,0 +1,113 @@
+/*
+ * Reads dictionary words back from marks whose gaps carry Gaussian-like
+ * noise, and times each decode
+ */
+#include <math.h>
+#include <string.h>
+#include "bench.h"
+#include "check.h"
+#include "dictionary_mmap.h"
+#include "morse_beam.h"
+
+#define WORDS 2000
+#define CANDIDATES 3
+
+static uint32_t state = 3;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+ * Noise with mean 0 and standard deviation sigma, from the sum of 12 uniforms
+ */
+static double noise(double sigma)
+{
+    double sum = -6.0;
+    for (int i = 0; i < 12; i++)
+    {
+        sum += next_random() / 4294967296.0;
+    }
+    return sum * sigma;
+}
+
+static uint16_t noisy_gap(unsigned units, double sigma)
+{
+    double gap = (units + noise(sigma)) * MORSE_BEAM_UNIT;
+    return gap < 0 ? 0 : gap > UINT16_MAX ? UINT16_MAX : (uint16_t)lround(gap);
+}
+
+static void key_word(struct morse_beam_input *input, const char *word, double sigma)
+{
+    morse_beam_input_clear(input);
+    for (const char *c = word; *c != '\0'; c++)
+    {
+        morse_code_t code = morse_encode(*c);
+        for (int element = morse_code_length(code) - 1; element >= 0; element--)
+        {
+            if (input->marks > 0)
+            {
+                morse_beam_input_gap(input, noisy_gap(element == morse_code_length(code) - 1 ? 3 : 1, sigma));
+            }
+            morse_beam_input_mark(input, (code >> element) & 1u);
+        }
+    }
+}
+
+int main(void)
+{
+    static const double sigmas[] = {0.0, 0.25, 0.5, 0.75, 1.0};
+    struct dictionary dict;
+    struct morse_beam_input input;
+    struct morse_beam_candidate candidates[CANDIDATES];
+    char word[DICTIONARY_WORD_MAX + 1];
+
+    if (!dictionary_map(&dict, DICTIONARY_BIN))
+    {
+        printf("cannot open %s\n", DICTIONARY_BIN);
+        return 1;
+    }
+
+    printf("%d random words from %zu, gap noise in dot units\n", WORDS, dictionary_count(&dict));
+    printf(" sigma   top 1   top 3   mean us   max us\n");
+    for (size_t s = 0; s < sizeof sigmas / sizeof sigmas[0]; s++)
+    {
+        int top1 = 0, top3 = 0;
+        uint64_t total_ns = 0, max_ns = 0;
+
+        for (int i = 0; i < WORDS; i++)
+        {
+            dictionary_word(&dict, next_random() % dictionary_count(&dict), word);
+            key_word(&input, word, sigmas[s]);
+
+            uint64_t start = bench_now_ns();
+            int found = morse_beam_decode(&dict, &input, candidates, CANDIDATES);
+            uint64_t elapsed = bench_now_ns() - start;
+
+            total_ns += elapsed;
+            max_ns = elapsed > max_ns ? elapsed : max_ns;
+            for (int c = 0; c < found; c++)
+            {
+                if (strcmp(candidates[c].word, word) == 0)
+                {
+                    top1 += c == 0;
+                    top3++;
+                    break;
+                }
+            }
+        }
+        printf("  %4.2f  %5.1f%%  %5.1f%%  %8.2f  %7.2f\n", sigmas[s], 100.0 * top1 / WORDS, 100.0 * top3 / WORDS,
+               total_ns / 1e3 / WORDS, max_ns / 1e3);
+        if (sigmas[s] == 0.0)
+        {
+            CHECK_EQ(top1, WORDS);
+        }
+    }
+
+    dictionary_unmap(&dict);
+    return check_result();
+}
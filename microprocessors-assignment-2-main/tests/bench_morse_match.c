@@ -0,0 +1,77 @@
+/*
+ * Times the bit-parallel edit distance over millions of keyed answers of
+ * word length against their targets
+ */
+#include "bench.h"
+#include "check.h"
+#include "morse_match.h"
+
+#define PAIRS 1024
+#define COMPARISONS 4000000
+
+static uint32_t state = 11;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+int main(void)
+{
+    static struct morse_symbols expected[PAIRS], keyed[PAIRS];
+    static struct morse_match match;
+    uint64_t start, distance_ns, match_ns;
+    uint64_t total = 0;
+    unsigned symbols = 0;
+
+    // Random words of 3-8 letters, keyed with a dot or dash changed now and then
+    for (int i = 0; i < PAIRS; i++)
+    {
+        int letters = 3 + (int)(next_random() % 6);
+        morse_word_t target = MORSE_WORD_EMPTY, answer = MORSE_WORD_EMPTY;
+
+        for (int l = 0; l < letters; l++)
+        {
+            morse_code_t code = alpha_morse[next_random() % 26];
+            target = MORSE_WORD_APPEND(target, code);
+            if (next_random() % 4 == 0)
+            {
+                code ^= 1u;
+            }
+            answer = MORSE_WORD_APPEND(answer, code);
+        }
+        morse_symbols_from_word(&expected[i], target);
+        morse_symbols_from_word(&keyed[i], answer);
+    }
+
+    // Both entry points agree before anything is timed
+    for (int i = 0; i < PAIRS; i++)
+    {
+        CHECK_EQ(morse_match(&expected[i], &keyed[i], &match), morse_distance(&expected[i], &keyed[i]));
+        symbols += expected[i].length;
+    }
+
+    start = bench_now_ns();
+    for (int i = 0; i < COMPARISONS; i++)
+    {
+        total += (uint64_t)morse_distance(&expected[i % PAIRS], &keyed[i % PAIRS]);
+    }
+    distance_ns = bench_now_ns() - start;
+    bench_sink = total;
+
+    start = bench_now_ns();
+    for (int i = 0; i < COMPARISONS / 8; i++)
+    {
+        bench_sink += (uint64_t)morse_match(&expected[i % PAIRS], &keyed[i % PAIRS], &match);
+    }
+    match_ns = bench_now_ns() - start;
+
+    printf("%d comparisons, targets of %.1f symbols on average\n", COMPARISONS, (double)symbols / PAIRS);
+    printf("morse_distance: %6.1f ns per comparison, %.1f M/s\n", (double)distance_ns / COMPARISONS,
+           COMPARISONS * 1e3 / (double)distance_ns);
+    printf("morse_match:    %6.1f ns per comparison with traceback\n", (double)match_ns / (COMPARISONS / 8));
+    return check_result();
+}
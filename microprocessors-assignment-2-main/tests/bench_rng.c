@@ -0,0 +1,58 @@
+/*
+ * Cost of one random number, one bounded draw and one draw from each deck
+ */
+#include "bench.h"
+#include "check.h"
+#include "deck.h"
+#include "rng.h"
+
+#define DRAWS 20000000
+
+int main(void)
+{
+    struct card_deck cards;
+    struct index_deck indices;
+    uint64_t start, next_ns, below_ns, card_ns, index_ns;
+    uint64_t total = 0;
+
+    rng_seed(1);
+    start = bench_now_ns();
+    for (int i = 0; i < DRAWS; i++)
+    {
+        total += rng_next();
+    }
+    next_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (int i = 0; i < DRAWS; i++)
+    {
+        total += rng_below(36);
+    }
+    below_ns = bench_now_ns() - start;
+
+    card_deck_init(&cards, 36);
+    start = bench_now_ns();
+    for (int i = 0; i < DRAWS; i++)
+    {
+        total += card_deck_draw(&cards);
+    }
+    card_ns = bench_now_ns() - start;
+
+    // About the size of the dictionary, so a quarter of the range is outside it
+    index_deck_init(&indices, 20000);
+    start = bench_now_ns();
+    for (int i = 0; i < DRAWS; i++)
+    {
+        uint32_t index = index_deck_draw(&indices);
+        CHECK(index < 20000);
+        total += index;
+    }
+    index_ns = bench_now_ns() - start;
+    bench_sink = total;
+
+    printf("rng_next         %6.2f ns\n", next_ns / (double)DRAWS);
+    printf("rng_below(36)    %6.2f ns\n", below_ns / (double)DRAWS);
+    printf("card_deck_draw   %6.2f ns\n", card_ns / (double)DRAWS);
+    printf("index_deck_draw  %6.2f ns\n", index_ns / (double)DRAWS);
+    return check_result();
+}
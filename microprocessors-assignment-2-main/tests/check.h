@@ -0,0 +1,48 @@
+#ifndef ASSIGN02_TESTS_CHECK_H
+#define ASSIGN02_TESTS_CHECK_H
+
+/*
+ * Import header files
+ */
+#include <stdio.h>
+
+/*
+ * Minimal checks for the host tests: a failed check prints where it was and
+ * the test keeps going, main() returns check_result() to ctest.
+ */
+static int check_failures;
+
+#define CHECK(condition)                                                         \
+    do                                                                           \
+    {                                                                            \
+        if (!(condition))                                                        \
+        {                                                                        \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            check_failures++;                                                    \
+        }                                                                        \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                          \
+    do                                                                                      \
+    {                                                                                       \
+        long long check_actual = (long long)(actual);                                       \
+        long long check_expected = (long long)(expected);                                   \
+        if (check_actual != check_expected)                                                 \
+        {                                                                                   \
+            printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual,       \
+                   check_actual, check_expected);                                           \
+            check_failures++;                                                               \
+        }                                                                                   \
+    } while (0)
+
+static inline int check_result(void)
+{
+    if (check_failures != 0)
+    {
+        printf("%d check(s) failed\n", check_failures);
+        return 1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef ASSIGN02_TESTS_STUBS_HARDWARE_DMA_H
+#define ASSIGN02_TESTS_STUBS_HARDWARE_DMA_H
+
+/*
+ * The DMA calls led.c makes, with the SDK's signatures, for a test to fake
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8,
+    DMA_SIZE_16,
+    DMA_SIZE_32
+};
+
+typedef struct
+{
+    uint32_t ctrl;
+} dma_channel_config;
+
+int dma_claim_unused_channel(bool required);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config *c, bool incr);
+void channel_config_set_write_increment(dma_channel_config *c, bool incr);
+void channel_config_set_dreq(dma_channel_config *c, uint dreq);
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_irq0_enabled(uint channel, bool enabled);
+bool dma_channel_get_irq0_status(uint channel);
+void dma_channel_acknowledge_irq0(uint channel);
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef ASSIGN02_TESTS_STUBS_HARDWARE_IRQ_H
+#define ASSIGN02_TESTS_STUBS_HARDWARE_IRQ_H
+
+/*
+ * The interrupt calls led.c makes, so a test can keep the handler and call it
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+
+#define DMA_IRQ_0 11
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_set_enabled(uint num, bool enabled);
+
+#endif
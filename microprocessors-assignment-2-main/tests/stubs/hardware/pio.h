@@ -0,0 +1,23 @@
+#ifndef ASSIGN02_TESTS_STUBS_HARDWARE_PIO_H
+#define ASSIGN02_TESTS_STUBS_HARDWARE_PIO_H
+
+/*
+ * Just the types button_timer.h names and the calls led.c makes, so they
+ * build on a host. Nothing here talks to a PIO block: a test that links
+ * led.c defines the functions.
+ */
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef struct pio_hw
+{
+    volatile uint32_t txf[4];
+} pio_hw_t;
+typedef pio_hw_t *PIO;
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data);
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef ASSIGN02_TESTS_STUBS_HARDWARE_STRUCTS_SYSTICK_H
+#define ASSIGN02_TESTS_STUBS_HARDWARE_STRUCTS_SYSTICK_H
+
+/*
+ * SysTick as plain memory, which a test defines and counts down itself
+ */
+#include <stdint.h>
+
+typedef struct
+{
+    volatile uint32_t csr;
+    volatile uint32_t rvr;
+    volatile uint32_t cvr;
+    volatile uint32_t calib;
+} systick_hw_t;
+
+extern systick_hw_t test_systick;
+#define systick_hw (&test_systick)
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef ASSIGN02_TESTS_STUBS_PICO_STDLIB_H
+#define ASSIGN02_TESTS_STUBS_PICO_STDLIB_H
+
+/*
+ * The timer calls led.c makes, for a test to define on a virtual clock
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include "hardware/pio.h"
+
+#define __isr
+
+uint64_t time_us_64(void);
+void busy_wait_us_32(uint32_t delay_us);
+void tight_loop_contents(void);
+
+#endif
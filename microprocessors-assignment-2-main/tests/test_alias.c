@@ -0,0 +1,125 @@
+/*
+ * Checks the alias tables' exact distribution against their weights, and a
+ * sampled one against the exact one
+ */
+#include <math.h>
+#include "check.h"
+#include "alias.h"
+#include "rng.h"
+
+#define DRAWS 2000000
+
+/*
+ * Chance of drawing each item, read back from the table
+ */
+static void exact(const struct alias_table *table, double *probability)
+{
+    for (unsigned i = 0; i < table->count; i++)
+    {
+        probability[i] = 0;
+    }
+    for (unsigned column = 0; column < table->count; column++)
+    {
+        double keep = (double)table->threshold[column] / ALIAS_ONE;
+        probability[column] += keep / table->count;
+        probability[table->alias[column]] += (1 - keep) / table->count;
+    }
+}
+
+static void check_weights(const uint32_t *weights, unsigned count)
+{
+    struct alias_table table;
+    double probability[ALIAS_MAX_ITEMS];
+    double total = 0;
+
+    alias_build(&table, weights, count);
+    CHECK_EQ(table.count, count);
+    exact(&table, probability);
+    for (unsigned i = 0; i < count; i++)
+    {
+        total += weights[i];
+    }
+    for (unsigned i = 0; i < count; i++)
+    {
+        double expected = total > 0 ? weights[i] / total : 1.0 / count;
+
+        // Each column rounds its threshold down by less than one Q15 step
+        CHECK(fabs(probability[i] - expected) <= 2.0 / ALIAS_ONE);
+        if (weights[i] == 0 && total > 0)
+        {
+            CHECK(probability[i] == 0);
+        }
+    }
+}
+
+static void check_sampled(const uint32_t *weights, unsigned count)
+{
+    struct alias_table table;
+    double probability[ALIAS_MAX_ITEMS];
+    unsigned drawn[ALIAS_MAX_ITEMS] = {0};
+    double chi_square = 0;
+    unsigned cells = 0;
+
+    alias_build(&table, weights, count);
+    exact(&table, probability);
+    for (int i = 0; i < DRAWS; i++)
+    {
+        unsigned item = alias_draw(&table);
+        CHECK(item < count);
+        drawn[item < count ? item : 0]++;
+    }
+    for (unsigned i = 0; i < count; i++)
+    {
+        double expected = probability[i] * DRAWS;
+        if (expected > 0)
+        {
+            chi_square += (drawn[i] - expected) * (drawn[i] - expected) / expected;
+            cells++;
+        }
+        else
+        {
+            CHECK_EQ(drawn[i], 0);
+        }
+    }
+    // Far above the 99.9th percentile for up to 64 cells, so a failure is a real bias
+    CHECK(chi_square < 2.0 * cells + 40);
+}
+
+int main(void)
+{
+    uint32_t weights[ALIAS_MAX_ITEMS];
+
+    rng_seed(0x12345678u);
+
+    // Even, uneven, zero and all-zero weights, and sizes that do not divide 2^16
+    for (unsigned count = 1; count <= ALIAS_MAX_ITEMS; count++)
+    {
+        for (unsigned i = 0; i < count; i++)
+        {
+            weights[i] = 4 + 4 * ((i * 7) % 16);
+        }
+        check_weights(weights, count);
+        weights[count / 2] = 0;
+        check_weights(weights, count);
+        for (unsigned i = 0; i < count; i++)
+        {
+            weights[i] = 0;
+        }
+        check_weights(weights, count);
+    }
+    weights[0] = 1;
+    weights[1] = 1000000;
+    weights[2] = 0;
+    check_weights(weights, 3);
+
+    for (unsigned i = 0; i < 36; i++)
+    {
+        weights[i] = i == 16 ? 64 : 4;
+    }
+    check_sampled(weights, 36);
+    weights[0] = 1;
+    weights[1] = 2;
+    weights[2] = 0;
+    check_sampled(weights, 3);
+    return check_result();
+}
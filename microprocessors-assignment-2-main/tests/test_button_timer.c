@@ -0,0 +1,198 @@
+/*
+ * Runs the button_timer program from assign02.pio on the PIO model against
+ * synthetic button waveforms, clean and bouncing, and checks the widths
+ * button_timer_decode() makes of what it pushes
+ */
+#include <stdlib.h>
+#include "check.h"
+#include "button_timer.h"
+#include "pio_model.h"
+
+#define CYCLES_PER_TICK 3 // BUTTON_TIMER_CYCLES_PER_TICK in assign02.pio
+#define MAX_WIDTHS 256
+
+/*
+ * button_timer as pioasm assembles it, by hand since the host has no
+ * pioasm. Keep it in step with assign02.pio.
+ */
+static const uint16_t button_timer_program[] = {
+    0x80A0, //  0: pull block
+    0xA02B, //  1: mov x, ~null
+    0x00D8, //  2: high_loop: jmp pin high_tick        (wrap target)
+    0x0044, //  3: jmp x-- high_low
+    0xA047, //  4: high_low: mov y, osr
+    0x00D8, //  5: high_filter: jmp pin high_tick
+    0x0047, //  6: jmp x-- high_filter_y
+    0x0085, //  7: high_filter_y: jmp y-- high_filter
+    0x4061, //  8: in null, 1
+    0x403F, //  9: in x, 31
+    0x8000, // 10: push noblock
+    0xA22B, // 11: mov x, ~null [2]
+    0x00CE, // 12: low_loop: jmp pin low_high
+    0x014C, // 13: jmp x-- low_loop [1]
+    0x004F, // 14: low_high: jmp x-- low_high_y
+    0xA047, // 15: low_high_y: mov y, osr
+    0x00D2, // 16: low_filter: jmp pin low_filter_tick
+    0x014C, // 17: jmp x-- low_loop [1]
+    0x0053, // 18: low_filter_tick: jmp x-- low_filter_y
+    0x0090, // 19: low_filter_y: jmp y-- low_filter
+    0x4041, // 20: in y, 1
+    0x403F, // 21: in x, 31
+    0x8000, // 22: push noblock
+    0xA22B, // 23: mov x, ~null [2]                    (wrap)
+    0x0142, // 24: high_tick: jmp x-- high_loop [1]
+};
+
+#define PROGRAM_LENGTH (sizeof(button_timer_program) / sizeof(button_timer_program[0]))
+#define WRAP_TARGET 2
+#define WRAP 23
+
+/*
+ * A waveform as a list of levels and how many cycles each lasts, starting
+ * released (high)
+ */
+struct segment
+{
+    bool pin;
+    uint32_t cycles;
+};
+
+struct run
+{
+    struct button_width widths[MAX_WIDTHS];
+    unsigned count;
+};
+
+static void run_waveform(const struct segment *segments, unsigned count, uint32_t filter_ticks, struct run *run)
+{
+    struct pio_model sm;
+    uint32_t word;
+
+    pio_model_init(&sm, button_timer_program, PROGRAM_LENGTH, WRAP_TARGET, WRAP);
+    // As button_timer_init() does: the program waits for filter + 2 samples
+    CHECK(pio_model_put(&sm, filter_ticks - BUTTON_TIMER_FILTER_MIN_TICKS));
+    run->count = 0;
+    for (unsigned s = 0; s < count; s++)
+    {
+        for (uint32_t c = 0; c < segments[s].cycles; c++)
+        {
+            pio_model_step(&sm, segments[s].pin);
+            while (pio_model_get(&sm, &word) && run->count < MAX_WIDTHS)
+            {
+                run->widths[run->count++] = button_timer_decode(word);
+            }
+        }
+    }
+    CHECK(!sm.unsupported);
+    CHECK_EQ(sm.rx_dropped, 0);
+}
+
+/*
+ * Presses and gaps of random lengths with clean edges: every width comes
+ * out within a tick of the waveform, and the errors do not add up
+ */
+static void check_clean(uint32_t filter_ticks)
+{
+    struct segment segments[41];
+    static struct run run;
+    int64_t drift = 0;
+
+    srand(filter_ticks);
+    for (unsigned i = 0; i < 41; i++)
+    {
+        segments[i].pin = i % 2 == 0;
+        segments[i].cycles = CYCLES_PER_TICK * (filter_ticks + 20) + (uint32_t)(rand() % 3000);
+    }
+    run_waveform(segments, 41, filter_ticks, &run);
+
+    // The first gap starts before the program, every later edge is timed from the last
+    CHECK_EQ(run.count, 40);
+    for (unsigned i = 1; i < run.count && i < 40; i++)
+    {
+        int64_t cycles = (int64_t)run.widths[i].us * CYCLES_PER_TICK;
+        int64_t error = cycles - (int64_t)segments[i].cycles;
+
+        CHECK_EQ(run.widths[i].pressed, !segments[i].pin);
+        CHECK(error >= -CYCLES_PER_TICK && error <= CYCLES_PER_TICK);
+        drift += error;
+        CHECK(drift >= -CYCLES_PER_TICK && drift <= CYCLES_PER_TICK);
+    }
+}
+
+/*
+ * Each edge bounces a few times, and some phases carry a glitch shorter
+ * than the filter: only the settled edges count, and the widths run from
+ * one settled edge to the next
+ */
+static void check_bounce(uint32_t filter_ticks)
+{
+    static struct segment segments[400];
+    static struct run run;
+    uint32_t phases[21];
+    unsigned count = 0;
+    uint32_t glitch = CYCLES_PER_TICK * (filter_ticks - 1); // Too short to sample filter_ticks times
+
+    srand(filter_ticks + 1000);
+    for (unsigned i = 0; i < 21; i++)
+    {
+        bool pin = i % 2 == 0;
+        uint32_t length = CYCLES_PER_TICK * (4 * filter_ticks + 40) + (uint32_t)(rand() % 3000);
+
+        // Bounce into the new level, then settle. The flicks back are a tick or
+        // more, so a sample always sees them and starts the filter again.
+        if (i > 0)
+        {
+            for (int b = rand() % 4; b > 0; b--)
+            {
+                segments[count++] = (struct segment){pin, 1 + (uint32_t)rand() % glitch};
+                segments[count++] = (struct segment){!pin, CYCLES_PER_TICK + (uint32_t)rand() % glitch};
+                // A phase runs until the next one settles
+                phases[i - 1] += segments[count - 2].cycles + segments[count - 1].cycles;
+            }
+        }
+        phases[i] = length;
+        segments[count++] = (struct segment){pin, length / 2};
+        segments[count++] = (struct segment){!pin, glitch};
+        segments[count++] = (struct segment){pin, length - length / 2 - glitch};
+    }
+    run_waveform(segments, count, filter_ticks, &run);
+
+    CHECK_EQ(run.count, 20);
+    for (unsigned i = 1; i < run.count && i < 20; i++)
+    {
+        int64_t error = (int64_t)run.widths[i].us * CYCLES_PER_TICK - (int64_t)phases[i];
+
+        CHECK_EQ(run.widths[i].pressed, i % 2 == 1);
+        CHECK(error >= -CYCLES_PER_TICK && error <= CYCLES_PER_TICK);
+    }
+}
+
+/*
+ * The program needs filter_ticks samples of the new level in a row: a
+ * press that long counts, one a tick shorter cannot be sampled enough
+ */
+static void check_filter_edge(uint32_t filter_ticks)
+{
+    static struct run run;
+    uint32_t settle = CYCLES_PER_TICK * filter_ticks;
+    struct segment segments[] = {
+        {true, 3000}, {false, settle}, {true, 3000}, {false, settle - CYCLES_PER_TICK}, {true, 3000},
+    };
+
+    run_waveform(segments, 5, filter_ticks, &run);
+    // The long enough press ends the first gap and its own end is seen; the short one is lost
+    CHECK_EQ(run.count, 2);
+    CHECK(run.widths[0].pressed == false && run.widths[1].pressed == true);
+}
+
+int main(void)
+{
+    CHECK(PROGRAM_LENGTH <= 32);
+    for (uint32_t filter = BUTTON_TIMER_FILTER_MIN_TICKS; filter <= 40; filter += 7)
+    {
+        check_clean(filter);
+        check_bounce(filter);
+        check_filter_edge(filter);
+    }
+    return check_result();
+}
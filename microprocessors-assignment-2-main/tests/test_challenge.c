@@ -0,0 +1,100 @@
+/*
+ * Checks that challenges are drawn in line with the player's errors
+ */
+#include <string.h>
+#include "check.h"
+#include "challenge.h"
+#include "morse.h"
+
+#define DRAWS 200000
+
+static void check_char_weights(void)
+{
+    unsigned drawn[128] = {0};
+
+    challenge_seed(1);
+    challenge_set_deck(false);
+
+    // Q wrong three times: weight 16 against 4 for each of the 35 others
+    for (int i = 0; i < 3; i++)
+    {
+        challenge_record_char('Q', false);
+    }
+    for (int i = 0; i < DRAWS; i++)
+    {
+        drawn[(unsigned char)challenge_next_char()]++;
+    }
+    for (const char *c = alphabet; *c != '\0'; c++)
+    {
+        // The redraw against repeats takes a little off the heavy character
+        double share = (double)drawn[(unsigned char)*c] / DRAWS;
+        if (*c == 'Q')
+        {
+            CHECK(share > 0.08 && share < 16.0 / 156);
+        }
+        else
+        {
+            CHECK(share > 0.022 && share < 0.029);
+        }
+    }
+
+    // Right answers work the errors off again
+    for (int i = 0; i < 3; i++)
+    {
+        challenge_record_char('Q', true);
+    }
+    memset(drawn, 0, sizeof drawn);
+    for (int i = 0; i < DRAWS; i++)
+    {
+        drawn[(unsigned char)challenge_next_char()]++;
+    }
+    CHECK((double)drawn['Q'] / DRAWS < 0.032);
+
+    // Characters without a code are not recorded
+    challenge_record_char('?', false);
+    challenge_record_char('\0', false);
+}
+
+static void check_review_pool(void)
+{
+    char word[DICTIONARY_WORD_MAX + 1];
+    unsigned review = 0, cave = 0;
+
+    challenge_seed(2);
+    challenge_reset_words();
+    CHECK(!challenge_next_word(word));
+
+    // One miss puts a word in the pool at the weight of the fresh slot
+    challenge_record_word("cave", false);
+    for (int i = 0; i < DRAWS; i++)
+    {
+        if (challenge_next_word(word))
+        {
+            review++;
+            cave += strcmp(word, "cave") == 0;
+        }
+    }
+    CHECK_EQ(cave, review);
+    CHECK(review > DRAWS * 0.48 && review < DRAWS * 0.52);
+
+    // Worked off, it leaves the pool
+    challenge_record_word("cave", true);
+    for (int i = 0; i < 1000; i++)
+    {
+        CHECK(!challenge_next_word(word));
+    }
+
+    // Fresh indices stay in range
+    for (int i = 0; i < 1000; i++)
+    {
+        CHECK(challenge_fresh_index(7) < 7);
+    }
+    CHECK_EQ(challenge_fresh_index(0), 0);
+}
+
+int main(void)
+{
+    check_char_weights();
+    check_review_pool();
+    return check_result();
+}
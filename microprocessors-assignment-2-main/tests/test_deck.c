@@ -0,0 +1,157 @@
+/*
+ * Checks that card and index decks draw every card once per pass, never
+ * repeat a card across a reshuffle and replay with the seed
+ */
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "deck.h"
+#include "rng.h"
+
+#define PASSES 200
+
+static void check_card_deck(unsigned count)
+{
+    struct card_deck deck;
+    bool seen[DECK_MAX_CARDS];
+    unsigned last = DECK_MAX_CARDS;
+    unsigned dealt = count > DECK_MAX_CARDS ? DECK_MAX_CARDS : count;
+
+    card_deck_init(&deck, count);
+    CHECK_EQ(deck.count, dealt);
+    if (dealt == 0)
+    {
+        CHECK_EQ(card_deck_draw(&deck), 0);
+        return;
+    }
+    for (int pass = 0; pass < PASSES; pass++)
+    {
+        memset(seen, 0, sizeof(seen));
+        for (unsigned i = 0; i < dealt; i++)
+        {
+            unsigned card = card_deck_draw(&deck);
+            CHECK(card < dealt);
+            if (card >= dealt)
+            {
+                continue;
+            }
+            CHECK(!seen[card]);
+            seen[card] = true;
+            // The first card of a reshuffle is never the one just drawn
+            if (i == 0 && dealt > 1)
+            {
+                CHECK(card != last);
+            }
+            last = card;
+        }
+    }
+}
+
+/*
+ * Each pass of count draws must hit every index exactly once
+ */
+static void check_index_deck(uint32_t count, int passes)
+{
+    struct index_deck deck;
+    uint8_t *seen = calloc(count, 1);
+
+    index_deck_init(&deck, count);
+    CHECK_EQ(deck.count, count);
+    CHECK(((uint64_t)1 << (2 * deck.half_bits)) >= count);
+    CHECK(deck.half_bits == 1 || ((uint64_t)1 << (2 * deck.half_bits - 2)) < count);
+    if (count == 0)
+    {
+        CHECK_EQ(index_deck_draw(&deck), 0);
+        free(seen);
+        return;
+    }
+    for (int pass = 0; pass < passes; pass++)
+    {
+        uint32_t missing = 0;
+
+        memset(seen, 0, count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            uint32_t index = index_deck_draw(&deck);
+            CHECK(index < count);
+            if (index < count)
+            {
+                seen[index]++;
+            }
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            missing += seen[i] != 1;
+        }
+        CHECK_EQ(missing, 0);
+    }
+    free(seen);
+}
+
+/*
+ * The same seed deals the same cards and indices
+ */
+static void check_replay(void)
+{
+    struct card_deck cards;
+    struct index_deck indices;
+    unsigned dealt[100];
+    uint32_t drawn[100];
+
+    rng_seed(99);
+    card_deck_init(&cards, 36);
+    index_deck_init(&indices, 5000);
+    for (int i = 0; i < 100; i++)
+    {
+        dealt[i] = card_deck_draw(&cards);
+        drawn[i] = index_deck_draw(&indices);
+    }
+    rng_seed(99);
+    card_deck_init(&cards, 36);
+    index_deck_init(&indices, 5000);
+    for (int i = 0; i < 100; i++)
+    {
+        CHECK_EQ(card_deck_draw(&cards), dealt[i]);
+        CHECK_EQ(index_deck_draw(&indices), drawn[i]);
+    }
+}
+
+/*
+ * Passes of an index deck are new permutations, not the same one again
+ */
+static void check_rekey(void)
+{
+    struct index_deck deck;
+    uint32_t first[64];
+    int same = 0;
+
+    index_deck_init(&deck, 64);
+    for (int i = 0; i < 64; i++)
+    {
+        first[i] = index_deck_draw(&deck);
+    }
+    for (int i = 0; i < 64; i++)
+    {
+        same += index_deck_draw(&deck) == first[i];
+    }
+    CHECK(same < 16);
+}
+
+int main(void)
+{
+    static const uint32_t counts[] = {0, 1, 2, 3, 4, 5, 7, 15, 16, 17, 36, 255, 1000, 4097, 65535, 65536, 100000};
+
+    rng_seed(0x12345678u);
+    for (unsigned count = 0; count <= DECK_MAX_CARDS + 1; count++)
+    {
+        check_card_deck(count);
+    }
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        check_index_deck(counts[i], counts[i] > 10000 ? 2 : 20);
+    }
+    check_replay();
+    check_rekey();
+    return check_result();
+}
@@ -0,0 +1,281 @@
+/*
+ * Checks the dictionary built by tools/mkdict.py through both ways of
+ * opening it: linked in with .incbin as the firmware does
+ * (dictionary_blob.S), and mapped from the file with dictionary_mmap.c.
+ * The words must read back in order and in any order, with lookup by text,
+ * prefix search, the rank order and the duration index.
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "check.h"
+#include "dictionary_mmap.h"
+
+/*
+ * The firmware's dictionary_blob.S, in host assembler syntax
+ */
+__asm__(".section .rodata\n"
+        ".balign 8\n"
+        "test_dictionary_blob:\n"
+        ".incbin \"" DICTIONARY_BIN "\"\n"
+        "test_dictionary_blob_end:\n"
+        ".balign 8\n"
+        "test_dictionary_blob_size:\n"
+        ".quad test_dictionary_blob_end - test_dictionary_blob\n"
+        ".text\n");
+extern const uint64_t test_dictionary_blob[];
+extern const size_t test_dictionary_blob_size;
+
+static uint32_t random_state = 1;
+
+static uint32_t next_random(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+/*
+ * Reads words.txt the way mkdict.py --words does, into one sorted array
+ */
+static char (*read_word_list(size_t *count))[DICTIONARY_WORD_MAX + 1]
+{
+    char (*words)[DICTIONARY_WORD_MAX + 1] = NULL;
+    char line[256];
+    FILE *file = fopen(WORDS_TXT, "r");
+
+    *count = 0;
+    CHECK(file != NULL);
+    while (file != NULL && fgets(line, sizeof line, file) != NULL)
+    {
+        char *word = line;
+        size_t length;
+
+        line[strcspn(line, "#\r\n")] = '\0';
+        word += strspn(word, " \t");
+        length = strcspn(word, " \t");
+        word[length] = '\0';
+        if (length == 0 || length > DICTIONARY_WORD_MAX)
+        {
+            continue;
+        }
+        words = realloc(words, (*count + 1) * sizeof *words);
+        strcpy(words[(*count)++], word);
+    }
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+    qsort(words, *count, sizeof *words, (int (*)(const void *, const void *))strcmp);
+    return words;
+}
+
+/*
+ * Every word decodes from its block, in sorted order, and comes back from
+ * its own text; words decoded out of order are the same as in order
+ */
+static void check_word_list(const struct dictionary *dict)
+{
+    size_t count = dictionary_count(dict);
+    size_t listed;
+    char (*words)[DICTIONARY_WORD_MAX + 1] = read_word_list(&listed);
+    char word[DICTIONARY_WORD_MAX + 1];
+
+    CHECK_EQ(count, listed);
+    for (size_t i = 0; i < count && i < listed; i++)
+    {
+        CHECK(dictionary_word(dict, i, word));
+        CHECK(strcmp(word, words[i]) == 0);
+        CHECK_EQ(dictionary_lookup(dict, word), i);
+        CHECK_EQ(dictionary_morse(dict, i), morse_encode_word(word));
+        CHECK_EQ(dictionary_units(dict, i), morse_duration(morse_encode_word(word)));
+    }
+    for (int i = 0; i < 10000 && count == listed; i++)
+    {
+        size_t index = next_random() % count;
+        CHECK(dictionary_word(dict, index, word));
+        CHECK(strcmp(word, words[index]) == 0);
+    }
+    CHECK(!dictionary_word(dict, count, word));
+    CHECK_EQ(dictionary_lookup(dict, "zzzzzzzzzz"), -1);
+    free(words);
+}
+
+/*
+ * Index of the first word at or after prefix, found the slow way
+ */
+static size_t scan_lower_bound(const struct dictionary *dict, const char *prefix)
+{
+    char word[DICTIONARY_WORD_MAX + 1];
+    size_t index = 0;
+
+    while (dictionary_word(dict, index, word) && strcmp(word, prefix) < 0)
+    {
+        index++;
+    }
+    return index;
+}
+
+static void check_words(const struct dictionary *dict)
+{
+    size_t count = dictionary_count(dict);
+    char previous[DICTIONARY_WORD_MAX + 1] = "";
+    char word[DICTIONARY_WORD_MAX + 1];
+    char prefix[DICTIONARY_WORD_MAX + 2];
+    bool *ranked = calloc(count, sizeof *ranked);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t length;
+        morse_word_t morse;
+
+        CHECK(dictionary_word(dict, i, word));
+        CHECK(strcmp(previous, word) < 0);
+        strcpy(previous, word);
+        length = strlen(word);
+        morse = morse_encode_word(word);
+
+        CHECK_EQ(dictionary_lookup(dict, word), i);
+        CHECK_EQ(dictionary_morse(dict, i), morse);
+        CHECK_EQ(dictionary_units(dict, i), morse_duration(morse));
+        CHECK_EQ(dictionary_match_keys(dict)[i], morse << (MORSE_FIELD_BITS * (MORSE_WORD_MAX_LETTERS - length)));
+        CHECK_EQ(dictionary_lower_bound(dict, word), i);
+
+        // Prefixes, and words that sort just after this one
+        for (size_t cut = 1; cut < length; cut++)
+        {
+            memcpy(prefix, word, cut);
+            prefix[cut] = '\0';
+            CHECK_EQ(dictionary_lower_bound(dict, prefix), scan_lower_bound(dict, prefix));
+        }
+        strcpy(prefix, word);
+        strcat(prefix, "0");
+        CHECK_EQ(dictionary_lower_bound(dict, prefix), i + 1);
+
+        // The rank section is a permutation of the indices
+        size_t index = dictionary_ranked(dict, i);
+        CHECK(index < count && !ranked[index]);
+        if (index < count)
+        {
+            ranked[index] = true;
+        }
+    }
+    CHECK(!dictionary_word(dict, count, word));
+    CHECK_EQ(dictionary_lower_bound(dict, ""), 0);
+    CHECK_EQ(dictionary_lower_bound(dict, "zzzzzzzzzz"), scan_lower_bound(dict, "zzzzzzzzzz"));
+    free(ranked);
+}
+
+static void check_durations(const struct dictionary *dict)
+{
+    size_t total = 0;
+    size_t first;
+
+    for (unsigned units = 0; units <= 256; units++)
+    {
+        size_t found = dictionary_duration_range(dict, units, units, &first);
+        for (size_t position = first; position < first + found; position++)
+        {
+            CHECK_EQ(dictionary_units(dict, dictionary_duration_word(dict, position)), units);
+        }
+        total += found;
+    }
+    CHECK_EQ(total, dictionary_count(dict));
+    CHECK_EQ(dictionary_duration_range(dict, 0, 1000, &first), dictionary_count(dict));
+    CHECK_EQ(first, 0);
+    CHECK_EQ(dictionary_duration_range(dict, 20, 10, &first), 0);
+}
+
+static void check_views(void)
+{
+    struct dictionary linked, mapped;
+    uint64_t *copy;
+
+    CHECK(dictionary_open(&linked, test_dictionary_blob, test_dictionary_blob_size));
+    CHECK(dictionary_map(&mapped, DICTIONARY_BIN));
+    check_word_list(&linked);
+    CHECK_EQ(linked.header->size, test_dictionary_blob_size);
+    CHECK_EQ(mapped.header->size, linked.header->size);
+    CHECK(memcmp(mapped.base, linked.base, linked.header->size) == 0);
+    check_words(&linked);
+    check_durations(&linked);
+    check_words(&mapped);
+    dictionary_unmap(&mapped);
+
+    // Opening checks the alignment and the header
+    copy = malloc(test_dictionary_blob_size + 8);
+    memcpy((uint8_t *)copy + 4, test_dictionary_blob, test_dictionary_blob_size);
+    CHECK(!dictionary_open(&linked, (uint8_t *)copy + 4, test_dictionary_blob_size));
+    memcpy(copy, test_dictionary_blob, test_dictionary_blob_size);
+    CHECK(!dictionary_open(&linked, copy, test_dictionary_blob_size - 1));
+    copy[0] ^= 1;
+    CHECK(!dictionary_open(&linked, copy, test_dictionary_blob_size));
+    free(copy);
+    CHECK(!dictionary_map(&mapped, "no/such/dictionary.bin"));
+}
+
+/*
+ * A file with bytes after the blob still opens, and unmapping it releases
+ * the whole mapping, not only header->size
+ */
+static void check_trailing(void)
+{
+    char path[] = "/tmp/test_dictionary_XXXXXX";
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = test_dictionary_blob_size + 3 * page;
+    uint8_t *file = calloc(size, 1);
+    struct dictionary dict;
+    const uint8_t *base;
+    int fd = mkstemp(path);
+
+    CHECK(fd >= 0);
+    memcpy(file, test_dictionary_blob, test_dictionary_blob_size);
+    CHECK(fd >= 0 && write(fd, file, size) == (ssize_t)size);
+    close(fd);
+    free(file);
+
+    CHECK(dictionary_map(&dict, path));
+    unlink(path);
+    CHECK_EQ(dict.size, size);
+    CHECK_EQ(dict.header->size, test_dictionary_blob_size);
+    check_words(&dict);
+    base = dict.base;
+    dictionary_unmap(&dict);
+    CHECK(dict.base == NULL && dict.size == 0);
+
+    // msync() fails with ENOMEM on pages that are no longer mapped
+    for (size_t offset = 0; offset < size; offset += page)
+    {
+        errno = 0;
+        CHECK(msync((void *)(base + offset), page, MS_ASYNC) == -1 && errno == ENOMEM);
+    }
+}
+
+static void check_corpus(void)
+{
+    static const char *const expected[] = {"the", "code", "morse", "key"};
+    struct dictionary dict;
+    char word[DICTIONARY_WORD_MAX + 1];
+
+    // corpus.txt ranked with --min-count 2: single letters and rare words are left out
+    CHECK(dictionary_map(&dict, CORPUS_DICTIONARY_BIN));
+    CHECK_EQ(dictionary_count(&dict), 4);
+    for (size_t rank = 0; rank < 4; rank++)
+    {
+        CHECK(dictionary_word(&dict, dictionary_ranked(&dict, rank), word));
+        CHECK(strcmp(word, expected[rank]) == 0);
+    }
+    check_words(&dict);
+    dictionary_unmap(&dict);
+}
+
+int main(void)
+{
+    check_views();
+    check_trailing();
+    check_corpus();
+    return check_result();
+}
@@ -0,0 +1,112 @@
+/*
+ * Checks the edge-storm accounting (histogram, percentiles, losses) and
+ * runs trains through the simulated GPIO into the real edge ring and
+ * session_edge(), at rates it must keep up with and rates it cannot
+ */
+#include "check.h"
+#include "gpio_model.h"
+
+#define SYS_HZ 125000000u  // RP2040 default clk_sys
+#define CONSUME_NS 10000u  // Main loop time per edge assumed for the model
+
+static struct edge_ring ring;
+static struct edge_bench bench;
+
+/*
+ * Latencies fed straight to edge_bench_edge() come back as percentiles
+ * within the histogram's resolution
+ */
+static void check_percentiles(void)
+{
+    struct edge_bench_result result;
+
+    edge_bench_start(&bench, 3, 0);
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        struct edge_event edge = {.time_us = 1000000 + 1000 * i, .channel = 3,
+                                  .type = (uint8_t)(i % 2 == 0 ? EDGE_PRESSED : EDGE_RELEASED)};
+        // 0-9 us for most, 1000 us for one in a hundred
+        uint32_t latency = i % 100 == 99 ? 1000 : i % 10;
+        edge_bench_edge(&bench, &edge, edge.time_us + latency);
+    }
+    edge_bench_finish(&bench, 1000, 1000, 0, &result);
+    CHECK_EQ(result.received, 1000);
+    CHECK_EQ(result.disorder, 0);
+    CHECK(edge_bench_sustained(&result));
+    CHECK_EQ(result.p50_us, 4);
+    CHECK_EQ(result.p99_us, 9);
+    CHECK_EQ(result.max_us, 1000);
+    // Above 16 us the buckets are an eighth of an octave, and never past the slowest edge
+    CHECK(result.p999_us >= 1000 && result.p999_us <= 1000);
+
+    // A wrong channel, a repeated type and time going back are all disorder
+    struct edge_event stray = {.time_us = 5, .channel = 4, .type = EDGE_RELEASED};
+    edge_bench_edge(&bench, &stray, 10);
+    edge_bench_finish(&bench, 1000, 1001, 0, &result);
+    CHECK_EQ(result.disorder, 1);
+    CHECK(!edge_bench_sustained(&result));
+
+    // Edges not received and not dropped by the ring were merged in INTR
+    edge_bench_finish(&bench, 1000, 1100, 30, &result);
+    CHECK_EQ(result.ring_full, 30);
+    CHECK_EQ(result.merged, 1100 - 1001 - 30);
+}
+
+static void check_storms(void)
+{
+    struct gpio_model_cost cost;
+    struct edge_bench_result result;
+    bool kept_up = true;
+    uint32_t highest = 0;
+
+    gpio_model_isr_cost(&cost, SYS_HZ);
+    CHECK(cost.entry_ns > 0 && cost.isr_ns > 0 && cost.extra_edge_ns > 0);
+    CHECK_EQ(cost.consume_ns, 0);
+    cost.consume_ns = CONSUME_NS;
+
+    edge_ring_init(&ring);
+    for (int i = 0; i < EDGE_BENCH_RATES; i++)
+    {
+        gpio_model_storm(&cost, edge_bench_rates[i], 2, &ring, &bench, &result);
+        edge_bench_print(&result, i == 0);
+
+        // Every edge is accounted for, however many are lost
+        CHECK_EQ(result.sent, EDGE_BENCH_EDGES);
+        CHECK_EQ(result.received + result.ring_full + result.merged, result.sent);
+        // Once a rate is too fast, every faster one is too
+        if (edge_bench_sustained(&result))
+        {
+            CHECK(kept_up);
+            highest = result.rate;
+        }
+        else
+        {
+            kept_up = false;
+        }
+    }
+
+    // A slow train waits only for the interrupt to finish and the edge to be classified
+    gpio_model_storm(&cost, 1000, 2, &ring, &bench, &result);
+    CHECK(edge_bench_sustained(&result));
+    CHECK(result.p50_us >= CONSUME_NS / 1000 && result.p50_us <= CONSUME_NS / 1000 + 2);
+
+    // 10 us an edge keeps up with 50k edges/s, not with 100k
+    CHECK_EQ(highest, 50000);
+    // At a million edges a second the interrupt cannot take every edge on its own
+    gpio_model_storm(&cost, 1000000, 2, &ring, &bench, &result);
+    CHECK(result.merged > 0 || result.ring_full > 0);
+
+    // There a pass finds a release and the next press pending together, and queues them in that order
+    cost.consume_ns = 0;
+    gpio_model_storm(&cost, 1000000, 2, &ring, &bench, &result);
+    CHECK_EQ(result.merged, 0);
+    CHECK(result.received > 0);
+    CHECK_EQ(result.disorder, 0);
+}
+
+int main(void)
+{
+    check_percentiles();
+    check_storms();
+    return check_result();
+}
@@ -0,0 +1,144 @@
+/*
+ * Checks the edge ring's fill, drop and wrap-around rules, then runs a
+ * producer and a consumer thread against it and checks that every edge
+ * arrives once, in order, or is counted as dropped
+ */
+#include <pthread.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "check.h"
+#include "edge_ring.h"
+
+#define STRESS_EDGES 1000000u
+
+static struct edge_ring ring;
+static atomic_bool producer_done;
+static uint32_t pushed;
+
+static void check_single_thread(void)
+{
+    struct edge_event event;
+
+    edge_ring_init(&ring);
+    CHECK(!edge_ring_pop(&ring, &event));
+    for (uint32_t i = 0; i < EDGE_RING_SIZE; i++)
+    {
+        CHECK(edge_ring_push(&ring, i % 8, i & 1 ? EDGE_RELEASED : EDGE_PRESSED, 1000 + i));
+    }
+    // A full ring drops and counts, and keeps what it has
+    CHECK(!edge_ring_push(&ring, 0, EDGE_PRESSED, 5));
+    CHECK(!edge_ring_push(&ring, 0, EDGE_PRESSED, 6));
+    CHECK_EQ(edge_ring_dropped(&ring), 2);
+    for (uint32_t i = 0; i < EDGE_RING_SIZE; i++)
+    {
+        CHECK(edge_ring_pop(&ring, &event));
+        CHECK_EQ(event.time_us, 1000 + i);
+        CHECK_EQ(event.channel, i % 8);
+        CHECK_EQ(event.type, i & 1 ? EDGE_RELEASED : EDGE_PRESSED);
+    }
+    CHECK(!edge_ring_pop(&ring, &event));
+    CHECK_EQ(ring.high_water, EDGE_RING_SIZE);
+
+    // The free-running indices wrap at 2^32 without losing the fill level
+    edge_ring_init(&ring);
+    atomic_store(&ring.head, UINT32_MAX - 3);
+    atomic_store(&ring.tail, UINT32_MAX - 3);
+    for (uint32_t i = 0; i < EDGE_RING_SIZE; i++)
+    {
+        CHECK(edge_ring_push(&ring, 1, EDGE_PRESSED, i));
+    }
+    CHECK(!edge_ring_push(&ring, 1, EDGE_PRESSED, 0));
+    for (uint32_t i = 0; i < EDGE_RING_SIZE; i++)
+    {
+        CHECK(edge_ring_pop(&ring, &event));
+        CHECK_EQ(event.time_us, i);
+    }
+    CHECK(!edge_ring_pop(&ring, &event));
+
+    // Discard empties the ring but not the drop count
+    CHECK(edge_ring_push(&ring, 2, EDGE_RELEASED, 1));
+    CHECK(edge_ring_push(&ring, 2, EDGE_PRESSED, 2));
+    edge_ring_discard(&ring);
+    CHECK(!edge_ring_pop(&ring, &event));
+    CHECK_EQ(edge_ring_dropped(&ring), 1);
+}
+
+/*
+ * Stands in for the GPIO interrupt: pushes numbered edges in bursts of up
+ * to one and a half rings, so some overflow, and lets the ring drain a
+ * random amount in between
+ */
+static void *producer(void *unused)
+{
+    uint32_t state = 5;
+    uint32_t i = 0;
+
+    (void)unused;
+    while (i < STRESS_EDGES)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        uint32_t burst = 1 + state % (EDGE_RING_SIZE * 3 / 2);
+        uint32_t level = (state >> 8) % EDGE_RING_SIZE;
+
+        for (; burst > 0 && i < STRESS_EDGES; burst--, i++)
+        {
+            pushed += edge_ring_push(&ring, i % 8, i & 1 ? EDGE_RELEASED : EDGE_PRESSED, i);
+        }
+        while (atomic_load(&ring.head) - atomic_load(&ring.tail) > level)
+        {
+            // The test may have a single CPU to share with the consumer
+            thrd_yield();
+        }
+    }
+    atomic_store_explicit(&producer_done, true, memory_order_release);
+    return NULL;
+}
+
+static void check_two_threads(void)
+{
+    pthread_t thread;
+    struct edge_event event;
+    uint64_t last = 0;
+    uint32_t popped = 0;
+    bool any = false;
+
+    edge_ring_init(&ring);
+    atomic_init(&producer_done, false);
+    CHECK_EQ(pthread_create(&thread, NULL, producer, NULL), 0);
+    for (;;)
+    {
+        bool done = atomic_load_explicit(&producer_done, memory_order_acquire);
+
+        while (edge_ring_pop(&ring, &event))
+        {
+            // Edges come out in the order they went in, each whole
+            CHECK(!any || event.time_us > last);
+            CHECK_EQ(event.channel, event.time_us % 8);
+            CHECK_EQ(event.type, event.time_us & 1 ? EDGE_RELEASED : EDGE_PRESSED);
+            last = event.time_us;
+            any = true;
+            popped++;
+        }
+        if (done)
+        {
+            break;
+        }
+        thrd_yield();
+    }
+    pthread_join(thread, NULL);
+
+    CHECK_EQ(popped, pushed);
+    CHECK_EQ(pushed + edge_ring_dropped(&ring), STRESS_EDGES);
+    CHECK(ring.high_water <= EDGE_RING_SIZE);
+    printf("%u edges: %u delivered, %u dropped, high water %u\n", STRESS_EDGES, popped, edge_ring_dropped(&ring),
+           ring.high_water);
+}
+
+int main(void)
+{
+    check_single_thread();
+    check_two_threads();
+    return check_result();
+}
@@ -0,0 +1,158 @@
+/*
+ * Plays scripted paddle traces into the keyer, calling it on every lever
+ * change and at keyer_next() as the main loop does, and checks the
+ * elements it sends and their timing in both iambic modes
+ */
+#include <string.h>
+#include "check.h"
+#include "keyer.h"
+
+#define WPM 20
+#define UNIT_US 60000u // 1.2 s / 20 WPM
+#define MAX_SENT 32
+
+/*
+ * The levers from at_x10 tenths of a unit on
+ */
+struct lever_change
+{
+    unsigned at_x10;
+    bool dot;
+    bool dash;
+};
+
+/*
+ * Runs a trace and returns the elements as a string of '.' and '-'
+ */
+static void play(enum keyer_mode mode, const struct lever_change *trace, int changes, char *sent)
+{
+    struct keyer keyer;
+    struct keyer_element done[KEYER_ELEMENTS_MAX];
+    bool dot = false, dash = false;
+    int next_change = 0;
+    int length = 0;
+    uint64_t first = 0;
+
+    keyer_init(&keyer, mode, WPM);
+    CHECK_EQ(keyer.unit_us, UNIT_US);
+    for (;;)
+    {
+        uint64_t deadline, now;
+        bool pending = keyer_next(&keyer, &deadline);
+
+        if (next_change < changes && (!pending || (uint64_t)trace[next_change].at_x10 * UNIT_US / 10 <= deadline))
+        {
+            now = (uint64_t)trace[next_change].at_x10 * UNIT_US / 10;
+            dot = trace[next_change].dot;
+            dash = trace[next_change].dash;
+            next_change++;
+        }
+        else if (pending)
+        {
+            now = deadline;
+        }
+        else
+        {
+            break;
+        }
+
+        int count = keyer_update(&keyer, now, dot, dash, done, KEYER_ELEMENTS_MAX);
+        CHECK(count <= 1);
+        for (int i = 0; i < count && length < MAX_SENT; i++)
+        {
+            if (length == 0)
+            {
+                first = done[i].start_us;
+            }
+            // Exactly 1 or 3 units long, starting on the unit grid from the first press
+            CHECK_EQ(done[i].end_us - done[i].start_us, (done[i].dash ? 3 : 1) * UNIT_US);
+            CHECK_EQ((done[i].start_us - first) % UNIT_US, 0);
+            sent[length++] = done[i].dash ? '-' : '.';
+        }
+        CHECK_EQ(keyer_key_down(&keyer), keyer.state == KEYER_MARK);
+    }
+    sent[length] = '\0';
+    CHECK_EQ(keyer.state, KEYER_IDLE);
+}
+
+static void check_trace(enum keyer_mode mode, const struct lever_change *trace, int changes, const char *expected)
+{
+    char sent[MAX_SENT + 1];
+
+    play(mode, trace, changes, sent);
+    if (strcmp(sent, expected) != 0)
+    {
+        printf("mode %c sent \"%s\", expected \"%s\"\n", mode == KEYER_IAMBIC_A ? 'A' : 'B', sent, expected);
+        check_failures++;
+    }
+}
+
+#define TRACE(...) (const struct lever_change[]){__VA_ARGS__}, sizeof((const struct lever_change[]){__VA_ARGS__}) / sizeof(struct lever_change)
+
+static void check_both_modes(void)
+{
+    for (enum keyer_mode mode = KEYER_IAMBIC_A; mode <= KEYER_IAMBIC_B; mode++)
+    {
+        // One lever held sends its element, let go during the third
+        check_trace(mode, TRACE({0, true, false}, {45, false, false}), "...");
+        check_trace(mode, TRACE({0, false, true}, {65, false, false}), "--");
+        // A tap shorter than a dot still sends a whole one
+        check_trace(mode, TRACE({0, true, false}, {2, false, false}), ".");
+        // Dot memory: tapped during a dash with the dash lever still held, the dot goes next
+        check_trace(mode, TRACE({0, false, true}, {10, true, true}, {12, false, true}, {65, false, false}), "-.-");
+        // Dash memory in the gap after a dot
+        check_trace(mode, TRACE({0, true, false}, {8, false, false}, {13, false, true}, {14, false, false}), ".-");
+        // A squeeze held alternates, from whichever lever came first
+        check_trace(mode, TRACE({0, true, false}, {5, true, true}, {115, false, false}), mode == KEYER_IAMBIC_A ? ".-.-" : ".-.-.");
+        check_trace(mode, TRACE({0, false, true}, {5, true, true}, {95, false, false}), mode == KEYER_IAMBIC_A ? "-.-" : "-.-.");
+        // Both levers at once: the dot goes first
+        check_trace(mode, TRACE({0, true, true}, {45, false, false}), mode == KEYER_IAMBIC_A ? ".-" : ".-.");
+    }
+    // Modes differ on a squeeze let go during an element: A stops, B sends one more
+    check_trace(KEYER_IAMBIC_A, TRACE({0, true, false}, {5, true, true}, {45, false, false}), ".-");
+    check_trace(KEYER_IAMBIC_B, TRACE({0, true, false}, {5, true, true}, {45, false, false}), ".-.");
+    // Let go in the gap after the first element, A sends nothing more and B the one opposite
+    check_trace(KEYER_IAMBIC_A, TRACE({0, true, true}, {15, false, false}), ".");
+    check_trace(KEYER_IAMBIC_B, TRACE({0, true, true}, {15, false, false}), ".-");
+    // Letting go of one lever of a squeeze goes on with the other
+    check_trace(KEYER_IAMBIC_A, TRACE({0, true, true}, {5, false, true}, {85, false, false}), ".--");
+    // A squeeze still held as the next element starts is remembered too
+    check_trace(KEYER_IAMBIC_A, TRACE({0, true, true}, {25, false, true}, {85, false, false}), ".-.-");
+}
+
+/*
+ * A late call catches up on the grid, and an off keyer does nothing
+ */
+static void check_late_and_off(void)
+{
+    struct keyer keyer;
+    struct keyer_element done[KEYER_ELEMENTS_MAX];
+    uint64_t deadline;
+
+    keyer_init(&keyer, KEYER_IAMBIC_B, WPM);
+    CHECK_EQ(keyer_update(&keyer, 1000, true, false, done, KEYER_ELEMENTS_MAX), 0);
+    CHECK(keyer_key_down(&keyer));
+    CHECK(keyer_next(&keyer, &deadline) && deadline == 1000 + UNIT_US);
+    CHECK_EQ(keyer_update(&keyer, 1000 + 15 * UNIT_US / 2, true, false, done, KEYER_ELEMENTS_MAX), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK(!done[i].dash);
+        CHECK_EQ(done[i].start_us, 1000 + 2 * i * UNIT_US);
+    }
+    // Only max elements are written, the rest still happen on time
+    CHECK_EQ(keyer_update(&keyer, 1000 + 20 * UNIT_US, true, false, done, 1), 1);
+    CHECK_EQ(done[0].start_us, 1000 + 8 * UNIT_US);
+    CHECK(keyer_next(&keyer, &deadline) && deadline == 1000 + 21 * UNIT_US);
+
+    keyer_init(&keyer, KEYER_OFF, WPM);
+    CHECK_EQ(keyer_update(&keyer, 0, true, true, done, KEYER_ELEMENTS_MAX), 0);
+    CHECK(!keyer_next(&keyer, &deadline));
+    CHECK(!keyer_key_down(&keyer));
+}
+
+int main(void)
+{
+    check_both_modes();
+    check_late_and_off();
+    return check_result();
+}
@@ -0,0 +1,177 @@
+/*
+ * Keys text at 5-40 WPM with timing jitter, starting from a wrong speed,
+ * and checks that the classifier learns the speed and then sorts every
+ * press and gap correctly, including after a change of speed
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "keying.h"
+#include "morse.h"
+
+#define WARM_UP 20 // Presses the classifier gets to learn before it is scored
+
+static const char text[] = "the quick brown fox jumps over the lazy dog 0123456789 paris morse code";
+
+static uint32_t state = 3;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+struct score
+{
+    unsigned marks;
+    unsigned gaps;
+    unsigned wrong;
+};
+
+/*
+ * A width of units dots at unit_us, off by up to jitter percent either way
+ */
+static uint32_t jittered(uint32_t units, uint32_t unit_us, uint32_t jitter)
+{
+    int64_t width = (int64_t)units * unit_us;
+    int64_t spread = width * jitter / 100;
+
+    if (spread > 0)
+    {
+        width += (int64_t)(next_random() % (2 * spread + 1)) - spread;
+    }
+    return (uint32_t)width;
+}
+
+static void score_gap(struct keying *keying, struct score *score, enum keying_gap kind, uint32_t units,
+                      uint32_t unit_us, uint32_t jitter)
+{
+    enum keying_gap got = keying_gap(keying, jittered(units, unit_us, jitter));
+
+    if (score->marks > WARM_UP)
+    {
+        score->gaps++;
+        score->wrong += got != kind;
+    }
+}
+
+/*
+ * Keys text at wpm the way a player would, with the standard 1:3:7 spacing
+ */
+static void key_text(struct keying *keying, unsigned wpm, uint32_t jitter, struct score *score)
+{
+    uint32_t unit_us = KEYING_PARIS_US / wpm;
+    bool first = true;
+
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        if (*c == ' ')
+        {
+            score_gap(keying, score, KEYING_GAP_WORD, 7, unit_us, jitter);
+            first = true;
+            continue;
+        }
+        if (!first && c[-1] != ' ')
+        {
+            score_gap(keying, score, KEYING_GAP_LETTER, 3, unit_us, jitter);
+        }
+        first = false;
+
+        morse_code_t code = morse_encode(*c);
+        for (int i = morse_code_length(code) - 1; i >= 0; i--)
+        {
+            bool dash = (code >> i) & 1;
+            bool got = keying_mark(keying, jittered(dash ? 3 : 1, unit_us, jitter));
+
+            score->marks++;
+            if (score->marks > WARM_UP)
+            {
+                score->wrong += got != dash;
+            }
+            if (i > 0)
+            {
+                score_gap(keying, score, KEYING_GAP_ELEMENT, 1, unit_us, jitter);
+            }
+        }
+    }
+}
+
+static void check_speed(unsigned start_wpm, unsigned wpm, uint32_t jitter)
+{
+    struct keying keying;
+    struct score score = {0};
+    unsigned estimate;
+
+    keying_init(&keying, start_wpm);
+    key_text(&keying, wpm, jitter, &score);
+    estimate = keying_wpm(&keying);
+
+    CHECK(score.gaps > 0);
+    CHECK_EQ(score.wrong, 0);
+    // The unit is learnt within the jitter
+    CHECK(estimate * 100 >= wpm * (100 - jitter - 5) && estimate * 100 <= wpm * (100 + jitter + 5));
+    if (score.wrong != 0)
+    {
+        printf("  %u WPM from %u, %u%% jitter: %u of %u wrong, estimate %u WPM\n", wpm, start_wpm, jitter,
+               score.wrong, score.marks + score.gaps, estimate);
+    }
+}
+
+/*
+ * The operator speeds up and slows down in one session
+ */
+static void check_tracking(void)
+{
+    static const unsigned speeds[] = {12, 25, 40, 18, 5, 30};
+    struct keying keying;
+
+    keying_init(&keying, 20);
+    for (size_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++)
+    {
+        struct score score = {0};
+
+        key_text(&keying, speeds[i], 10, &score);
+        CHECK_EQ(score.wrong, 0);
+        CHECK(keying_wpm(&keying) * 10 >= speeds[i] * 8 && keying_wpm(&keying) * 10 <= speeds[i] * 12);
+    }
+}
+
+/*
+ * Only dots (or only dashes) say nothing about the split, the element gaps do
+ */
+static void check_alike(void)
+{
+    struct keying keying;
+    uint32_t unit_us = KEYING_PARIS_US / 25;
+
+    keying_init(&keying, 10);
+    for (int i = 0; i < 12; i++)
+    {
+        keying_mark(&keying, unit_us);
+        keying_gap(&keying, i % 4 == 3 ? 3 * unit_us : unit_us);
+    }
+    CHECK_EQ(keying_wpm(&keying), 25);
+    CHECK(!keying_mark(&keying, unit_us));
+    CHECK(keying_mark(&keying, 3 * unit_us));
+
+    // Pauses too long to learn from leave the unit alone
+    CHECK_EQ(keying_gap(&keying, 10 * KEYING_WIDTH_MAX_US), KEYING_GAP_WORD);
+    CHECK_EQ(keying_wpm(&keying), 25);
+}
+
+int main(void)
+{
+    for (unsigned wpm = 5; wpm <= 40; wpm += 5)
+    {
+        for (uint32_t jitter = 0; jitter <= 20; jitter += 10)
+        {
+            check_speed(15, wpm, jitter);
+            check_speed(wpm < 20 ? 40 : 5, wpm, jitter);
+        }
+    }
+    check_tracking();
+    check_alike();
+    return check_result();
+}
@@ -0,0 +1,291 @@
+/*
+ * Eight keys keying words at once through one interrupt path: pending
+ * INTR bits are scanned as gpio_isr does, decoded with keys_decode(),
+ * queued on one edge ring and handed to a session per key, which must
+ * each read its own word back
+ */
+#include <string.h>
+#include "bench.h"
+#include "check.h"
+#include "keys.h"
+#include "session.h"
+
+#define WPM 25
+#define UNIT_US (KEYING_PARIS_US / WPM)
+#define ROUNDS 40
+#define MAX_EDGES 256
+
+static const unsigned test_pins[KEYS_MAX] = {2, 3, 6, 7, 10, 15, 20, 21};
+static const unsigned lever_pins[] = {4, 11, 22}; // Edges here are not keys and must be ignored
+static const char *const words[] = {"paris", "morse", "code", "key", "tone", "the", "quick", "fox", "jumps", "over"};
+
+static struct edge_ring ring;
+static struct session sessions[KEYS_MAX];
+static uint64_t isr_edges;
+
+struct timed_edge
+{
+    uint64_t time_us;
+    unsigned channel;
+    enum edge_type type;
+};
+
+/*
+ * What gpio_isr does with one read of the three INTR registers: every
+ * pending key edge in the order keys_next_edge() gives, stamped with one
+ * timer read. gpio_in is the pins' levels by then.
+ */
+static void isr(const uint32_t intr[KEYS_BANKS], uint32_t gpio_in, uint64_t now)
+{
+    for (unsigned bank = 0; bank < KEYS_BANKS; bank++)
+    {
+        uint32_t pending = intr[bank] & key_edge_mask[bank];
+
+        while (pending != 0)
+        {
+            uint32_t bit = keys_next_edge(bank, pending, gpio_in);
+            int code = keys_decode(bank, bit);
+
+            pending &= ~bit;
+            CHECK(code >= 0);
+            edge_ring_push(&ring, (unsigned)code >> 1, (enum edge_type)(code & 1), now);
+            isr_edges++;
+        }
+    }
+}
+
+/*
+ * The edges of keying word at the standard spacing from start
+ */
+static int key_word(const char *word, unsigned channel, uint64_t start, struct timed_edge *edges)
+{
+    uint64_t t = start;
+    int count = 0;
+
+    for (const char *c = word; *c != '\0'; c++)
+    {
+        morse_code_t code = morse_encode(*c);
+        for (int i = morse_code_length(code) - 1; i >= 0; i--)
+        {
+            edges[count++] = (struct timed_edge){t, channel, EDGE_PRESSED};
+            t += ((code >> i) & 1 ? 3 : 1) * UNIT_US;
+            edges[count++] = (struct timed_edge){t, channel, EDGE_RELEASED};
+            t += UNIT_US;
+        }
+        t += 2 * UNIT_US;
+    }
+    return count;
+}
+
+/*
+ * The main loop: acts on the timeouts due by now, then hands every queued edge to its key's session
+ */
+static void run_until(uint64_t now)
+{
+    struct edge_event event;
+    uint64_t deadline;
+
+    for (unsigned c = 0; c < KEYS_MAX; c++)
+    {
+        while (session_next(&sessions[c], &deadline) && deadline <= now)
+        {
+            session_expire(&sessions[c], deadline);
+        }
+    }
+    while (edge_ring_pop(&ring, &event))
+    {
+        CHECK(event.channel < KEYS_MAX);
+        session_edge(&sessions[event.channel % KEYS_MAX], &event);
+    }
+}
+
+static void check_rounds(void)
+{
+    static struct timed_edge edges[KEYS_MAX][MAX_EDGES];
+    int counts[KEYS_MAX];
+    int next[KEYS_MAX];
+    uint64_t now = 1000000;
+    uint64_t total = 0;
+    uint32_t gpio_in = ~0u; // Every pin pulled up
+
+    for (unsigned c = 0; c < KEYS_MAX; c++)
+    {
+        session_init(&sessions[c], WPM);
+    }
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        const char *answers[KEYS_MAX];
+
+        // Every key starts on the same unit grid, so edges of different keys often land together
+        for (unsigned c = 0; c < KEYS_MAX; c++)
+        {
+            answers[c] = words[(round + c) % (sizeof(words) / sizeof(words[0]))];
+            session_start(&sessions[c], MORSE_WORD_EMPTY, answers[c], now, true);
+            counts[c] = key_word(answers[c], c, now + (uint64_t)((round + c) % 3) * UNIT_US, edges[c]);
+            next[c] = 0;
+            total += (uint64_t)counts[c];
+        }
+
+        for (;;)
+        {
+            uint32_t intr[KEYS_BANKS] = {0};
+            uint64_t soonest = UINT64_MAX;
+
+            for (unsigned c = 0; c < KEYS_MAX; c++)
+            {
+                if (next[c] < counts[c] && edges[c][next[c]].time_us < soonest)
+                {
+                    soonest = edges[c][next[c]].time_us;
+                }
+            }
+            if (soonest == UINT64_MAX)
+            {
+                break;
+            }
+            run_until(soonest);
+            // Everything due at that moment is pending in one interrupt, with a lever edge now and then
+            for (unsigned c = 0; c < KEYS_MAX; c++)
+            {
+                while (next[c] < counts[c] && edges[c][next[c]].time_us == soonest)
+                {
+                    const struct timed_edge *edge = &edges[c][next[c]++];
+                    unsigned pin = test_pins[edge->channel];
+                    intr[pin / 8] |= 1u << ((pin % 8) * 4 + (edge->type == EDGE_PRESSED ? 2 : 3));
+                    gpio_in = edge->type == EDGE_PRESSED ? gpio_in & ~(1u << pin) : gpio_in | 1u << pin;
+                }
+            }
+            unsigned lever = lever_pins[soonest / UNIT_US % 3];
+            intr[lever / 8] |= 1u << ((lever % 8) * 4 + 2 + (soonest / UNIT_US) % 2);
+            isr(intr, gpio_in, soonest);
+            now = soonest;
+            run_until(now);
+        }
+
+        // A word gap after the last key is let go, every answer is in
+        now += 2 * SESSION_WORD_TIMEOUT_UNITS * UNIT_US;
+        run_until(now);
+        for (unsigned c = 0; c < KEYS_MAX; c++)
+        {
+            CHECK(sessions[c].input.complete);
+            if (sessions[c].verifier.verdict != MORSE_ACCEPTED)
+            {
+                printf("round %d key %u: \"%s\" not read back\n", round, c, answers[c]);
+                check_failures++;
+            }
+        }
+    }
+    CHECK_EQ(isr_edges, total);
+    CHECK_EQ(edge_ring_dropped(&ring), 0);
+    printf("%llu edges from %d keys, ring high water %u\n", (unsigned long long)total, KEYS_MAX, ring.high_water);
+}
+
+/*
+ * A press and release of one key pending together (a tap shorter than the
+ * interrupt latency) come out press first
+ */
+static void check_same_read(void)
+{
+    uint32_t intr[KEYS_BANKS] = {0};
+    struct edge_event first, second;
+
+    edge_ring_init(&ring);
+    intr[2] = 0xFu << ((21 % 8) * 4); // Both levels and both edges of GP21
+    isr(intr, ~0u, 5);
+    CHECK(edge_ring_pop(&ring, &first) && edge_ring_pop(&ring, &second));
+    CHECK_EQ(first.channel, 7);
+    CHECK_EQ(first.type, EDGE_PRESSED);
+    CHECK_EQ(second.channel, 7);
+    CHECK_EQ(second.type, EDGE_RELEASED);
+    CHECK(!edge_ring_pop(&ring, &first));
+}
+
+/*
+ * A release and a new press of one key pending together (bounce on the
+ * release, or a quick re-key) come out release first, as the pin is low
+ * again. The session keeps the key down and takes the next release.
+ */
+static void check_release_press(void)
+{
+    uint32_t intr[KEYS_BANKS] = {0};
+    uint32_t down = ~(1u << 21);
+    struct session *session = &sessions[7];
+    struct edge_event first, second;
+
+    edge_ring_init(&ring);
+    intr[2] = 0xCu << ((21 % 8) * 4); // Both edges of GP21
+    isr(intr, down, 5);
+    CHECK(edge_ring_pop(&ring, &first) && edge_ring_pop(&ring, &second));
+    CHECK_EQ(first.type, EDGE_RELEASED);
+    CHECK_EQ(second.type, EDGE_PRESSED);
+    CHECK(!edge_ring_pop(&ring, &first));
+
+    // Pressed, then let go and pressed again inside one interrupt's latency, then let go
+    session_init(session, WPM);
+    session_start(session, MORSE_WORD_EMPTY, "e", 0, true);
+    intr[2] = 0x4u << ((21 % 8) * 4);
+    isr(intr, down, 1000);
+    run_until(1000);
+    intr[2] = 0xCu << ((21 % 8) * 4);
+    isr(intr, down, 1000 + UNIT_US);
+    run_until(1000 + UNIT_US);
+    CHECK(session->key_down);
+    intr[2] = 0x8u << ((21 % 8) * 4);
+    isr(intr, ~0u, 1000 + 2 * UNIT_US);
+    run_until(1000 + 2 * UNIT_US);
+    CHECK(!session->key_down);
+    CHECK_EQ(session->marks.marks, 2);
+}
+
+/*
+ * Host time per queued edge with one key and with all eight pending at
+ * once, which should be about the same
+ */
+static void time_scan(void)
+{
+    uint32_t one[KEYS_BANKS] = {0}, all[KEYS_BANKS] = {0};
+    uint64_t start, one_ns, all_ns;
+    struct edge_event event;
+
+    one[0] = 1u << (2 * 4 + 2);
+    for (unsigned c = 0; c < KEYS_MAX; c++)
+    {
+        all[test_pins[c] / 8] |= 1u << ((test_pins[c] % 8) * 4 + 2);
+    }
+    start = bench_now_ns();
+    for (int i = 0; i < 1000000; i++)
+    {
+        isr(one, ~0u, (uint64_t)i);
+        edge_ring_discard(&ring);
+    }
+    one_ns = bench_now_ns() - start;
+    start = bench_now_ns();
+    for (int i = 0; i < 1000000; i++)
+    {
+        isr(all, ~0u, (uint64_t)i);
+        edge_ring_discard(&ring);
+    }
+    all_ns = bench_now_ns() - start;
+    CHECK(!edge_ring_pop(&ring, &event));
+    printf("host scan and queue: %.1f ns per edge with 1 key pending, %.1f with %d\n", one_ns / 1e6,
+           all_ns / (1e6 * KEYS_MAX), KEYS_MAX);
+}
+
+int main(void)
+{
+    keys_clear();
+    for (unsigned c = 0; c < KEYS_MAX; c++)
+    {
+        CHECK(keys_add(c, test_pins[c]));
+        CHECK_EQ(key_pins[c], test_pins[c]);
+    }
+    CHECK(!keys_add(KEYS_MAX, 5));
+    CHECK(!keys_add(0, 8 * KEYS_BANKS));
+    CHECK_EQ(keys_decode(0, 1u << (4 * 4 + 2)), -1); // GP4 is a lever, not a key
+
+    edge_ring_init(&ring);
+    check_rounds();
+    check_same_read();
+    check_release_press();
+    time_scan();
+    return check_result();
+}
@@ -0,0 +1,265 @@
+/*
+ * Runs led.c against a faked DMA channel, PIO FIFO and SysTick on a virtual
+ * clock: sending, skipping a colour already shown or on its way, keeping
+ * only the latest waiting colour, the latch gap, and led_bench() putting
+ * the colour back afterwards. The bench's cycle counts here are the fakes';
+ * the board's have not been taken.
+ */
+#include "check.h"
+#include "led.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/structs/systick.h"
+
+#define FRAME_US 30u        // 24 bits at LED_BIT_HZ
+#define RGBW_FRAME_US 40u   // 32 bits
+#define PUT_CYCLES 5000u    // Charged by each blocking FIFO write
+#define START_CYCLES 20u    // Charged by each DMA start
+
+systick_hw_t test_systick;
+
+static struct pio_hw fake_pio;
+static uint64_t now_us;
+static irq_handler_t dma_handler;
+static bool dma_busy;
+static bool dma_irq;
+static uint32_t dma_starts;
+static uint32_t dma_word;   // Word the last transfer read
+static uint32_t fifo_puts;
+
+uint64_t time_us_64(void)
+{
+    return now_us;
+}
+
+void busy_wait_us_32(uint32_t delay_us)
+{
+    now_us += delay_us;
+}
+
+/*
+ * Finishes the transfer going out, as the DMA would a few microseconds on
+ */
+static void finish_dma(void)
+{
+    CHECK(dma_busy);
+    dma_busy = false;
+    dma_irq = true;
+    dma_handler();
+    CHECK(!dma_irq);
+}
+
+void tight_loop_contents(void)
+{
+    now_us++;
+    if (dma_busy)
+    {
+        finish_dma();
+    }
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx)
+{
+    return 0;
+}
+
+void pio_sm_put_blocking(PIO pio, uint sm, uint32_t data)
+{
+    fifo_puts++;
+    test_systick.cvr -= PUT_CYCLES;
+}
+
+bool pio_sm_is_tx_fifo_empty(PIO pio, uint sm)
+{
+    return true;
+}
+
+int dma_claim_unused_channel(bool required)
+{
+    return 3;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    return (dma_channel_config){0};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    CHECK_EQ(channel, 3);
+    CHECK(write_addr == &fake_pio.txf[0]);
+    CHECK(!trigger);
+}
+
+void dma_channel_set_irq0_enabled(uint channel, bool enabled)
+{
+}
+
+bool dma_channel_get_irq0_status(uint channel)
+{
+    return dma_irq;
+}
+
+void dma_channel_acknowledge_irq0(uint channel)
+{
+    dma_irq = false;
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger)
+{
+    // A transfer started over one still going would mix two colours on the line
+    CHECK(!dma_busy);
+    CHECK(trigger);
+    dma_word = *(const volatile uint32_t *)read_addr;
+    dma_busy = true;
+    dma_starts++;
+    test_systick.cvr -= START_CYCLES;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority)
+{
+    CHECK_EQ(num, DMA_IRQ_0);
+    dma_handler = handler;
+}
+
+void irq_set_enabled(uint num, bool enabled)
+{
+}
+
+/*
+ * A colour that comes while one goes out waits, and only the latest is kept
+ */
+static void check_show(void)
+{
+    struct led_stats stats;
+    uint64_t when;
+
+    now_us = 1000;
+    CHECK(led_show(0x00FF00));
+    CHECK_EQ(dma_starts, 1);
+    CHECK_EQ(dma_word, 0x00FF00u << 8);
+    CHECK(!led_next(&when));
+
+    // The same colour again is skipped, while it goes out and after
+    CHECK(led_show(0x00FF00));
+    finish_dma();
+    CHECK(led_show(0x00FF00));
+    CHECK_EQ(dma_starts, 1);
+
+    // A new colour waits out the frame and the latch gap from the DMA finishing
+    now_us += 10;
+    CHECK(!led_show(0x0000FF));
+    CHECK(led_next(&when));
+    CHECK_EQ(when, 1000 + FRAME_US + LED_RESET_US);
+    CHECK(!led_show(0xFF0000));
+    now_us = when - 1;
+    CHECK(!led_show(0xFF0000));
+    now_us = when;
+    CHECK(led_show(0xFF0000));
+    CHECK_EQ(dma_starts, 2);
+    CHECK_EQ(dma_word, 0xFF0000u << 8);
+    CHECK(!led_next(&when));
+
+    // While the DMA is busy the wait is counted from now
+    CHECK(!led_show(0x00FF00));
+    CHECK(led_next(&when));
+    CHECK_EQ(when, now_us + FRAME_US + LED_RESET_US);
+
+    // Changing back to the colour going out drops the wait, and nothing more is sent
+    CHECK(led_show(0xFF0000));
+    CHECK(!led_next(&when));
+    finish_dma();
+    now_us += 1000;
+    CHECK(led_show(0xFF0000));
+    CHECK_EQ(dma_starts, 2);
+
+    led_get_stats(&stats);
+    CHECK_EQ(stats.sent, 2);
+    CHECK_EQ(stats.skipped, 3);
+    CHECK_EQ(stats.replaced, 2);
+}
+
+/*
+ * led_bench() keeps the game's counters and sends the colour that was showing again
+ */
+static void check_bench(void)
+{
+    struct led_bench_result result;
+    struct led_stats before, after;
+    uint64_t when;
+
+    led_get_stats(&before);
+    dma_starts = 0;
+    CHECK(!dma_busy);
+    led_bench(&result);
+
+    CHECK_EQ(fifo_puts, LED_BENCH_UPDATES);
+    CHECK_EQ(result.blocking_cycles, LED_BENCH_UPDATES * PUT_CYCLES);
+    // Every timed led_show() starts a transfer, none waits behind the one before
+    CHECK_EQ(result.dma_cycles, LED_BENCH_UPDATES * START_CYCLES);
+    CHECK_EQ(result.dma_sent, LED_BENCH_UPDATES);
+    CHECK_EQ(result.unchanged_cycles, 0);
+    CHECK_EQ(test_systick.csr, 0);
+    CHECK_EQ(dma_starts, LED_BENCH_UPDATES);
+    CHECK_EQ(dma_word, (LED_BENCH_UPDATES & 1 ? 0x0000FFu : 0x00FF00u) << 8);
+
+    led_get_stats(&after);
+    CHECK_EQ(after.sent, before.sent);
+    CHECK_EQ(after.skipped, before.skipped);
+    CHECK_EQ(after.replaced, before.replaced);
+
+    // The old colour goes out once the bench's last frame has latched
+    CHECK(led_next(&when));
+    finish_dma();
+    now_us = when;
+    CHECK(led_show(0xFF0000));
+    CHECK_EQ(dma_starts, LED_BENCH_UPDATES + 1);
+    CHECK_EQ(dma_word, 0xFF0000u << 8);
+    finish_dma();
+}
+
+/*
+ * An RGBW pixel takes 32 bits, so its frame is longer
+ */
+static void check_rgbw(void)
+{
+    uint64_t when;
+
+    led_init(&fake_pio, 0, true);
+    now_us += 1000;
+    CHECK(led_show(0x123456));
+    CHECK(!led_show(0x654321));
+    finish_dma();
+    CHECK(led_next(&when));
+    CHECK_EQ(when, now_us + RGBW_FRAME_US + LED_RESET_US);
+    now_us = when;
+    CHECK(led_show(0x654321));
+    finish_dma();
+}
+
+int main(void)
+{
+    led_init(&fake_pio, 0, false);
+    CHECK(dma_handler != NULL);
+    check_show();
+    check_bench();
+    check_rgbw();
+    return check_result();
+}
@@ -0,0 +1,149 @@
+/*
+ * Checks the interpolator model against hand-worked register examples, then
+ * runs the lane configurations of lookup_init() on the model and compares
+ * every lookup with the plain C path of lookup.c
+ */
+#include "check.h"
+#include "interp_model.h"
+#include "lookup.h"
+
+/*
+ * Stand-ins for where the linker puts the tables on the RP2040
+ */
+#define DECODE_TABLE_ADDRESS 0x10004000u
+#define PALETTE_ADDRESS 0x20000200u
+
+static void check_model(void)
+{
+    struct interp_model interp = {0};
+
+    interp.lane[0] = interp_model_default_lane();
+    interp.lane[1] = interp_model_default_lane();
+
+    // Default lanes add the base: a POP_LANE0 with base 1 counts up
+    interp.base[0] = 1;
+    CHECK_EQ(interp_model_pop(&interp, 0), 1);
+    CHECK_EQ(interp_model_pop(&interp, 0), 2);
+    CHECK_EQ(interp.accum[0], 2);
+    CHECK_EQ(interp_model_peek(&interp, 0), 3);
+    CHECK_EQ(interp.accum[0], 2);
+
+    // Shift right by 4 and keep bits 2-5
+    interp.accum[0] = 0x12345678u;
+    interp.base[0] = 0;
+    interp.lane[0].shift = 4;
+    interp.lane[0].mask_lsb = 2;
+    interp.lane[0].mask_msb = 5;
+    CHECK_EQ(interp_model_peek(&interp, 0), (0x12345678u >> 4) & 0x3Cu);
+
+    // Signed lanes extend from mask_msb
+    interp.accum[0] = 0x20;
+    interp.lane[0].shift = 0;
+    interp.lane[0].mask_lsb = 0;
+    interp.lane[0].is_signed = true;
+    CHECK_EQ(interp_model_peek(&interp, 0), 0xFFFFFFE0u);
+    interp.accum[0] = 0x1F;
+    CHECK_EQ(interp_model_peek(&interp, 0), 0x1F);
+
+    // FULL adds base 2 to both masked lanes, ADD_RAW skips the mask for its own lane only
+    interp.lane[0] = interp_model_default_lane();
+    interp.lane[0].mask_msb = 3;
+    interp.lane[0].add_raw = true;
+    interp.accum[0] = 0x1F;
+    interp.accum[1] = 5;
+    interp.base[0] = 100;
+    interp.base[1] = 200;
+    interp.base[2] = 1000;
+    CHECK_EQ(interp_model_peek(&interp, 0), 100 + 0x1F);
+    CHECK_EQ(interp_model_peek(&interp, 1), 205);
+    CHECK_EQ(interp_model_peek(&interp, 2), 1000 + 0xF + 5);
+
+    // FORCE_MSB shows on the lane reads, not in the accumulator
+    interp.lane[1].force_msb = 2;
+    CHECK_EQ(interp_model_pop(&interp, 1), 205u | 0x20000000u);
+    CHECK_EQ(interp.accum[1], 205);
+
+    // CROSS_INPUT reads the other accumulator, CROSS_RESULT swaps on a POP
+    interp = (struct interp_model){0};
+    interp.lane[0] = interp_model_default_lane();
+    interp.lane[1] = interp_model_default_lane();
+    interp.accum[0] = 10;
+    interp.accum[1] = 20;
+    interp.lane[1].cross_input = true;
+    CHECK_EQ(interp_model_peek(&interp, 1), 10);
+    interp.lane[1].cross_input = false;
+    interp.lane[0].cross_result = true;
+    interp.lane[1].cross_result = true;
+    interp.base[0] = 1;
+    interp.base[1] = 2;
+    interp_model_pop(&interp, 2);
+    CHECK_EQ(interp.accum[0], 22);
+    CHECK_EQ(interp.accum[1], 11);
+}
+
+/*
+ * interp0 lane 0 as lookup_init() sets it up
+ */
+static void check_decode_lane(void)
+{
+    struct interp_model interp = {0};
+
+    interp.lane[0] = interp_model_default_lane();
+    interp.lane[0].mask_lsb = LOOKUP_DECODE_MASK_LSB;
+    interp.lane[0].mask_msb = LOOKUP_DECODE_MASK_MSB;
+    interp.base[0] = DECODE_TABLE_ADDRESS;
+
+    for (uint32_t code = 0; code < MORSE_DECODE_SIZE; code++)
+    {
+        interp.accum[0] = code;
+        uint32_t offset = interp_model_peek(&interp, 0) - DECODE_TABLE_ADDRESS;
+        CHECK_EQ(offset, code);
+        CHECK_EQ(morse_decode_table[offset % MORSE_DECODE_SIZE], lookup_morse_decode((morse_code_t)code));
+        CHECK_EQ(lookup_morse_decode((morse_code_t)code), morse_decode(code));
+    }
+    // The mask wraps longer codes onto real entries, which is why lookup.c checks them first
+    interp.accum[0] = MORSE_DECODE_SIZE + 2;
+    CHECK_EQ(interp_model_peek(&interp, 0) - DECODE_TABLE_ADDRESS, 2);
+    for (uint32_t code = MORSE_DECODE_SIZE; code < 256; code++)
+    {
+        CHECK_EQ(lookup_morse_decode((morse_code_t)code), '\0');
+    }
+    for (int i = 0; i < 26; i++)
+    {
+        CHECK_EQ(lookup_morse_decode(alpha_morse[i]), alphabet[i]);
+    }
+}
+
+/*
+ * interp1 lane 0 as lookup_init() sets it up
+ */
+static void check_colour_lane(void)
+{
+    struct interp_model interp = {0};
+
+    interp.lane[0] = interp_model_default_lane();
+    interp.lane[0].mask_lsb = LOOKUP_COLOUR_MASK_LSB;
+    interp.lane[0].mask_msb = LOOKUP_COLOUR_MASK_MSB;
+    interp.base[0] = PALETTE_ADDRESS;
+
+    for (unsigned colour = 0; colour < LED_COLOURS; colour++)
+    {
+        interp.accum[0] = colour * (uint32_t)sizeof led_palette[0];
+        uint32_t offset = interp_model_peek(&interp, 0) - PALETTE_ADDRESS;
+        CHECK_EQ(offset, colour * sizeof led_palette[0]);
+        CHECK_EQ(led_palette[offset / sizeof led_palette[0]], lookup_led_colour((enum led_colour)colour));
+    }
+    // The mask holds eight entries, enough for the palette
+    CHECK(LED_COLOURS <= 1u << (LOOKUP_COLOUR_MASK_MSB - LOOKUP_COLOUR_MASK_LSB + 1));
+    CHECK_EQ(lookup_led_colour(LED_GREEN), 0x00FF8000u);
+    CHECK_EQ(lookup_led_colour(LED_COLOURS), lookup_led_colour(LED_BLUE));
+}
+
+int main(void)
+{
+    lookup_init();
+    check_model();
+    check_decode_lane();
+    check_colour_lane();
+    return check_result();
+}
@@ -0,0 +1,181 @@
+/*
+ * Checks the packed Morse tables in morse.c against the string tables they
+ * replaced, the input accumulator against keying those strings, and the
+ * decode and encode tables against alphabet, alpha_morse and num_morse.
+ */
+#include <string.h>
+#include "check.h"
+#include "morse.h"
+
+/*
+ * The tables as strings, from before the codes were packed
+ */
+static const char *const string_alpha_morse[] = {".-", "-...", "-.-.", "-..", ".", "..-.", "--.", "....", "..", ".---",
+                                                 "-.-", ".-..", "--", "-.", "---", ".--.", "--.-", ".-.", "...", "-", "..-",
+                                                 "...-", ".--", "-..-", "-.--", "--.."};
+static const char *const string_num_morse[] = {"-----", ".----", "..---", "...--", "....-",
+                                               ".....", "-....", "--...", "---..", "----."};
+static const char *const string_words[] = {"cave", "copy", "dock", "lick", "run", "owl", "free",
+                                           "sink", "scold", "hold", "smoke", "part", "vex", "able",
+                                           "bang", "nose", "tan", "van", "sob", "blue", "nap"};
+static const char *const string_words_morse[] = {
+    "-.-. .- ...- .", "-.-. --- .--. -.--", "-.. --- -.-. -.-", ".-.. .. -.-. -.-", ".-. ..- -.",
+    "--- .-- .-..", "..-. .-. . .", "... .. -. -.-", "... -.-. --- .-.. -..", ".... --- .-.. -..",
+    "... -- --- -.- .", ".--. .- .-. -", "...- . -..-", ".- -... .-.. .", "-... .- -. --.",
+    "-. --- ... .", "- .- -.", "...- .- -.", "... --- -...", "-... .-.. ..- .", "-. .- .--."};
+
+#define COUNT(array) (sizeof(array) / sizeof((array)[0]))
+
+/*
+ * Keys a dot/dash string into input the way set_input does
+ */
+static void key_string(struct morse_input *input, const char *text)
+{
+    morse_input_reset(input);
+    for (; *text != '\0'; text++)
+    {
+        if (*text == ' ')
+        {
+            morse_input_gap(input);
+        }
+        else
+        {
+            morse_input_element(input, *text == '-');
+        }
+    }
+    morse_input_end(input);
+}
+
+/*
+ * Duration of a dot/dash string in units, counted from the text
+ */
+static unsigned string_duration(const char *text)
+{
+    unsigned units = 0;
+
+    for (const char *c = text; *c != '\0'; c++)
+    {
+        if (*c == ' ')
+        {
+            units += 3;
+            continue;
+        }
+        units += *c == '-' ? 3 : 1;
+        if (c[1] == '.' || c[1] == '-')
+        {
+            units += 1;
+        }
+    }
+    return units;
+}
+
+static void check_table(const morse_code_t *codes, const char *const *strings, size_t count)
+{
+    struct morse_input input;
+    char text[MORSE_STRING_MAX + 1];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        key_string(&input, strings[i]);
+        CHECK_EQ(input.word, codes[i]);
+        CHECK_EQ(morse_code_length(codes[i]), strlen(strings[i]));
+        CHECK(strcmp(morse_format(codes[i], text, sizeof text), strings[i]) == 0);
+        CHECK_EQ(morse_duration(codes[i]), string_duration(strings[i]));
+    }
+}
+
+static void check_words(void)
+{
+    struct morse_input input;
+    char text[MORSE_STRING_MAX + 1];
+
+    for (size_t i = 0; i < COUNT(string_words); i++)
+    {
+        morse_word_t word = morse_encode_word(string_words[i]);
+
+        key_string(&input, string_words_morse[i]);
+        CHECK_EQ(input.word, word);
+        CHECK_EQ(input.letters, strlen(string_words[i]));
+        CHECK(strcmp(morse_format(word, text, sizeof text), string_words_morse[i]) == 0);
+        CHECK_EQ(morse_duration(word), string_duration(string_words_morse[i]));
+    }
+
+    // A one-letter word grades with the same compare as its character
+    CHECK_EQ(morse_encode_word("E"), MORSE_E);
+    CHECK_EQ(morse_encode_word(""), MORSE_WORD_INVALID);
+    CHECK_EQ(morse_encode_word("a b"), MORSE_WORD_INVALID);
+    CHECK_EQ(morse_encode_word("abcdefghijk"), MORSE_WORD_INVALID);
+    CHECK(morse_encode_word("abcdefghij") != MORSE_WORD_INVALID);
+}
+
+static void check_conversion_tables(void)
+{
+    size_t letters = COUNT(alpha_morse);
+    int decoded = 0;
+
+    // Every code in alphabet order decodes to its character and back
+    for (size_t i = 0; alphabet[i] != '\0'; i++)
+    {
+        char c = alphabet[i];
+        morse_code_t code = i < letters ? alpha_morse[i] : num_morse[i - letters];
+
+        CHECK_EQ(morse_decode(code), c);
+        CHECK_EQ(morse_encode(c), code);
+        if (c >= 'A' && c <= 'Z')
+        {
+            CHECK_EQ(morse_encode((char)(c - 'A' + 'a')), code);
+        }
+    }
+
+    // Nothing else decodes, and nothing else encodes
+    for (unsigned code = 0; code < 256; code++)
+    {
+        char c = morse_decode((morse_code_t)code);
+        if (c != '\0')
+        {
+            decoded++;
+            CHECK(strchr(alphabet, c) != NULL);
+        }
+    }
+    CHECK_EQ(decoded, strlen(alphabet));
+    for (int c = -128; c < 128; c++)
+    {
+        morse_code_t code = morse_encode((char)c);
+        if (code != 0)
+        {
+            CHECK_EQ(morse_decode(code), c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+        }
+    }
+    CHECK_EQ(morse_encode(' '), 0);
+    CHECK_EQ(morse_decode(MORSE_CODE_EMPTY), '\0');
+}
+
+static void check_input_limits(void)
+{
+    struct morse_input input;
+
+    // Six elements are no character
+    key_string(&input, "......");
+    CHECK_EQ(input.word, MORSE_WORD_INVALID);
+
+    // Gaps without elements add no letters
+    key_string(&input, "  .  ");
+    CHECK_EQ(input.word, MORSE_E);
+    CHECK_EQ(input.letters, 1);
+    CHECK(input.complete);
+
+    // Eleven letters do not fit
+    key_string(&input, ". . . . . . . . . . .");
+    CHECK_EQ(input.word, MORSE_WORD_INVALID);
+}
+
+int main(void)
+{
+    CHECK_EQ(strlen(alphabet), COUNT(alpha_morse) + COUNT(num_morse));
+    check_table(alpha_morse, string_alpha_morse, COUNT(string_alpha_morse));
+    check_table(num_morse, string_num_morse, COUNT(string_num_morse));
+    check_words();
+    check_conversion_tables();
+    check_input_limits();
+    return check_result();
+}
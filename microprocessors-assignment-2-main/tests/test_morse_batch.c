@@ -0,0 +1,159 @@
+/*
+ * Checks the batch matcher's kernels (SWAR, or AVX2/NEON when the build
+ * enables them) against a position by position reference
+ */
+#include <stdlib.h>
+#include "check.h"
+#include "morse_batch.h"
+
+#define KEYS 1000
+#define ROUNDS 200
+
+static uint32_t state = 5;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static unsigned reference_char_distance(morse_char_key_t a, morse_char_key_t b)
+{
+    unsigned distance = 0;
+    for (int i = 0; i < MORSE_MAX_ELEMENTS; i++)
+    {
+        distance += ((a >> (2 * i)) & 3u) != ((b >> (2 * i)) & 3u);
+    }
+    return distance;
+}
+
+static unsigned reference_word_distance(morse_word_t a, morse_word_t b)
+{
+    unsigned distance = 0;
+    for (int i = 0; i < MORSE_WORD_MAX_LETTERS; i++)
+    {
+        distance += ((a >> (MORSE_FIELD_BITS * i)) & MORSE_FIELD_MASK) != ((b >> (MORSE_FIELD_BITS * i)) & MORSE_FIELD_MASK);
+    }
+    return distance;
+}
+
+static morse_code_t random_code(void)
+{
+    return (morse_code_t)(2 + next_random() % 62);
+}
+
+static morse_word_t random_word(void)
+{
+    morse_word_t word = MORSE_WORD_EMPTY;
+    for (int letters = 1 + (int)(next_random() % MORSE_WORD_MAX_LETTERS); letters > 0; letters--)
+    {
+        word = MORSE_WORD_APPEND(word, random_code());
+    }
+    return morse_batch_word_key(word);
+}
+
+/*
+ * The candidates are the k nearest, in order, ties in table order
+ */
+static void check_candidates(const struct morse_batch_candidate *candidates, int found, int k, const unsigned *distance,
+                             size_t count)
+{
+    size_t below = 0;
+
+    CHECK_EQ(found, (size_t)k < count ? (size_t)k : count);
+    for (int c = 0; c < found; c++)
+    {
+        CHECK_EQ(candidates[c].distance, distance[candidates[c].index]);
+        if (c > 0)
+        {
+            CHECK(candidates[c].distance > candidates[c - 1].distance ||
+                  (candidates[c].distance == candidates[c - 1].distance && candidates[c].index > candidates[c - 1].index));
+        }
+    }
+    // Nothing left out is nearer than the last one found
+    for (size_t i = 0; i < count; i++)
+    {
+        below += found > 0 && distance[i] < candidates[found - 1].distance;
+    }
+    CHECK(below < (size_t)found || found == 0);
+}
+
+static void check_chars(void)
+{
+    struct morse_batch_candidate candidates[8];
+    morse_char_key_t keys[KEYS];
+    unsigned distance[KEYS];
+
+    // The built-in table is the same as converting each code
+    for (int i = 0; i < MORSE_BATCH_CHARACTERS; i++)
+    {
+        CHECK_EQ(morse_batch_char_keys[i], morse_batch_char_key(i < 26 ? alpha_morse[i] : num_morse[i - 26]));
+    }
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        size_t count = 1 + next_random() % KEYS;
+        morse_char_key_t key = morse_batch_char_key(random_code());
+        int k = 1 + (int)(next_random() % 8);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = morse_batch_char_key(random_code());
+            distance[i] = reference_char_distance(keys[i], key);
+        }
+        check_candidates(candidates, morse_batch_match_chars(keys, count, key, candidates, k), k, distance, count);
+    }
+
+    // E is found exactly, then the one-element codes around it
+    int found = morse_batch_match_chars(morse_batch_char_keys, MORSE_BATCH_CHARACTERS, morse_batch_char_key(MORSE_E),
+                                        candidates, 3);
+    CHECK_EQ(found, 3);
+    CHECK_EQ(alphabet[candidates[0].index], 'E');
+    CHECK_EQ(candidates[0].distance, 0);
+    CHECK_EQ(candidates[1].distance, 1);
+}
+
+static void check_words(void)
+{
+    struct morse_batch_candidate candidates[8];
+    static morse_word_t keys[KEYS];
+    unsigned distance[KEYS];
+
+    for (int round = 0; round < ROUNDS; round++)
+    {
+        size_t count = 1 + next_random() % KEYS;
+        morse_word_t key = random_word();
+        int k = 1 + (int)(next_random() % 8);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            keys[i] = random_word();
+            distance[i] = reference_word_distance(keys[i], key);
+        }
+        // Make sure there is an exact match somewhere
+        keys[count / 2] = key;
+        distance[count / 2] = 0;
+        int found = morse_batch_match_words(keys, count, key, candidates, k);
+        check_candidates(candidates, found, k, distance, count);
+        CHECK_EQ(candidates[0].distance, 0);
+    }
+
+    CHECK_EQ(morse_batch_word_key(MORSE_E), (morse_word_t)MORSE_E << (MORSE_FIELD_BITS * (MORSE_WORD_MAX_LETTERS - 1)));
+    CHECK_EQ(morse_batch_word_key(MORSE_WORD_INVALID), MORSE_WORD_INVALID);
+}
+
+int main(void)
+{
+#if defined(__AVX2__)
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        printf("no AVX2 on this CPU, skipped\n");
+        return 77;
+    }
+#endif
+    check_chars();
+    check_words();
+    return check_result();
+}
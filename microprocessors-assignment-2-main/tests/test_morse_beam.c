@@ -0,0 +1,147 @@
+/*
+ * Checks that the beam search reads dictionary words from their marks and
+ * measured gaps, and that the gap lengths decide between readings
+ */
+#include <string.h>
+#include "check.h"
+#include "dictionary_mmap.h"
+#include "morse_beam.h"
+
+#define CANDIDATES 3
+
+/*
+ * Keys word into input with each gap inside a letter element_gap long and
+ * each gap between letters letter_gap long
+ */
+static void key_word(struct morse_beam_input *input, const char *word, uint16_t element_gap, uint16_t letter_gap)
+{
+    morse_beam_input_clear(input);
+    for (const char *c = word; *c != '\0'; c++)
+    {
+        morse_code_t code = morse_encode(*c);
+        for (int element = morse_code_length(code) - 1; element >= 0; element--)
+        {
+            if (input->marks > 0)
+            {
+                morse_beam_input_gap(input, element == morse_code_length(code) - 1 ? letter_gap : element_gap);
+            }
+            morse_beam_input_mark(input, (code >> element) & 1u);
+        }
+    }
+}
+
+/*
+ * Dots and dashes of word with the letters run together
+ */
+static void marks_of(const char *word, char *marks)
+{
+    for (const char *c = word; *c != '\0'; c++)
+    {
+        morse_code_t code = morse_encode(*c);
+        for (int element = morse_code_length(code) - 1; element >= 0; element--)
+        {
+            *marks++ = (code >> element) & 1u ? '-' : '.';
+        }
+    }
+    *marks = '\0';
+}
+
+static void check_exact_gaps(const struct dictionary *dict)
+{
+    struct morse_beam_input input;
+    struct morse_beam_candidate candidates[CANDIDATES];
+    char word[DICTIONARY_WORD_MAX + 1];
+
+    for (size_t i = 0; i < dictionary_count(dict); i += 7)
+    {
+        dictionary_word(dict, i, word);
+        key_word(&input, word, MORSE_BEAM_ELEMENT_GAP, MORSE_BEAM_LETTER_GAP);
+        int found = morse_beam_decode(dict, &input, candidates, CANDIDATES);
+        CHECK(found >= 1);
+        CHECK(strcmp(candidates[0].word, word) == 0);
+        CHECK_EQ(candidates[0].cost, 0);
+        for (int c = 1; c < found; c++)
+        {
+            CHECK(candidates[c].cost >= candidates[c - 1].cost);
+        }
+    }
+}
+
+/*
+ * Two words with the same marks only differ in where their letters end,
+ * so borderline gaps must be read by their length
+ */
+static void check_gap_lengths(const struct dictionary *dict)
+{
+    static char marks[4096][MORSE_STRING_MAX + 1];
+    struct morse_beam_input input;
+    struct morse_beam_candidate candidates[CANDIDATES];
+    char first[DICTIONARY_WORD_MAX + 1], second[DICTIONARY_WORD_MAX + 1];
+    size_t count = dictionary_count(dict) < 4096 ? dictionary_count(dict) : 4096;
+    int pairs = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        dictionary_word(dict, i, first);
+        marks_of(first, marks[i]);
+    }
+    for (size_t i = 0; i < count && pairs < 50; i++)
+    {
+        for (size_t j = i + 1; j < count && pairs < 50; j++)
+        {
+            if (strcmp(marks[i], marks[j]) != 0)
+            {
+                continue;
+            }
+            dictionary_word(dict, i, first);
+            dictionary_word(dict, j, second);
+            pairs++;
+
+            // Gaps a little off towards the middle still read as keyed
+            key_word(&input, first, MORSE_BEAM_UNIT * 17 / 10, MORSE_BEAM_UNIT * 23 / 10);
+            CHECK(morse_beam_decode(dict, &input, candidates, CANDIDATES) >= 1);
+            CHECK(strcmp(candidates[0].word, first) == 0);
+            key_word(&input, second, MORSE_BEAM_UNIT * 17 / 10, MORSE_BEAM_UNIT * 23 / 10);
+            CHECK(morse_beam_decode(dict, &input, candidates, CANDIDATES) >= 1);
+            CHECK(strcmp(candidates[0].word, second) == 0);
+        }
+    }
+    CHECK(pairs > 0);
+}
+
+static void check_limits(const struct dictionary *dict)
+{
+    struct morse_beam_input input;
+    struct morse_beam_candidate candidates[CANDIDATES];
+
+    morse_beam_input_clear(&input);
+    CHECK_EQ(morse_beam_decode(dict, &input, candidates, CANDIDATES), 0);
+    for (int i = 0; i <= MORSE_BEAM_MAX_MARKS; i++)
+    {
+        morse_beam_input_mark(&input, false);
+    }
+    CHECK(input.overflow);
+    CHECK_EQ(morse_beam_decode(dict, &input, candidates, CANDIDATES), 0);
+
+    // Six dots with no letter gap are no word at all
+    key_word(&input, "h", MORSE_BEAM_ELEMENT_GAP, MORSE_BEAM_LETTER_GAP);
+    morse_beam_input_mark(&input, false);
+    morse_beam_input_mark(&input, false);
+    CHECK(morse_beam_decode(dict, &input, candidates, 1) <= 1);
+}
+
+int main(void)
+{
+    struct dictionary dict;
+
+    if (!dictionary_map(&dict, DICTIONARY_BIN))
+    {
+        printf("cannot open %s\n", DICTIONARY_BIN);
+        return 1;
+    }
+    check_exact_gaps(&dict);
+    check_gap_lengths(&dict);
+    check_limits(&dict);
+    dictionary_unmap(&dict);
+    return check_result();
+}
@@ -0,0 +1,85 @@
+/*
+ * Checks the streaming decoder's verdicts as an answer is keyed
+ */
+#include "check.h"
+#include "morse_decoder.h"
+
+/*
+ * Keys a dot/dash string with ' ' for a letter gap and returns the verdict
+ * after the last symbol, without ending the answer
+ */
+static enum morse_verdict key(struct morse_decoder *decoder, morse_word_t target, const char *text)
+{
+    enum morse_verdict verdict;
+
+    morse_decoder_start(decoder, target);
+    verdict = decoder->verdict;
+    for (; *text != '\0'; text++)
+    {
+        verdict = *text == ' ' ? morse_decoder_gap(decoder) : morse_decoder_element(decoder, *text == '-');
+    }
+    return verdict;
+}
+
+static void check_prefix_codes(void)
+{
+    struct morse_decoder decoder;
+
+    // A dot is E, but it is also how I, S, H and A start
+    CHECK_EQ(key(&decoder, MORSE_E, "."), MORSE_PENDING);
+    CHECK_EQ(key(&decoder, MORSE_E, ".."), MORSE_REJECTED);
+    CHECK_EQ(morse_decoder_end(&decoder), MORSE_REJECTED);
+    CHECK_EQ(key(&decoder, MORSE_E, ".-"), MORSE_REJECTED);
+
+    // Only closing the letter accepts it
+    CHECK_EQ(key(&decoder, MORSE_E, ". "), MORSE_ACCEPTED);
+    CHECK_EQ(key(&decoder, MORSE_E, "."), MORSE_PENDING);
+    CHECK_EQ(morse_decoder_end(&decoder), MORSE_ACCEPTED);
+
+    // The same holds for the last letter of a word
+    CHECK_EQ(key(&decoder, MORSE_WORD3(MORSE_S, MORSE_O, MORSE_S), "... --- ..."), MORSE_PENDING);
+    CHECK_EQ(morse_decoder_gap(&decoder), MORSE_ACCEPTED);
+    CHECK_EQ(key(&decoder, MORSE_WORD3(MORSE_S, MORSE_O, MORSE_S), "... --- ...."), MORSE_REJECTED);
+    CHECK_EQ(key(&decoder, MORSE_WORD_APPEND(MORSE_T, MORSE_E), "- .-"), MORSE_REJECTED);
+}
+
+static void check_rejection(void)
+{
+    struct morse_decoder decoder;
+
+    // A wrong first element fails at once
+    CHECK_EQ(key(&decoder, MORSE_A, "-"), MORSE_REJECTED);
+
+    // So does a letter closed before it was finished
+    CHECK_EQ(key(&decoder, MORSE_A, ". "), MORSE_REJECTED);
+
+    // An answer that ends early is rejected, and a verdict does not change
+    CHECK_EQ(key(&decoder, MORSE_WORD_APPEND(MORSE_A, MORSE_B), ".- -.."), MORSE_PENDING);
+    CHECK_EQ(morse_decoder_end(&decoder), MORSE_REJECTED);
+    CHECK_EQ(morse_decoder_element(&decoder, false), MORSE_REJECTED);
+
+    // Extra gaps between letters are ignored
+    CHECK_EQ(key(&decoder, MORSE_WORD_APPEND(MORSE_A, MORSE_B), "  .-   -... "), MORSE_ACCEPTED);
+}
+
+static void check_decode_only(void)
+{
+    struct morse_decoder decoder;
+
+    // Without a target the decoder only tracks the current character
+    CHECK_EQ(key(&decoder, MORSE_WORD_EMPTY, "-.-."), MORSE_PENDING);
+    CHECK_EQ(morse_decoder_current(&decoder), 'C');
+    CHECK_EQ(morse_decoder_gap(&decoder), MORSE_PENDING);
+    CHECK_EQ(morse_decoder_current(&decoder), '\0');
+    CHECK_EQ(key(&decoder, MORSE_WORD_EMPTY, "......"), MORSE_PENDING);
+    CHECK_EQ(morse_decoder_current(&decoder), '\0');
+    CHECK_EQ(morse_decoder_end(&decoder), MORSE_PENDING);
+}
+
+int main(void)
+{
+    check_prefix_codes();
+    check_rejection();
+    check_decode_only();
+    return check_result();
+}
@@ -0,0 +1,188 @@
+/*
+ * Fuzzes the bit-parallel edit distance and its traceback against the
+ * textbook dynamic programming recurrence
+ */
+#include <string.h>
+#include "check.h"
+#include "morse_match.h"
+
+#define CASES 20000
+
+static uint32_t state = 7;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+ * Fills symbols with length random symbols, gaps included anywhere
+ */
+static void random_symbols(struct morse_symbols *symbols, int length, enum morse_symbol *out)
+{
+    morse_symbols_clear(symbols);
+    for (int i = 0; i < length; i++)
+    {
+        out[i] = (enum morse_symbol)(next_random() % MORSE_SYMBOL_COUNT);
+        symbols->mask[out[i]] |= (uint64_t)1 << i;
+    }
+    symbols->length = (uint8_t)length;
+}
+
+/*
+ * Levenshtein distance, one row at a time
+ */
+static int reference_distance(const enum morse_symbol *a, int m, const enum morse_symbol *b, int n)
+{
+    int row[MORSE_MATCH_MAX_SYMBOLS + 1];
+
+    for (int j = 0; j <= n; j++)
+    {
+        row[j] = j;
+    }
+    for (int i = 1; i <= m; i++)
+    {
+        int diagonal = row[0];
+        row[0] = i;
+        for (int j = 1; j <= n; j++)
+        {
+            int best = diagonal + (a[i - 1] != b[j - 1]);
+            if (row[j] + 1 < best)
+            {
+                best = row[j] + 1;
+            }
+            if (row[j - 1] + 1 < best)
+            {
+                best = row[j - 1] + 1;
+            }
+            diagonal = row[j];
+            row[j] = best;
+        }
+    }
+    return row[n];
+}
+
+/*
+ * The alignment replays into both sequences and its edits add up to the distance
+ */
+static void check_alignment(const struct morse_match *match, const enum morse_symbol *expected, int m,
+                            const enum morse_symbol *keyed, int n)
+{
+    int row = 0, column = 0, edits = 0;
+
+    for (int i = 0; i < match->length; i++)
+    {
+        const struct morse_match_step *step = &match->steps[i];
+        if (step->edit != MORSE_EDIT_INSERT)
+        {
+            CHECK(row < m && step->expected == expected[row]);
+            row++;
+        }
+        if (step->edit != MORSE_EDIT_DELETE)
+        {
+            CHECK(column < n && step->keyed == keyed[column]);
+            column++;
+        }
+        if (step->edit == MORSE_EDIT_MATCH)
+        {
+            CHECK_EQ(step->expected, step->keyed);
+        }
+        else
+        {
+            edits++;
+        }
+    }
+    CHECK_EQ(row, m);
+    CHECK_EQ(column, n);
+    CHECK_EQ(edits, match->distance);
+    CHECK_EQ(match->substitutions + match->insertions + match->deletions, match->distance);
+}
+
+static void check_random(void)
+{
+    static struct morse_match match;
+    struct morse_symbols expected, keyed;
+    enum morse_symbol a[MORSE_MATCH_MAX_SYMBOLS], b[MORSE_MATCH_MAX_SYMBOLS];
+
+    for (int i = 0; i < CASES; i++)
+    {
+        int m = (int)(next_random() % (MORSE_MATCH_MAX_SYMBOLS + 1));
+        int n = (int)(next_random() % (MORSE_MATCH_MAX_SYMBOLS + 1));
+
+        random_symbols(&expected, m, a);
+        if (i % 2 == 0 && m > 0)
+        {
+            // Small edits of the target, the case that matters for grading
+            n = m;
+            memcpy(b, a, sizeof a);
+            for (int edits = (int)(next_random() % 4); edits > 0; edits--)
+            {
+                b[next_random() % (unsigned)n] = (enum morse_symbol)(next_random() % MORSE_SYMBOL_COUNT);
+            }
+            morse_symbols_clear(&keyed);
+            for (int j = 0; j < n; j++)
+            {
+                keyed.mask[b[j]] |= (uint64_t)1 << j;
+            }
+            keyed.length = (uint8_t)n;
+        }
+        else
+        {
+            random_symbols(&keyed, n, b);
+        }
+
+        int distance = reference_distance(a, m, b, n);
+        CHECK_EQ(morse_distance(&expected, &keyed), distance);
+        CHECK_EQ(morse_match(&expected, &keyed, &match), distance);
+        check_alignment(&match, a, m, b, n);
+    }
+}
+
+static void check_words(void)
+{
+    static struct morse_match match;
+    struct morse_symbols expected, keyed;
+
+    // "e" keyed as "i": one extra dot
+    morse_symbols_from_word(&expected, MORSE_E);
+    morse_symbols_from_word(&keyed, MORSE_I);
+    CHECK_EQ(morse_match(&expected, &keyed, &match), 1);
+    CHECK_EQ(match.insertions, 1);
+
+    // "sos" keyed with one dash short
+    morse_symbols_from_word(&expected, MORSE_WORD3(MORSE_S, MORSE_O, MORSE_S));
+    morse_symbols_from_word(&keyed, MORSE_WORD3(MORSE_S, MORSE_M, MORSE_S));
+    CHECK_EQ(expected.length, 11);
+    CHECK_EQ(morse_match(&expected, &keyed, &match), 1);
+    CHECK_EQ(match.deletions, 1);
+
+    // "a" keyed as "n": both elements wrong, or one missing and one extra
+    morse_symbols_from_word(&expected, MORSE_A);
+    morse_symbols_from_word(&keyed, MORSE_N);
+    CHECK_EQ(morse_distance(&expected, &keyed), 2);
+
+    // Appending keeps gaps only between elements
+    morse_symbols_clear(&keyed);
+    morse_symbols_append(&keyed, MORSE_SYMBOL_GAP);
+    morse_symbols_append(&keyed, MORSE_SYMBOL_DOT);
+    morse_symbols_append(&keyed, MORSE_SYMBOL_GAP);
+    morse_symbols_append(&keyed, MORSE_SYMBOL_GAP);
+    morse_symbols_append(&keyed, MORSE_SYMBOL_DASH);
+    CHECK_EQ(keyed.length, 3);
+    for (int i = 0; i < 70; i++)
+    {
+        morse_symbols_append(&keyed, MORSE_SYMBOL_DOT);
+    }
+    CHECK_EQ(keyed.length, MORSE_MATCH_MAX_SYMBOLS);
+    CHECK(keyed.overflow);
+}
+
+int main(void)
+{
+    check_random();
+    check_words();
+    return check_result();
+}
@@ -0,0 +1,121 @@
+/*
+ * Checks xoshiro128** against reference outputs, replay from a seed, bit
+ * balance and the uniformity of rng_below()
+ */
+#include "check.h"
+#include "rng.h"
+
+#define DRAWS 1000000
+
+/*
+ * First outputs after rng_seed(), from a separate Python model of
+ * SplitMix32 seeding and xoshiro128**
+ */
+static void check_reference(void)
+{
+    static const uint32_t zero[] = {0xE308DC58u, 0x4392D0E4u, 0x03318F97u, 0xAC593A63u};
+    static const uint32_t coffee[] = {0xDAFDDC82u, 0x7749330Au, 0x64EB1755u, 0xD1E9D648u};
+
+    rng_seed(0);
+    CHECK_EQ(rng_get_seed(), 0);
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK_EQ(rng_next(), zero[i]);
+    }
+    rng_seed(0xC0FFEEu);
+    CHECK_EQ(rng_get_seed(), 0xC0FFEEu);
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK_EQ(rng_next(), coffee[i]);
+    }
+}
+
+static void check_replay(void)
+{
+    static uint32_t first[4096];
+    int same = 0;
+
+    rng_seed(42);
+    for (int i = 0; i < 4096; i++)
+    {
+        first[i] = rng_next();
+    }
+    rng_seed(42);
+    for (int i = 0; i < 4096; i++)
+    {
+        CHECK_EQ(rng_next(), first[i]);
+    }
+    // A neighbouring seed gives an unrelated sequence
+    rng_seed(43);
+    for (int i = 0; i < 4096; i++)
+    {
+        same += rng_next() == first[i];
+    }
+    CHECK(same < 4);
+}
+
+static void check_bits(void)
+{
+    unsigned ones[32] = {0};
+
+    rng_seed(7);
+    for (int i = 0; i < DRAWS; i++)
+    {
+        uint32_t value = rng_next();
+        for (int bit = 0; bit < 32; bit++)
+        {
+            ones[bit] += (value >> bit) & 1;
+        }
+    }
+    // Five standard deviations is 2500 for a million fair bits
+    for (int bit = 0; bit < 32; bit++)
+    {
+        CHECK(ones[bit] > DRAWS / 2 - 2500 && ones[bit] < DRAWS / 2 + 2500);
+    }
+}
+
+static void check_below(uint32_t bound)
+{
+    static unsigned drawn[64];
+    double expected = (double)DRAWS / bound;
+    double chi_square = 0;
+
+    for (uint32_t i = 0; i < bound; i++)
+    {
+        drawn[i] = 0;
+    }
+    for (int i = 0; i < DRAWS; i++)
+    {
+        uint32_t value = rng_below(bound);
+        CHECK(value < bound);
+        drawn[value < bound ? value : 0]++;
+    }
+    for (uint32_t i = 0; i < bound; i++)
+    {
+        chi_square += (drawn[i] - expected) * (drawn[i] - expected) / expected;
+    }
+    // Far above the 99.9th percentile for up to 64 cells
+    CHECK(chi_square < 2.0 * bound + 40);
+}
+
+int main(void)
+{
+    check_reference();
+    check_replay();
+    check_bits();
+
+    rng_seed(0x12345678u);
+    CHECK_EQ(rng_below(1), 0);
+    for (uint32_t bound = 2; bound <= 64; bound++)
+    {
+        check_below(bound);
+    }
+
+    // Bounds just past a power of two redraw the most often, and must stay in range
+    for (int i = 0; i < DRAWS; i++)
+    {
+        CHECK(rng_below(0x80000001u) < 0x80000001u);
+        CHECK(rng_below(0xFFFFFFFFu) < 0xFFFFFFFFu);
+    }
+    return check_result();
+}
@@ -0,0 +1,197 @@
+/*
+ * Runs the scheduler on its virtual clock: handler order, posts from a
+ * running handler, timed events landing exactly on their time, cancelling,
+ * and a key session driven the way the main loop drives it
+ */
+#include "check.h"
+#include "sched.h"
+#include "session.h"
+
+#define UNIT_US 100000u // 12 WPM
+
+static char order[64];
+static int order_length;
+static int input_repeats;
+static uint64_t handled_at[SCHED_EVENTS];
+static int rounds;
+
+static void note(char c, enum sched_event event)
+{
+    if (order_length < (int)sizeof(order) - 1)
+    {
+        order[order_length++] = c;
+    }
+    handled_at[event] = sched_now();
+}
+
+static void on_input(void)
+{
+    note('i', SCHED_INPUT);
+    // Posting its own event again from the handler runs it again
+    if (input_repeats > 0)
+    {
+        input_repeats--;
+        sched_post(SCHED_INPUT);
+    }
+}
+
+static void on_timeout(void)
+{
+    note('t', SCHED_TIMEOUT);
+}
+
+static void on_led(void)
+{
+    note('l', SCHED_LED);
+}
+
+static void on_console(void)
+{
+    note('c', SCHED_CONSOLE);
+}
+
+static bool after_one_round(void)
+{
+    return ++rounds >= 1;
+}
+
+static bool never(void)
+{
+    return false;
+}
+
+static void reset(void)
+{
+    sched_init();
+    sched_set_time(1000);
+    sched_handle(SCHED_INPUT, on_input);
+    sched_handle(SCHED_TIMEOUT, on_timeout);
+    sched_handle(SCHED_LED, on_led);
+    sched_handle(SCHED_CONSOLE, on_console);
+    order_length = 0;
+    rounds = 0;
+}
+
+static void check_order(void)
+{
+    reset();
+    sched_post(SCHED_CONSOLE);
+    sched_post(SCHED_LED);
+    sched_post(SCHED_INPUT);
+    CHECK(sched_run(after_one_round));
+    order[order_length] = '\0';
+    CHECK_EQ(order_length, 3);
+    CHECK(order[0] == 'i' && order[1] == 'l' && order[2] == 'c');
+
+    reset();
+    input_repeats = 2;
+    sched_post(SCHED_INPUT);
+    CHECK(!sched_run(never)); // Returns once nothing is left that could wake it
+    CHECK_EQ(order_length, 3);
+    CHECK_EQ(sched_now(), 1000);
+}
+
+static void check_timed(void)
+{
+    struct sched_stats before, after;
+
+    reset();
+    sched_get_stats(&before);
+    sched_post_at(SCHED_TIMEOUT, 5000);
+    sched_post_at(SCHED_LED, 3000);
+    sched_post_at(SCHED_CONSOLE, 9000);
+    sched_post_at(SCHED_CONSOLE, 4000); // Replaces 9000
+    sched_post_at(SCHED_INPUT, 7000);
+    sched_cancel(SCHED_INPUT);
+    CHECK(!sched_run(never));
+    sched_get_stats(&after);
+
+    order[order_length] = '\0';
+    CHECK_EQ(order_length, 3);
+    CHECK(order[0] == 'l' && order[1] == 'c' && order[2] == 't');
+    CHECK_EQ(handled_at[SCHED_LED], 3000);
+    CHECK_EQ(handled_at[SCHED_CONSOLE], 4000);
+    CHECK_EQ(handled_at[SCHED_TIMEOUT], 5000);
+    CHECK_EQ(after.sleeps - before.sleeps, 3);
+    CHECK_EQ(after.worst_late_us, 0);
+    // The clock stops at the last time asked for, the cancelled one never comes
+    CHECK_EQ(sched_now(), 5000);
+
+    // A time already past is handled at once, and counted as late
+    reset();
+    sched_set_time(10000);
+    sched_post_at(SCHED_LED, 9000);
+    CHECK(sched_run(after_one_round));
+    CHECK_EQ(handled_at[SCHED_LED], 10000);
+    sched_get_stats(&after);
+    CHECK_EQ(after.worst_late_us, 1000);
+}
+
+/*
+ * One key answering "it" through the scheduler, as main_asm() runs it:
+ * scripted edges come in as SCHED_INPUT and the session's deadlines as
+ * SCHED_TIMEOUT, and the answer is seen the moment its word gap ends
+ */
+static struct session session;
+static const uint32_t script[] = {0, 1, 2, 3, 6, 9}; // Press, release, ... in units: ". ." then "-"
+static int script_next;
+static uint64_t script_start;
+
+static void key_input(void)
+{
+    struct edge_event event = {.time_us = sched_now(), .channel = 0};
+    uint64_t deadline;
+
+    event.type = (uint8_t)(script_next % 2 == 0 ? EDGE_PRESSED : EDGE_RELEASED);
+    session_edge(&session, &event);
+    script_next++;
+    if (script_next < (int)(sizeof(script) / sizeof(script[0])))
+    {
+        sched_post_at(SCHED_INPUT, script_start + script[script_next] * (uint64_t)UNIT_US);
+    }
+    if (session_next(&session, &deadline))
+    {
+        sched_post_at(SCHED_TIMEOUT, deadline);
+    }
+}
+
+static void key_timeout(void)
+{
+    uint64_t deadline;
+
+    session_expire(&session, sched_now());
+    if (session_next(&session, &deadline))
+    {
+        sched_post_at(SCHED_TIMEOUT, deadline);
+    }
+}
+
+static bool answer_ready(void)
+{
+    return session.input.complete;
+}
+
+static void check_session(void)
+{
+    sched_init();
+    sched_set_time(0);
+    sched_handle(SCHED_INPUT, key_input);
+    sched_handle(SCHED_TIMEOUT, key_timeout);
+    session_init(&session, 12);
+    session_start(&session, MORSE_WORD_EMPTY, "it", 0, false);
+    script_start = 500000;
+    script_next = 0;
+    sched_post_at(SCHED_INPUT, script_start);
+
+    CHECK(sched_run(answer_ready));
+    CHECK_EQ(session.verifier.verdict, MORSE_ACCEPTED);
+    CHECK_EQ(sched_now(), script_start + (9 + SESSION_WORD_TIMEOUT_UNITS) * (uint64_t)UNIT_US);
+}
+
+int main(void)
+{
+    check_order();
+    check_timed();
+    check_session();
+    return check_result();
+}
@@ -0,0 +1,150 @@
+/*
+ * Drives one key's session with timed edges, as the main loop does
+ */
+#include <string.h>
+#include "check.h"
+#include "session.h"
+
+#define UNIT_US 100000u // 12 WPM
+
+static uint64_t now;
+
+static void edge(struct session *session, enum edge_type type)
+{
+    struct edge_event event = {.time_us = now, .type = (uint8_t)type, .channel = 0};
+    session_edge(session, &event);
+}
+
+/*
+ * Waits gap_units, acting on the timeouts that fall due, then presses the
+ * key for press_units
+ */
+static void key(struct session *session, unsigned gap_units_x10, unsigned press_units)
+{
+    uint64_t until = now + (uint64_t)gap_units_x10 * UNIT_US / 10;
+    uint64_t deadline;
+
+    while (session_next(session, &deadline) && deadline <= until)
+    {
+        now = deadline;
+        session_expire(session, now);
+    }
+    now = until;
+    edge(session, EDGE_PRESSED);
+    now += press_units * UNIT_US;
+    edge(session, EDGE_RELEASED);
+}
+
+/*
+ * Lets time run for units, acting on the timeouts that fall due
+ */
+static void wait(struct session *session, unsigned units)
+{
+    uint64_t until = now + (uint64_t)units * UNIT_US;
+    uint64_t deadline;
+
+    while (session_next(session, &deadline) && deadline <= until)
+    {
+        now = deadline;
+        session_expire(session, now);
+    }
+    now = until;
+}
+
+static void check_measured_gaps(void)
+{
+    static struct session session;
+
+    session_init(&session, 12);
+    session_start(&session, MORSE_WORD_EMPTY, "it", now, true);
+
+    // "it" with a short letter gap: the I's own gap is 1.2 units, the letter gap 2.5
+    key(&session, 0, 1);
+    key(&session, 12, 1);
+    key(&session, 25, 3);
+    CHECK_EQ(session.marks.marks, 3);
+    CHECK_EQ(session.marks.gaps[1], 12 * MORSE_BEAM_UNIT / 10);
+    CHECK_EQ(session.marks.gaps[2], 25 * MORSE_BEAM_UNIT / 10);
+    CHECK_EQ(session.marks.dashes, 0x4);
+
+    // A gap the letter timeout already closed is still recorded at its length
+    session_start(&session, MORSE_WORD_EMPTY, "it", now, true);
+    key(&session, 100, 1);
+    key(&session, 10, 1);
+    key(&session, 40, 3);
+    CHECK_EQ(session.marks.gaps[2], 40 * MORSE_BEAM_UNIT / 10);
+    CHECK_EQ(session.verifier.correct, 1);
+    wait(&session, 10);
+    CHECK(session.input.complete);
+    CHECK_EQ(session.verifier.verdict, MORSE_ACCEPTED);
+}
+
+/*
+ * The answer ends one word gap after the last release, not at a fixed alarm
+ */
+static void check_word_timeout(void)
+{
+    static struct session session;
+    uint64_t released;
+
+    session_init(&session, 12);
+    session_start(&session, MORSE_WORD_EMPTY, "it", now, true);
+    key(&session, 0, 1);
+    key(&session, 10, 1);
+    key(&session, 30, 3);
+    released = now;
+    wait(&session, SESSION_WORD_TIMEOUT_UNITS - 1);
+    CHECK(!session.input.complete);
+    wait(&session, 1);
+    CHECK(session.input.complete);
+    CHECK(now - released == (uint64_t)SESSION_WORD_TIMEOUT_UNITS * session.keying.unit_us);
+    CHECK_EQ(session.verifier.verdict, MORSE_ACCEPTED);
+}
+
+/*
+ * Widths timed by the PIO after the answer ended leave it as it was
+ */
+static void check_widths_after_complete(void)
+{
+    static struct session session;
+    struct morse_beam_input marks;
+    struct morse_symbols symbols;
+    struct morse_input input;
+    struct word_verifier verifier;
+    struct keying keying;
+
+    session_init(&session, 12);
+    session.widths_timed = true;
+    session_start(&session, MORSE_WORD_EMPTY, "it", now, true);
+    session_width(&session, true, UNIT_US);
+    session_width(&session, false, UNIT_US);
+    session_width(&session, true, UNIT_US);
+    session_width(&session, false, 3 * UNIT_US);
+    session_width(&session, true, 3 * UNIT_US);
+    session_input(&session, 3);
+    CHECK(session.input.complete);
+    CHECK_EQ(session.verifier.verdict, MORSE_ACCEPTED);
+
+    marks = session.marks;
+    symbols = session.symbols;
+    input = session.input;
+    verifier = session.verifier;
+    keying = session.keying;
+    session_width(&session, false, 3 * UNIT_US);
+    session_width(&session, true, UNIT_US);
+    session_width(&session, false, UNIT_US);
+    session_width(&session, true, 3 * UNIT_US);
+    CHECK(memcmp(&session.marks, &marks, sizeof marks) == 0);
+    CHECK(memcmp(&session.symbols, &symbols, sizeof symbols) == 0);
+    CHECK(memcmp(&session.input, &input, sizeof input) == 0);
+    CHECK(memcmp(&session.verifier, &verifier, sizeof verifier) == 0);
+    CHECK(memcmp(&session.keying, &keying, sizeof keying) == 0);
+}
+
+int main(void)
+{
+    check_measured_gaps();
+    check_word_timeout();
+    check_widths_after_complete();
+    return check_result();
+}
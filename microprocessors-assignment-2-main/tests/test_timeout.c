@@ -0,0 +1,152 @@
+/*
+ * Runs the timeout service under a virtual clock: random arms, cancels and
+ * clock steps against a reference, then a wake loop like the main loop's
+ * that must see every deadline on time
+ */
+#include "check.h"
+#include "timeout.h"
+
+#define STEPS 1000000
+
+static uint32_t state = 17;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+ * The obvious version: one flag and one deadline per kind
+ */
+struct reference
+{
+    bool armed[TIMEOUT_KINDS];
+    uint64_t deadline[TIMEOUT_KINDS];
+};
+
+static void check_random(void)
+{
+    struct timeout_service service;
+    struct reference reference = {0};
+    uint64_t now = 1000;
+
+    timeout_clear(&service);
+    for (int step = 0; step < STEPS; step++)
+    {
+        uint32_t r = next_random();
+        enum timeout_kind kind = (enum timeout_kind)(r % TIMEOUT_KINDS);
+        uint64_t deadline;
+        bool found;
+
+        switch ((r >> 8) % 8)
+        {
+        case 0:
+        case 1:
+        case 2:
+            // Deadlines in the past, now and the future
+            deadline = now + (r >> 12) % 5000 - 500;
+            timeout_arm(&service, kind, deadline);
+            reference.armed[kind] = true;
+            reference.deadline[kind] = deadline;
+            break;
+        case 3:
+            timeout_cancel(&service, kind);
+            reference.armed[kind] = false;
+            break;
+        case 4:
+            if ((r >> 12) % 64 == 0)
+            {
+                timeout_clear(&service);
+                for (int k = 0; k < TIMEOUT_KINDS; k++)
+                {
+                    reference.armed[k] = false;
+                }
+            }
+            break;
+        default:
+        {
+            unsigned expected = 0;
+
+            now += (r >> 12) % 2000;
+            for (int k = 0; k < TIMEOUT_KINDS; k++)
+            {
+                if (reference.armed[k] && reference.deadline[k] <= now)
+                {
+                    expected |= TIMEOUT_BIT(k);
+                    reference.armed[k] = false;
+                }
+            }
+            CHECK_EQ(timeout_expire(&service, now), expected);
+            break;
+        }
+        }
+
+        uint64_t earliest = UINT64_MAX;
+        bool any = false;
+        for (int k = 0; k < TIMEOUT_KINDS; k++)
+        {
+            if (reference.armed[k] && reference.deadline[k] < earliest)
+            {
+                earliest = reference.deadline[k];
+                any = true;
+            }
+        }
+        found = timeout_next(&service, &deadline);
+        CHECK_EQ(found, any);
+        if (found && any)
+        {
+            CHECK_EQ(deadline, earliest);
+        }
+    }
+}
+
+/*
+ * Sleeps until timeout_next() each time, as the main loop does with
+ * ALARM0, rearming each kind at its own period: every timeout fires at its
+ * deadline, never early or late, and none is missed
+ */
+static void check_wake_loop(void)
+{
+    static const uint64_t periods[TIMEOUT_KINDS] = {
+        [TIMEOUT_LETTER] = 200, [TIMEOUT_WORD] = 700, [TIMEOUT_END] = 2000, [TIMEOUT_KEYER] = 100};
+    struct timeout_service service;
+    unsigned fired[TIMEOUT_KINDS] = {0};
+    uint64_t now = 0;
+    uint64_t deadline;
+
+    timeout_clear(&service);
+    for (int k = 0; k < TIMEOUT_KINDS; k++)
+    {
+        timeout_arm(&service, (enum timeout_kind)k, periods[k]);
+    }
+    while (timeout_next(&service, &deadline) && deadline <= 1000000)
+    {
+        CHECK(deadline >= now);
+        now = deadline;
+        unsigned due = timeout_expire(&service, now);
+        CHECK(due != 0);
+        for (int k = 0; k < TIMEOUT_KINDS; k++)
+        {
+            if (due & TIMEOUT_BIT(k))
+            {
+                CHECK_EQ(now % periods[k], 0);
+                fired[k]++;
+                timeout_arm(&service, (enum timeout_kind)k, now + periods[k]);
+            }
+        }
+    }
+    for (int k = 0; k < TIMEOUT_KINDS; k++)
+    {
+        CHECK_EQ(fired[k], 1000000 / periods[k]);
+    }
+}
+
+int main(void)
+{
+    check_random();
+    check_wake_loop();
+    return check_result();
+}
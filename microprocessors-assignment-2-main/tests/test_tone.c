@@ -0,0 +1,258 @@
+/*
+ * Runs the tone detector on synthetic recordings: words keyed at 12-25 WPM
+ * on 600-900 Hz tones in noise, mains hum and slow fading, read back from
+ * the detected edges, and two minutes of noise alone that must not key
+ * anything. Given a WAV file (8 kHz, 16-bit mono) and a tone instead, it
+ * prints the edges detected in that recording.
+ */
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "check.h"
+#include "morse.h"
+#include "tone.h"
+
+#define SAMPLE_HZ 8000        // AUDIO_SAMPLE_HZ
+#define MAX_SAMPLES (SAMPLE_HZ * 120)
+#define MAX_EDGES 512
+#define PI 3.14159265358979
+
+static const char *const words[] = {"paris", "morse", "code", "the", "quick", "fox", "jumps", "over", "lazy"};
+
+static uint32_t state = 23;
+
+static double uniform(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return (state + 0.5) / 4294967296.0;
+}
+
+static double gaussian(void)
+{
+    return sqrt(-2 * log(uniform())) * cos(2 * PI * uniform());
+}
+
+struct recording
+{
+    uint16_t samples[MAX_SAMPLES];
+    size_t count;
+    bool keyed[MAX_SAMPLES]; // Whether the tone is meant to be on
+};
+
+struct conditions
+{
+    unsigned wpm;
+    unsigned tone_hz;
+    double snr_db;   // Tone power over the noise power across the whole band
+    bool hum;        // 50 Hz and its third harmonic
+    bool fading;     // 6 dB slow fade
+};
+
+/*
+ * Keys word into a recording after a second of silence, with 5 ms ramps on
+ * each element as a real oscillator has
+ */
+static void record(struct recording *recording, const char *word, const struct conditions *conditions)
+{
+    double unit = 1.2 / conditions->wpm * SAMPLE_HZ;
+    double amplitude = 400;
+    double noise = amplitude / sqrt(2) / pow(10, conditions->snr_db / 20);
+    double envelope = 0;
+    double ramp = 1.0 / (0.005 * SAMPLE_HZ);
+    size_t t = SAMPLE_HZ;
+
+    memset(recording->keyed, 0, sizeof(recording->keyed));
+    for (const char *c = word; *c != '\0'; c++)
+    {
+        morse_code_t code = morse_encode(*c);
+        for (int i = morse_code_length(code) - 1; i >= 0; i--)
+        {
+            size_t length = (size_t)(((code >> i) & 1 ? 3 : 1) * unit);
+            for (size_t s = t; s < t + length; s++)
+            {
+                recording->keyed[s] = true;
+            }
+            t += length + (size_t)unit;
+        }
+        t += (size_t)(2 * unit);
+    }
+    recording->count = t + SAMPLE_HZ;
+
+    for (size_t s = 0; s < recording->count; s++)
+    {
+        double value = 2048 + noise * gaussian();
+        double fade = conditions->fading ? pow(10, -6.0 / 20 * (0.5 - 0.5 * cos(2 * PI * 0.4 * s / SAMPLE_HZ))) : 1;
+
+        envelope += recording->keyed[s] ? ramp : -ramp;
+        envelope = envelope < 0 ? 0 : envelope > 1 ? 1 : envelope;
+        value += envelope * fade * amplitude * sin(2 * PI * conditions->tone_hz * s / SAMPLE_HZ);
+        if (conditions->hum)
+        {
+            value += 150 * sin(2 * PI * 50 * s / SAMPLE_HZ) + 50 * sin(2 * PI * 150 * s / SAMPLE_HZ);
+        }
+        recording->samples[s] = (uint16_t)(value < 0 ? 0 : value > 4095 ? 4095 : value);
+    }
+}
+
+/*
+ * Runs the detector and gives the sample each edge is dated from, as audio.c does
+ */
+static int detect(const struct recording *recording, unsigned tone_hz, size_t *edges)
+{
+    struct tone_detector detector;
+    int count = 0;
+
+    tone_init(&detector, SAMPLE_HZ, tone_hz);
+    for (size_t block = 0; (block + 1) * TONE_BLOCK_SAMPLES <= recording->count; block++)
+    {
+        if (tone_block(&detector, &recording->samples[block * TONE_BLOCK_SAMPLES]) && count < MAX_EDGES)
+        {
+            edges[count++] = (block - (TONE_CONFIRM_BLOCKS - 1)) * TONE_BLOCK_SAMPLES;
+        }
+    }
+    return count;
+}
+
+/*
+ * Reads the edges back into text at the known speed, as the session would
+ */
+static void read_back(const size_t *edges, int count, unsigned wpm, char *text)
+{
+    double unit = 1.2 / wpm * SAMPLE_HZ;
+    morse_code_t code = MORSE_CODE_EMPTY;
+    int length = 0;
+
+    for (int i = 0; i + 1 < count; i += 2)
+    {
+        code = (morse_code_t)(code << 1 | (edges[i + 1] - edges[i] >= 2 * unit));
+        if (i + 2 >= count || edges[i + 2] - edges[i + 1] >= 2 * unit)
+        {
+            char c = morse_decode(code);
+            text[length++] = c != '\0' ? (char)tolower((unsigned char)c) : '?';
+            code = MORSE_CODE_EMPTY;
+        }
+    }
+    text[length] = '\0';
+}
+
+static void check_words(void)
+{
+    static struct recording recording;
+    static const unsigned speeds[] = {12, 18, 25};
+    static const unsigned tones[] = {600, 750, 900};
+    static const double snrs[] = {20, 10, 6};
+    size_t edges[MAX_EDGES];
+    char text[64];
+    int read = 0, total = 0;
+    double delay = 0;
+    int delays = 0;
+
+    for (size_t w = 0; w < 3; w++)
+    {
+        for (size_t f = 0; f < 3; f++)
+        {
+            for (size_t n = 0; n < 3; n++)
+            {
+                struct conditions conditions = {speeds[w], tones[f], snrs[n], (w + n) % 2 == 0, (f + n) % 2 == 1};
+                const char *word = words[w * 3 + f];
+                int count;
+
+                record(&recording, word, &conditions);
+                count = detect(&recording, conditions.tone_hz, edges);
+                read_back(edges, count, conditions.wpm, text);
+                total++;
+                if (strcmp(text, word) == 0)
+                {
+                    read++;
+                    // How late each press is dated against the keying
+                    for (int i = 0; i < count; i += 2)
+                    {
+                        size_t s = edges[i];
+                        while (s < recording.count && !recording.keyed[s])
+                        {
+                            s++;
+                        }
+                        while (s > 0 && recording.keyed[s - 1])
+                        {
+                            s--;
+                        }
+                        delay += ((double)edges[i] - (double)s) / SAMPLE_HZ * 1000;
+                        delays++;
+                    }
+                }
+                else
+                {
+                    printf("%u WPM %u Hz %.0f dB%s%s: read \"%s\" for \"%s\"\n", conditions.wpm, conditions.tone_hz,
+                           conditions.snr_db, conditions.hum ? " hum" : "", conditions.fading ? " fading" : "", text,
+                           word);
+                }
+            }
+        }
+    }
+    printf("%d of %d words read back, presses dated %.1f ms from the keying on average\n", read, total,
+           delays ? delay / delays : 0);
+    CHECK_EQ(read, total);
+}
+
+/*
+ * Two minutes of noise and hum with no tone must not key anything
+ */
+static void check_noise(void)
+{
+    static struct recording recording;
+    size_t edges[MAX_EDGES];
+
+    recording.count = MAX_SAMPLES;
+    for (size_t s = 0; s < recording.count; s++)
+    {
+        double value = 2048 + 40 * gaussian() + 150 * sin(2 * PI * 50 * s / SAMPLE_HZ);
+        recording.samples[s] = (uint16_t)value;
+    }
+    CHECK_EQ(detect(&recording, 700, edges), 0);
+}
+
+/*
+ * Edges in a WAV recording, for checking the detector on real audio
+ */
+static int run_wav(const char *path, unsigned tone_hz)
+{
+    static struct recording recording;
+    size_t edges[MAX_EDGES];
+    unsigned char header[44];
+    int16_t sample;
+    FILE *file = fopen(path, "rb");
+    int count;
+
+    if (file == NULL || fread(header, 1, sizeof header, file) != sizeof header || memcmp(header, "RIFF", 4) != 0 ||
+        header[22] != 1 || header[34] != 16 || (header[24] | header[25] << 8) != SAMPLE_HZ)
+    {
+        printf("%s: need an 8 kHz, 16-bit mono WAV file\n", path);
+        return 1;
+    }
+    for (recording.count = 0; recording.count < MAX_SAMPLES && fread(&sample, 2, 1, file) == 1; recording.count++)
+    {
+        recording.samples[recording.count] = (uint16_t)((sample >> 4) + 2048);
+    }
+    fclose(file);
+
+    count = detect(&recording, tone_hz, edges);
+    for (int i = 0; i < count; i++)
+    {
+        printf("%8.3f s  tone %s\n", (double)edges[i] / SAMPLE_HZ, i % 2 == 0 ? "on" : "off");
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3)
+    {
+        return run_wav(argv[1], (unsigned)atoi(argv[2]));
+    }
+    check_words();
+    check_noise();
+    return check_result();
+}
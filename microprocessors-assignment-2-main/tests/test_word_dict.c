@@ -0,0 +1,148 @@
+/*
+ * Checks the Robin Hood word table against a plain reference set under
+ * random insert, delete and lookup operations
+ */
+#include <string.h>
+#include "check.h"
+#include "word_dict.h"
+
+#define OPERATIONS 200000
+#define NAMES 300 // More names than the table holds, so it fills up and empties again
+
+static uint32_t state = 1;
+
+static uint32_t next_random(void)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+ * Name n as a short lower case word, with n = 0 as "a"
+ */
+static void name(unsigned n, char word[MORSE_WORD_MAX_LETTERS + 1])
+{
+    int length = 0;
+    do
+    {
+        word[length++] = (char)('a' + n % 26);
+        n /= 26;
+    } while (n != 0);
+    word[length] = '\0';
+}
+
+/*
+ * The table holds exactly the words present says it should, and walking it
+ * in table order finds each of them
+ */
+static void check_table(const bool *present)
+{
+    size_t stored = 0;
+
+    for (unsigned n = 0; n < NAMES; n++)
+    {
+        char word[MORSE_WORD_MAX_LETTERS + 1];
+        const struct word_dict_entry *entry;
+
+        name(n, word);
+        entry = word_dict_lookup(word);
+        CHECK_EQ(entry != NULL, present[n]);
+        if (entry != NULL)
+        {
+            CHECK(strcmp(entry->word, word) == 0);
+            CHECK_EQ(entry->morse, morse_encode_word(word));
+            stored++;
+        }
+    }
+    CHECK_EQ(word_dict_count(), stored);
+
+    for (size_t i = 0; i < stored; i++)
+    {
+        const struct word_dict_entry *entry = word_dict_at(i);
+        CHECK(entry != NULL);
+        CHECK(word_dict_lookup(entry->word) == entry);
+    }
+    CHECK(word_dict_at(stored) == NULL);
+}
+
+static void check_random_operations(void)
+{
+    bool present[NAMES] = {false};
+    size_t count = 0;
+
+    for (int i = 0; i < OPERATIONS; i++)
+    {
+        unsigned n = next_random() % NAMES;
+        char word[MORSE_WORD_MAX_LETTERS + 1];
+
+        name(n, word);
+        switch (next_random() % 3)
+        {
+        case 0:
+            if (present[n])
+            {
+                CHECK_EQ(word_dict_insert(word), WORD_DICT_EXISTS);
+            }
+            else if (count == WORD_DICT_MAX_WORDS)
+            {
+                CHECK_EQ(word_dict_insert(word), WORD_DICT_FULL);
+            }
+            else
+            {
+                CHECK_EQ(word_dict_insert(word), WORD_DICT_OK);
+                present[n] = true;
+                count++;
+            }
+            break;
+        case 1:
+            CHECK_EQ(word_dict_delete(word), present[n] ? WORD_DICT_OK : WORD_DICT_NOT_FOUND);
+            if (present[n])
+            {
+                present[n] = false;
+                count--;
+            }
+            break;
+        default:
+            CHECK_EQ(word_dict_lookup(word) != NULL, present[n]);
+            break;
+        }
+        if (i % 1000 == 0)
+        {
+            check_table(present);
+        }
+    }
+    check_table(present);
+}
+
+static void check_inputs(void)
+{
+    struct word_dict_stats stats;
+
+    CHECK_EQ(word_dict_insert(""), WORD_DICT_INVALID);
+    CHECK_EQ(word_dict_insert("abcdefghijk"), WORD_DICT_INVALID);
+    CHECK_EQ(word_dict_insert("no way"), WORD_DICT_INVALID);
+    CHECK_EQ(word_dict_delete(""), WORD_DICT_INVALID);
+    CHECK(word_dict_lookup("abcdefghijk") == NULL);
+
+    // Words are stored in lower case and found in any case
+    CHECK_EQ(word_dict_insert("MiXeD"), WORD_DICT_OK);
+    CHECK(word_dict_lookup("mixed") != NULL);
+    CHECK_EQ(word_dict_insert("mixed"), WORD_DICT_EXISTS);
+    CHECK(strcmp(word_dict_lookup("MIXED")->word, "mixed") == 0);
+
+    word_dict_get_stats(&stats);
+    CHECK_EQ(stats.words, word_dict_count());
+    CHECK_EQ(stats.capacity, WORD_DICT_MAX_WORDS);
+    CHECK_EQ(stats.bytes, WORD_DICT_CAPACITY * sizeof(struct word_dict_entry));
+    CHECK(stats.longest_probe >= 1 && stats.longest_probe <= WORD_DICT_CAPACITY);
+    CHECK_EQ(word_dict_delete("Mixed"), WORD_DICT_OK);
+}
+
+int main(void)
+{
+    check_inputs();
+    check_random_operations();
+    return check_result();
+}
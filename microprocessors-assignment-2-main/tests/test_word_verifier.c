@@ -0,0 +1,98 @@
+/*
+ * Checks letter by letter verification of word and phrase answers
+ */
+#include "check.h"
+#include "word_verifier.h"
+
+/*
+ * Keys a dot/dash string with ' ' for a letter gap and returns the verdict
+ * after the last symbol, without ending the answer
+ */
+static enum morse_verdict key(struct word_verifier *verifier, const char *target, const char *text)
+{
+    enum morse_verdict verdict;
+
+    word_verifier_start(verifier, target);
+    verdict = verifier->verdict;
+    for (; *text != '\0'; text++)
+    {
+        verdict = *text == ' ' ? word_verifier_gap(verifier) : word_verifier_element(verifier, *text == '-');
+    }
+    return verdict;
+}
+
+static void check_progress(void)
+{
+    struct word_verifier verifier;
+
+    CHECK_EQ(key(&verifier, "cave", "-.-. .- ..."), MORSE_PENDING);
+    CHECK_EQ(verifier.correct, 2);
+    CHECK_EQ(verifier.letters, 4);
+    CHECK_EQ(word_verifier_expected(&verifier), 'v');
+
+    // The last letter is confirmed by its gap or the end of transmission
+    CHECK_EQ(key(&verifier, "cave", "-.-. .- ...- ."), MORSE_PENDING);
+    CHECK_EQ(verifier.correct, 3);
+    CHECK_EQ(word_verifier_gap(&verifier), MORSE_ACCEPTED);
+    CHECK_EQ(verifier.correct, 4);
+    CHECK_EQ(key(&verifier, "cave", "-.-. .- ...- ."), MORSE_PENDING);
+    CHECK_EQ(word_verifier_end(&verifier), MORSE_ACCEPTED);
+}
+
+static void check_last_letter(void)
+{
+    struct word_verifier verifier;
+
+    // "tai" keyed for "tae": the I starts with the E's dot
+    CHECK_EQ(key(&verifier, "tae", "- .- .."), MORSE_REJECTED);
+    CHECK_EQ(word_verifier_end(&verifier), MORSE_REJECTED);
+    CHECK_EQ(verifier.correct, 2);
+
+    // So does a one-letter target
+    CHECK_EQ(key(&verifier, "e", "."), MORSE_PENDING);
+    CHECK_EQ(word_verifier_element(&verifier, true), MORSE_REJECTED);
+}
+
+static void check_rejection(void)
+{
+    struct word_verifier verifier;
+
+    // The first element off the expected letter's path fails at once
+    CHECK_EQ(key(&verifier, "dock", "-.. -"), MORSE_PENDING);
+    CHECK_EQ(word_verifier_element(&verifier, true), MORSE_PENDING);
+    CHECK_EQ(word_verifier_element(&verifier, false), MORSE_REJECTED);
+    CHECK_EQ(word_verifier_expected(&verifier), 'o');
+
+    // A letter closed before it was finished
+    CHECK_EQ(key(&verifier, "dock", "-. "), MORSE_REJECTED);
+
+    // An unfinished answer
+    CHECK_EQ(key(&verifier, "dock", "-.. --- -.-."), MORSE_PENDING);
+    CHECK_EQ(word_verifier_end(&verifier), MORSE_REJECTED);
+
+    // Characters without a code can never be keyed
+    CHECK_EQ(key(&verifier, "a?", ".- ."), MORSE_REJECTED);
+}
+
+static void check_phrase(void)
+{
+    struct word_verifier verifier;
+
+    // Spaces separate words and are skipped
+    CHECK_EQ(key(&verifier, " so  s ", "... --- ... "), MORSE_ACCEPTED);
+    CHECK_EQ(verifier.letters, 3);
+
+    // Without a target nothing is checked
+    CHECK_EQ(key(&verifier, NULL, "..."), MORSE_PENDING);
+    CHECK_EQ(word_verifier_end(&verifier), MORSE_PENDING);
+    CHECK_EQ(word_verifier_expected(&verifier), '\0');
+}
+
+int main(void)
+{
+    check_progress();
+    check_last_letter();
+    check_rejection();
+    check_phrase();
+    return check_result();
+}